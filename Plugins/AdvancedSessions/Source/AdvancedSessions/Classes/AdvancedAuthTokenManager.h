@@ -0,0 +1,96 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Interfaces/OnlineIdentityInterface.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(AdvancedAuthTokenLog, Log, All);
+
+/**
+ * Keeps each local player's auth token ready before anyone asks for it.
+ * Tokens are fetched on the frame after a player logs in. By default the prefetched token is handed to the first
+ * GetAuthToken only and later calls fetch a fresh one, since on some platforms (steam) every token is its own auth
+ * ticket. AdvancedSessions.AuthToken.ReuseAcrossConnects hands the same token to every caller instead. A token that is
+ * replaced before anyone was given it is revoked so its ticket doesn't stay open.
+ * Tokens are only refreshed in the background when they have a real expiry, either one platform code reported with
+ * SetTokenExpiry or AdvancedSessions.AuthToken.Lifetime for platforms with a fixed one. They are fetched again
+ * AdvancedSessions.AuthToken.RefreshLead seconds before that, off the core ticker and one per frame, so a refresh never
+ * lands in the middle of a connect. Game thread only.
+ */
+class ADVANCEDSESSIONS_API FAdvancedAuthTokenManager
+{
+public:
+
+	static FAdvancedAuthTokenManager& Get();
+
+	// Unbinds from the identity interface and removes the ticker, called on module shutdown
+	static void Shutdown();
+
+	// Fetches the player's token on the next frame, does nothing while a fetch is queued or a token nobody used yet is cached
+	void Prefetch(int32 LocalUserNum);
+
+	// Prefetches for every local user the identity interface already has logged in
+	void PrefetchLoggedInUsers();
+
+	// False if nothing is cached and the identity interface has no token for the player either
+	bool GetAuthToken(int32 LocalUserNum, FString& OutToken);
+
+	// For platform code that knows when the player's current token stops being accepted, schedules its refresh
+	void SetTokenExpiry(int32 LocalUserNum, float SecondsFromNow);
+
+	void Invalidate(int32 LocalUserNum);
+	void InvalidateAll();
+
+private:
+
+	FAdvancedAuthTokenManager();
+	~FAdvancedAuthTokenManager();
+
+	struct FTokenEntry
+	{
+		FString Token;
+		double FetchTime;
+
+		// 0 if nothing says the token runs out
+		double ExpiryTime;
+
+		bool bValid;
+		bool bFetchQueued;
+
+		// Already given to a caller, only handed out again with ReuseAcrossConnects
+		bool bHandedOut;
+
+		FTokenEntry()
+			: FetchTime(0.0)
+			, ExpiryTime(0.0)
+			, bValid(false)
+			, bFetchQueued(false)
+			, bHandedOut(false)
+		{
+		}
+	};
+
+	// Returns the identity interface, rebinding and dropping the tokens if the subsystem was recreated since last time
+	IOnlineIdentityPtr GetIdentityInterface();
+	void UnbindDelegates();
+
+	bool FetchToken(IOnlineIdentity& IdentityInterface, int32 LocalUserNum, double Now);
+	// Valid, not expired and not handed out yet unless ReuseAcrossConnects is set
+	bool HasUsableToken(const FTokenEntry& Entry, double Now) const;
+	bool IsExpired(const FTokenEntry& Entry, double Now) const;
+	bool NeedsRefresh(const FTokenEntry& Entry, double Now) const;
+
+	void EnsureTicker();
+	bool Tick(float DeltaTime);
+
+	void OnLoginStatusChanged(int32 LocalUserNum, ELoginStatus::Type OldStatus, ELoginStatus::Type NewStatus, const FUniqueNetId& NewId);
+
+	FTokenEntry Tokens[MAX_LOCAL_PLAYERS];
+
+	TWeakPtr<IOnlineIdentity, ESPMode::ThreadSafe> BoundIdentityInterface;
+	FDelegateHandle LoginStatusChangedHandles[MAX_LOCAL_PLAYERS];
+	FDelegateHandle TickerHandle;
+
+	static FAdvancedAuthTokenManager* Instance;
+};
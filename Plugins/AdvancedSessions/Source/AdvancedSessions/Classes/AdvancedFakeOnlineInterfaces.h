@@ -0,0 +1,92 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+#include "CoreMinimal.h"
+#include "Interfaces/OnlineSessionInterface.h"
+#include "AdvancedOnlineRequestScheduler.h"
+#include "Misc/AutomationTest.h"
+
+// Test only, kept out of shipping and other non editor builds that don't run automation tests
+#if WITH_DEV_AUTOMATION_TESTS || WITH_EDITOR
+
+// How a fake online call answers
+struct FAdvancedFakeOnlineScript
+{
+	// What the call itself returns, false is the call failing to start and nothing is answered
+	bool bStarts;
+
+	// What the answer reports
+	bool bWasSuccessful;
+
+	// Seconds before the answer, 0 answers on the next tick. Negative never answers, the scheduler's deadline has to
+	float AnswerDelay;
+
+	FAdvancedFakeOnlineScript()
+		: bStarts(true)
+		, bWasSuccessful(true)
+		, AnswerDelay(0.f)
+	{
+	}
+};
+
+class FAdvancedFakeOnlineCalls;
+class FAdvancedFakeOnlineIdentity;
+class FAdvancedFakeOnlineFriends;
+class FAdvancedFakeOnlineSession;
+
+/**
+ * Stand-in identity, friends and session interfaces for driving the scheduled proxies without an online backend.
+ * Install points the request scheduler at them, after that every call a proxy makes is logged and answered the way its
+ * script says, so priority order, concurrency caps, deadlines and dedupe can be checked from the call log. Calls are
+ * scripted by function name: Login, Logout, ReadFriendsList, QueryRecentPlayers, SendInvite, EndSession,
+ * FindFriendSession and CancelFindSessions, anything else fails straight away or does nothing. Friend, recent player
+ * and friend session lists are always empty. Used by the request scheduler's automation tests. Game thread only.
+ */
+class ADVANCEDSESSIONS_API FAdvancedFakeOnlineInterfaces
+{
+public:
+
+	FAdvancedFakeOnlineInterfaces();
+
+	// Uninstalls if still installed
+	~FAdvancedFakeOnlineInterfaces();
+
+	// Points the request scheduler at these interfaces, Uninstall goes back to the online subsystem
+	void Install();
+	void Uninstall();
+
+	// Unscripted calls start, succeed and answer on the next tick
+	void SetScript(FName CallName, const FAdvancedFakeOnlineScript& Script);
+
+	// A session the session interface reports, EndSession only goes out for one in progress
+	void AddSession(FName SessionName, EOnlineSessionState::Type State);
+
+	// Answers every call still waiting now, including ones scripted to never answer
+	void AnswerAllPending(bool bWasSuccessful);
+
+	// Forgets the call log and pending counts, unanswered calls are dropped without an answer
+	void ResetCalls();
+
+	// Every call made so far, in the order they were made
+	const TArray<FName>& GetCallLog() const;
+	int32 GetNumCalls(FName CallName) const;
+
+	// Calls made on the interface and not answered yet, and the most there ever were at once
+	int32 GetNumPending(EAdvancedOnlineInterface Interface) const;
+	int32 GetMaxPending(EAdvancedOnlineInterface Interface) const;
+
+	IOnlineIdentityPtr GetIdentityInterface() const;
+	IOnlineFriendsPtr GetFriendsInterface() const;
+	IOnlineSessionPtr GetSessionInterface() const;
+
+private:
+
+	TSharedRef<FAdvancedFakeOnlineCalls> Calls;
+	TSharedRef<FAdvancedFakeOnlineIdentity, ESPMode::ThreadSafe> Identity;
+	TSharedRef<FAdvancedFakeOnlineFriends, ESPMode::ThreadSafe> Friends;
+	TSharedRef<FAdvancedFakeOnlineSession, ESPMode::ThreadSafe> Session;
+
+	bool bInstalled;
+};
+
+#endif
@@ -16,6 +16,7 @@
 #include "OnlineSessionSettings.h"
 #include "UObject/UObjectIterator.h"
 #include "AdvancedFriendsInterface.h"
+#include "Containers/Ticker.h"
 
 #include "AdvancedFriendsGameInstance.generated.h"
 
@@ -43,9 +44,28 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = AdvancedVoiceInterface)
 	bool bEnableTalkingStatusDelegate;
 
+	// Collects talking state changes and reports them once per frame instead of on every transition. Off by default, turning
+	// it on stops the per player events below unless bFirePerPlayerTalkingEventsWhenBatched is set
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = AdvancedVoiceInterface)
+	bool bBatchTalkingStateChanges;
+
+	// Seconds a player has to stay quiet before they are reported as not talking, starting to talk is reported straight away
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = AdvancedVoiceInterface, meta = (EditCondition = "bBatchTalkingStateChanges", ClampMin = "0.0"))
+	float TalkingStateStopDebounce;
+
+	// Also fire OnPlayerTalkingStateChanged and OnPlayerVoiceStateChanged for each player in a batch, off by default since
+	// batching exists to avoid one event per talker. For Blueprints that haven't moved to OnTalkingStatesChanged yet
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = AdvancedVoiceInterface, meta = (EditCondition = "bBatchTalkingStateChanges"))
+	bool bFirePerPlayerTalkingEventsWhenBatched;
+
 	//virtual void PostLoad() override;
 	virtual void Shutdown() override;
 	virtual void Init() override;
+	virtual int32 AddLocalPlayer(ULocalPlayer* NewPlayer, int32 ControllerId) override;
+	virtual bool RemoveLocalPlayer(ULocalPlayer* ExistingPlayer) override;
+
+	// Forces the local controller lookup to be rebuilt on next use, call if you swap a local player's controller yourself
+	void InvalidateControllerCache();
 
 	//*** Session invite received by local ***//
 	FOnSessionInviteReceivedDelegate SessionInviteReceivedDelegate;
@@ -71,9 +91,15 @@ public:
 
 
 	// After a voice status has changed this event is triggered if the bEnableTalkingStatusDelegate property is true
+	// With bBatchTalkingStateChanges it only fires if bFirePerPlayerTalkingEventsWhenBatched is set, use OnTalkingStatesChanged instead
 	UFUNCTION(BlueprintImplementableEvent, Category = "AdvancedVoice")
 	void OnPlayerTalkingStateChanged(FBPUniqueNetId PlayerId, bool bIsTalking);
 
+	// With bBatchTalkingStateChanges this is called at most once per frame when anyone's talking state changed
+	// Talkers keep their index for the session, bit (Index % 32) of TalkingBits[Index / 32] is set while they talk, see IsTalkerSlotTalking
+	UFUNCTION(BlueprintImplementableEvent, Category = "AdvancedVoice")
+	void OnTalkingStatesChanged(const TArray<FBPUniqueNetId>& Talkers, const TArray<int32>& TalkingBits);
+
 	void OnPlayerTalkingStateChangedMaster(TSharedRef<const FUniqueNetId> PlayerId, bool bIsTalking);
 
 	FOnPlayerTalkingStateChangedDelegate PlayerTalkingStateChangedDelegate;
@@ -97,6 +123,57 @@ public:
 	FDelegateHandle PlayerLoginStatusChangedDelegateHandle;
 
 
+private:
+
+	// A local player's controller, as seen when the lookup was last rebuilt
+	struct FAdvancedLocalController
+	{
+		TWeakObjectPtr<APlayerController> Controller;
+		int32 LocalPlayerIndex;
+		bool bImplementsInterface;
+	};
+
+	// Returns null if there is no local controller for the id / controller id
+	const FAdvancedLocalController* FindLocalController(const FUniqueNetId& UniqueNetId);
+	const FAdvancedLocalController* FindLocalController(int32 ControllerId);
+
+	void RebuildControllerCache();
+	bool IsControllerCacheStale() const;
+	void OnPostLoadMapWithWorld(UWorld* LoadedWorld);
+
+	// Lookups for the event fan out, rebuilt only when local players, logins or the map change
+	TArray<FAdvancedLocalController> LocalControllers;
+	TMap<FUniqueNetIdHandle, int32> LocalControllersByNetId;
+	TMap<int32, int32> LocalControllersById;
+
+	// True while a controller had no player state / id yet, an id miss then rebuilds in case it has arrived
+	bool bControllerCacheIncomplete;
+	bool bControllerCacheDirty;
+
+	FDelegateHandle PostLoadMapDelegateHandle;
+
+	// Sends a single talking state change to blueprint and the local controllers
+	void DispatchTalkingStateChanged(const FBPUniqueNetId& PlayerTalking, bool bIsTalking);
+	bool FlushTalkingStates(float DeltaTime);
+	void ResetTalkingStates();
+
+	struct FTalkerState
+	{
+		bool bTalking;
+		bool bReportedTalking;
+		double LastChangeTime;
+	};
+
+	// Indexed by talker slot
+	TArray<FTalkerState> TalkerStates;
+	TArray<FBPUniqueNetId> TalkerIds;
+	TArray<int32> TalkingBits;
+	TMap<FUniqueNetIdHandle, int32> TalkerSlots;
+
+	FDelegateHandle TalkingFlushTickerHandle;
+
+public:
+
 	//*** Session Invite Received From Friend ***//
 	// REMOVED BECAUSE IT NEVER GETS CALLED
 	/*FOnSessionInviteReceivedDelegate SessionInviteReceivedDelegate;
@@ -40,6 +40,10 @@ public:
 	UFUNCTION(BlueprintImplementableEvent, meta = (DisplayName = "OnPlayerVoiceStateChanged"))
 	void OnPlayerVoiceStateChanged(FBPUniqueNetId PlayerId, bool bIsTalking);
 
+	// Called once per frame with everyone's talking state when bBatchTalkingStateChanges is set on the game instance
+	UFUNCTION(BlueprintImplementableEvent, meta = (DisplayName = "OnPlayerVoiceStatesChanged"))
+	void OnPlayerVoiceStatesChanged(const TArray<FBPUniqueNetId>& Talkers, const TArray<int32>& TalkingBits);
+
 	// Called when the designated LocalUser has changed login state
 	UFUNCTION(BlueprintImplementableEvent, meta = (DisplayName = "OnPlayerLoginChanged"))
 	void OnPlayerLoginChanged(int32 PlayerNum);
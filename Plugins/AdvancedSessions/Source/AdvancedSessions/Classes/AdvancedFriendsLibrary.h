@@ -3,6 +3,7 @@
 #pragma once
 #include "CoreMinimal.h"
 #include "BlueprintDataDefinitions.h"
+#include "AdvancedFriendsSnapshot.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "Online.h"
 #include "Engine/LocalPlayer.h"
@@ -30,7 +31,8 @@ public:
 	
 	//********* Friend List Functions *************//
 
-	// Sends an Invite to the current online session to a list of friends
+	// Sends an Invite to the current online session to a list of friends, fails if there is no session. Invites go out later in rate
+	// limited chunks, so success only means they were queued and not that they were delivered, use Send Session Invites for per player results
 	UFUNCTION(BlueprintCallable, Category = "Online|AdvancedFriends|FriendsList", meta = (ExpandEnumAsExecs = "Result"))
 	static void SendSessionInviteToFriends(APlayerController *PlayerController, const TArray<FBPUniqueNetId> &Friends, EBlueprintResultSwitch &Result);
 
@@ -46,6 +48,15 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Online|AdvancedFriends|FriendsList")
 	static void GetStoredFriendsList(APlayerController *PlayerController, TArray<FBPFriendInfo> &FriendsList);
 
+	// Get the version of the stored friends list, it changes whenever a friend is added, removed or their presence changes
+	UFUNCTION(BlueprintPure, Category = "Online|AdvancedFriends|FriendsList")
+	static void GetStoredFriendsListVersion(APlayerController *PlayerController, int32 &Version);
+
+	// Get only the friends that changed since a version returned by GetStoredFriendsListVersion, for redrawing just the changed rows
+	// If bNeedsFullRefresh is true the roster itself changed and GetStoredFriendsList should be used instead
+	UFUNCTION(BlueprintCallable, Category = "Online|AdvancedFriends|FriendsList")
+	static void GetChangedFriendsSince(APlayerController *PlayerController, int32 SinceVersion, TArray<FBPFriendInfo> &ChangedFriends, int32 &CurrentVersion, bool &bNeedsFullRefresh);
+
 	// Get the previously read/saved recent players list (Must Call GetRecentPlayers first for this to return anything)
 	UFUNCTION(BlueprintCallable, Category = "Online|AdvancedFriends|RecentPlayersList")
 	static void GetStoredRecentPlayersList(FBPUniqueNetId UniqueNetId, TArray<FBPOnlineRecentPlayer> &PlayersList);
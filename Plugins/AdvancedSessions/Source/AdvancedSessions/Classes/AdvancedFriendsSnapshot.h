@@ -0,0 +1,113 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+#include "CoreMinimal.h"
+#include "BlueprintDataDefinitions.h"
+#include "Interfaces/OnlineFriendsInterface.h"
+#include "Interfaces/OnlinePresenceInterface.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(AdvancedFriendsSnapshotLog, Log, All);
+
+/**
+ * Blueprint ready copy of a local user's friends list.
+ * Rebuilt once per ReadFriendsList and patched in place from presence events afterwards, so reading it costs nothing.
+ * Every change bumps the version and tags the touched rows with it, widgets can ask for only the rows that changed since
+ * the version they last drew. A roster change (friends added / removed) needs a full redraw, see GetRosterVersion.
+ * Game thread only.
+ */
+class ADVANCEDSESSIONS_API FAdvancedFriendsSnapshot
+{
+public:
+
+	~FAdvancedFriendsSnapshot();
+
+	// Snapshot for a local user, null until the friends list has been read for them
+	static TSharedPtr<FAdvancedFriendsSnapshot> Get(int32 LocalUserNum);
+	static TSharedRef<FAdvancedFriendsSnapshot> FindOrCreate(int32 LocalUserNum);
+	static void Remove(int32 LocalUserNum);
+
+	// Drops every snapshot and unbinds their delegates while the online subsystem is still around, called on module shutdown
+	static void Shutdown();
+
+	// Converts a subsystem friend into the blueprint struct
+	static void FillFriendInfo(const FOnlineFriend& Friend, FBPFriendInfo& OutInfo);
+	static void FillPresenceInfo(const FOnlineUserPresence& Presence, FBPFriendInfo& OutInfo);
+
+	// Replaces the whole roster
+	void Rebuild(const TArray<TSharedRef<FOnlineFriend>>& Friends);
+
+	// Returns true if the friend was in the snapshot and something visible changed
+	bool ApplyPresence(const FUniqueNetId& UserId, const FOnlineUserPresence& Presence);
+
+	bool IsBuilt() const { return bBuilt; }
+	int32 GetLocalUserNum() const { return LocalUserNum; }
+
+	// Bumped on every change
+	int32 GetVersion() const { return Version; }
+
+	// Version of the last roster rebuild, anything older than this needs a full refresh
+	int32 GetRosterVersion() const { return RosterVersion; }
+
+	const TArray<FBPFriendInfo>& GetFriends() const { return Rows; }
+
+	// Hashed lookup, null if the id isn't on the list
+	const FBPFriendInfo* FindFriend(const FUniqueNetIdHandle& UserId) const
+	{
+		const int32 RowNum = FindRow(UserId);
+		return RowNum != INDEX_NONE ? &Rows[RowNum] : nullptr;
+	}
+
+	const FBPFriendInfo* FindFriend(const FUniqueNetId& UserId) const
+	{
+		return FindFriend(FUniqueNetIdHandle::Find(UserId));
+	}
+
+#if !UE_BUILD_SHIPPING
+	// Times FindFriend against a linear scan on a synthetic list, run with AdvancedFriends.BenchFriendLookups
+	static void RunLookupBenchmark(int32 NumFriends, int32 QueriesPerFrame, int32 NumFrames, FOutputDevice& Ar);
+#endif
+
+	// Appends rows changed after SinceVersion, returns false if the caller is behind a roster change and needs the full list
+	bool GetChangedSince(int32 SinceVersion, TArray<FBPFriendInfo>& OutChanged) const;
+
+private:
+
+	explicit FAdvancedFriendsSnapshot(int32 InLocalUserNum);
+
+	int32 FindRow(const FUniqueNetIdHandle& UserId) const
+	{
+		const int32* Found = RowIndex.Find(UserId);
+		return Found ? *Found : INDEX_NONE;
+	}
+
+	int32 FindRow(const FUniqueNetId& UserId) const
+	{
+		return FindRow(FUniqueNetIdHandle::Find(UserId));
+	}
+
+	void BindDelegates();
+	void OnPresenceReceived(const FUniqueNetId& UserId, const TSharedRef<FOnlineUserPresence>& Presence);
+
+	// Friends list events, the subsystem cache is re-read so lookups never go stale
+	void OnFriendsChange();
+	void OnFriendRemoved(const FUniqueNetId& UserId, const FUniqueNetId& FriendId);
+	void RebuildFromSubsystem();
+
+	int32 LocalUserNum;
+	bool bBuilt;
+
+	int32 Version;
+	int32 RosterVersion;
+
+	TArray<FBPFriendInfo> Rows;
+
+	// Version each row last changed in, parallel to Rows
+	TArray<int32> RowVersions;
+
+	// Interned id to row
+	TMap<FUniqueNetIdHandle, int32> RowIndex;
+
+	FDelegateHandle PresenceReceivedHandle;
+	FDelegateHandle FriendsChangeHandle;
+	FDelegateHandle FriendRemovedHandle;
+};
@@ -0,0 +1,92 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+#include "CoreMinimal.h"
+#include "UniqueNetIdHandle.h"
+#include "Interfaces/OnlineIdentityInterface.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(AdvancedIdentityCacheLog, Log, All);
+
+/**
+ * Identity lookups by unique net id, answered from memory after the first call.
+ * Nicknames, login status, accounts and account attributes are cached per interned id. Login status events drop the
+ * affected player, logins changing or a player logging out drop everything since the subsystem's own caches reset then.
+ * Nicknames can change on some platforms without an event, AdvancedSessions.IdentityCache.NicknameLifetime bounds how
+ * stale they can get. Game thread only.
+ */
+class ADVANCEDSESSIONS_API FAdvancedIdentityCache
+{
+public:
+
+	static FAdvancedIdentityCache& Get();
+
+	// Unbinds from the identity interface and frees the cache, called on module shutdown
+	static void Shutdown();
+
+	// False if there is no identity interface
+	bool GetPlayerNickname(const FUniqueNetIdHandle& UserId, FString& OutNickname);
+	bool GetLoginStatus(const FUniqueNetIdHandle& UserId, ELoginStatus::Type& OutStatus);
+	TSharedPtr<FUserOnlineAccount> GetUserAccount(const FUniqueNetIdHandle& UserId);
+
+	// Reads through to the account the first time, false if the account doesn't have the attribute
+	bool GetUserAttribute(const TSharedRef<FUserOnlineAccount>& Account, const FString& AttributeName, FString& OutValue);
+
+	// Keeps the cached copy in line with a successful SetUserAttribute
+	void OnUserAttributeSet(const TSharedRef<FUserOnlineAccount>& Account, const FString& AttributeName, const FString& NewValue);
+
+	// Fills OutNicknames in the same order, one identity interface lookup for all the misses. Returns how many resolved
+	int32 ResolvePlayerNicknames(const TArray<FUniqueNetIdHandle>& UserIds, TArray<FString>& OutNicknames);
+
+	void Invalidate(const FUniqueNetIdHandle& UserId);
+	void InvalidateAll();
+
+private:
+
+	FAdvancedIdentityCache();
+	~FAdvancedIdentityCache();
+
+	struct FEntry
+	{
+		FString Nickname;
+		double NicknameTime;
+		bool bHasNickname;
+
+		ELoginStatus::Type LoginStatus;
+		bool bHasLoginStatus;
+
+		TSharedPtr<FUserOnlineAccount> Account;
+		bool bHasAccount;
+
+		// Attributes the account didn't have are cached too, as unset values
+		TMap<FString, TOptional<FString>> Attributes;
+
+		FEntry()
+			: NicknameTime(0.0)
+			, bHasNickname(false)
+			, LoginStatus(ELoginStatus::NotLoggedIn)
+			, bHasLoginStatus(false)
+			, bHasAccount(false)
+		{
+		}
+	};
+
+	// Returns the identity interface, rebinding and dropping the cache if the subsystem was recreated since last time
+	IOnlineIdentityPtr GetIdentityInterface();
+	void BindDelegates(const IOnlineIdentityPtr& IdentityInterface);
+	void UnbindDelegates();
+
+	// Cached entry if the cache is still bound to a live identity interface
+	const FEntry* FindLiveEntry(const FUniqueNetIdHandle& UserId) const;
+	bool IsNicknameFresh(const FEntry& Entry, double Now) const;
+
+	void OnLoginStatusChanged(int32 LocalUserNum, ELoginStatus::Type OldStatus, ELoginStatus::Type NewStatus, const FUniqueNetId& NewId);
+	void OnLoginChanged(int32 LocalUserNum);
+
+	TMap<FUniqueNetIdHandle, FEntry> Entries;
+
+	TWeakPtr<IOnlineIdentity, ESPMode::ThreadSafe> BoundIdentityInterface;
+	FDelegateHandle LoginStatusChangedHandles[MAX_LOCAL_PLAYERS];
+	FDelegateHandle LoginChangedHandle;
+
+	static FAdvancedIdentityCache* Instance;
+};
@@ -39,6 +39,10 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Online|AdvancedIdentity")
 	static void GetPlayerNickname(const FBPUniqueNetId & UniqueNetID, FString & PlayerNickname);
 
+	// Get the nicknames for a list of players in one go, PlayerNicknames matches the order of UniqueNetIDs. Returns how many resolved
+	UFUNCTION(BlueprintCallable, Category = "Online|AdvancedIdentity")
+	static int32 ResolvePlayerNicknames(const TArray<FBPUniqueNetId> & UniqueNetIDs, TArray<FString> & PlayerNicknames);
+
 	//********* User Account Functions *************//
 
 	// Get a users account
@@ -0,0 +1,161 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "OnlineSubsystem.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(AdvancedOnlineRequestLog, Log, All);
+
+// Which online interface a request uses, each has its own concurrency cap
+enum class EAdvancedOnlineInterface : uint8
+{
+	Identity,
+	Friends,
+	Session,
+	Num
+};
+
+enum class EAdvancedOnlineRequestPriority : uint8
+{
+	Low,
+	Normal,
+	High
+};
+
+enum class EAdvancedOnlineRequestResult : uint8
+{
+	Success,
+	Failure,
+	TimedOut,
+	Cancelled
+};
+
+DECLARE_DELEGATE_OneParam(FOnAdvancedOnlineRequestFinished, EAdvancedOnlineRequestResult /*Result*/);
+
+struct FAdvancedOnlineRequest
+{
+	EAdvancedOnlineInterface Interface;
+	EAdvancedOnlineRequestPriority Priority;
+
+	// Seconds from submitting until the request gives up, queue time included. 0 uses AdvancedSessions.RequestScheduler.Timeout,
+	// or AdvancedSessions.RequestScheduler.Timeout.Identity for identity requests which by default never give up
+	float Timeout;
+
+	// Requests with the same key share one online call while it is queued or running, empty never shares
+	FString DedupeKey;
+
+	// Requests with the same key make their own calls but never run at the same time, for calls whose answer doesn't say
+	// which call it belongs to. Empty never waits
+	FString ExclusiveKey;
+
+	// Makes the online call, whoever handles its answer calls Complete with the id. False if it couldn't be started
+	TFunction<bool(uint32 /*RequestId*/)> Start;
+
+	// Called once, for every submitter sharing the request
+	FOnAdvancedOnlineRequestFinished OnFinished;
+
+	FAdvancedOnlineRequest()
+		: Interface(EAdvancedOnlineInterface::Session)
+		, Priority(EAdvancedOnlineRequestPriority::Normal)
+		, Timeout(0.f)
+	{
+	}
+};
+
+/**
+ * Queues the callback proxies' online calls so they don't all fire at once.
+ * Each interface runs at most AdvancedSessions.RequestScheduler.MaxConcurrent.<Interface> requests, the rest wait in
+ * priority order and then submit order. A request that hasn't completed by its deadline finishes as TimedOut and frees
+ * its slot, a late answer for it is ignored. Login and logout have no deadline unless one is set. Submitting while a
+ * request with the same dedupe key is queued or running joins it instead of making another call, so only use a key when
+ * every submitter can read the result back from the online interface. Requests sharing an exclusive key wait for each
+ * other instead. Game thread only.
+ */
+class ADVANCEDSESSIONS_API FAdvancedOnlineRequestScheduler
+{
+public:
+
+	static FAdvancedOnlineRequestScheduler& Get();
+	static void Shutdown();
+
+	// Returns a ticket for Cancel. OnFinished may run before this returns if the request couldn't be started
+	uint32 Submit(FAdvancedOnlineRequest&& Request);
+
+	// Called with the id Start was given once the online call answers
+	void Complete(uint32 RequestId, bool bWasSuccessful);
+
+	// The ticket's OnFinished runs with Cancelled. A request nobody is waiting on any more is dropped if it hasn't started,
+	// one already running keeps its slot until it answers or times out since the online call can't be taken back
+	void Cancel(uint32 Ticket);
+	void CancelAll();
+
+	int32 GetNumQueued() const { return Queued.Num(); }
+	int32 GetNumRunning(EAdvancedOnlineInterface Interface) const { return NumRunning[(uint8)Interface]; }
+
+	// Where the scheduled proxies get their online interfaces, the world's online subsystem unless an override is set.
+	// Overrides point the proxies at stand-ins such as FAdvancedFakeOnlineInterfaces, null goes back to the subsystem
+	void SetInterfaceOverrides(const IOnlineIdentityPtr& Identity, const IOnlineFriendsPtr& Friends, const IOnlineSessionPtr& Session);
+	IOnlineIdentityPtr GetIdentityInterface(UWorld* World = nullptr) const;
+	IOnlineFriendsPtr GetFriendsInterface(UWorld* World = nullptr) const;
+	IOnlineSessionPtr GetSessionInterface(UWorld* World = nullptr) const;
+
+private:
+
+	FAdvancedOnlineRequestScheduler();
+	~FAdvancedOnlineRequestScheduler();
+
+	struct FWaiter
+	{
+		uint32 Ticket;
+		FOnAdvancedOnlineRequestFinished OnFinished;
+	};
+
+	struct FScheduledRequest
+	{
+		uint32 RequestId;
+		EAdvancedOnlineInterface Interface;
+		EAdvancedOnlineRequestPriority Priority;
+		FString DedupeKey;
+		FString ExclusiveKey;
+		TFunction<bool(uint32)> Start;
+		TArray<FWaiter, TInlineAllocator<1>> Waiters;
+		double Deadline;
+		bool bRunning;
+	};
+
+	static int32 GetConcurrencyLimit(EAdvancedOnlineInterface Interface);
+
+	// Inserts into Queued behind everything of the same or higher priority
+	void Enqueue(uint32 RequestId);
+
+	// Starts whatever the caps allow, highest priority first
+	void Pump();
+
+	// Removes the request and tells its waiters, frees the slot if it was running
+	void Finish(uint32 RequestId, EAdvancedOnlineRequestResult Result);
+
+	void EnsureTicker();
+	bool Tick(float DeltaTime);
+
+	TMap<uint32, TUniquePtr<FScheduledRequest>> Requests;
+
+	// Not started yet, kept sorted by priority then submit order
+	TArray<uint32> Queued;
+
+	TMap<FString, uint32> RequestsByKey;
+
+	// Exclusive keys of running requests
+	TSet<FString> RunningExclusiveKeys;
+	int32 NumRunning[(uint8)EAdvancedOnlineInterface::Num];
+
+	IOnlineIdentityPtr IdentityOverride;
+	IOnlineFriendsPtr FriendsOverride;
+	IOnlineSessionPtr SessionOverride;
+
+	uint32 NextId;
+	bool bPumping;
+	FDelegateHandle TickerHandle;
+
+	static FAdvancedOnlineRequestScheduler* Instance;
+};
@@ -0,0 +1,103 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "BlueprintDataDefinitions.h"
+#include "AdvancedProximityVoiceComponent.generated.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(AdvancedProximityVoiceLog, Log, All);
+
+class UVOIPTalker;
+class USoundAttenuation;
+class IOnlineVoice;
+
+/**
+ * Only keeps remote talkers registered while their pawn is within earshot of the local player, so far away players
+ * aren't decoded or mixed. Unregistering on the client doesn't stop the server sending their voice, with
+ * bServerSideCulling the server copy of the component also gameplay mutes out of range talkers for its player, which
+ * stops the server relaying their packets to that connection.
+ * Add it to a player controller. Pawns are bucketed into a 2D grid with cells the size of the outer radius, so each
+ * update only looks at the nine cells around the listener.
+ * Players are registered inside HearingRadius and unregistered past HearingRadius + HysteresisMargin, moving around
+ * the edge doesn't churn registrations. Leaving play registers (and unmutes) everyone again.
+ */
+UCLASS(ClassGroup = (AdvancedVoice), meta = (BlueprintSpawnableComponent))
+class ADVANCEDSESSIONS_API UAdvancedProximityVoiceComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+
+	UAdvancedProximityVoiceComponent(const FObjectInitializer& ObjectInitializer);
+
+	// Players closer than this are heard
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedVoice|Proximity", meta = (ClampMin = "1.0"))
+	float HearingRadius;
+
+	// Extra distance a player has to move past HearingRadius before they are dropped
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedVoice|Proximity", meta = (ClampMin = "0.0"))
+	float HysteresisMargin;
+
+	// Seconds between proximity updates
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedVoice|Proximity", meta = (ClampMin = "0.0"))
+	float UpdateInterval;
+
+	// Run on the server for remote players as well and gameplay mute out of range talkers there, so their voice isn't sent at all
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedVoice|Proximity")
+	bool bServerSideCulling;
+
+	// If set, talkers in range get a VOIP talker attached to their pawn with these attenuation settings
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedVoice|Proximity")
+	USoundAttenuation* VoiceAttenuation;
+
+	// Players currently registered because they are in range
+	UFUNCTION(BlueprintPure, Category = "AdvancedVoice|Proximity")
+	void GetTalkersInRange(TArray<FBPUniqueNetId>& TalkersInRange) const;
+
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+private:
+
+	struct FProximityTalker
+	{
+		TWeakObjectPtr<APlayerState> PlayerState;
+		TWeakObjectPtr<UVOIPTalker> Talker;
+		bool bInRange;
+
+		// False until the first update decided on this player, the engine may have registered them already
+		bool bApplied;
+
+		bool bSeenThisUpdate;
+		bool bEvaluatedThisUpdate;
+	};
+
+	bool IsLocalListener() const;
+
+	// Server copy of a remote player's controller
+	bool IsServerListener() const;
+
+	bool GetListenerLocation(FVector& OutLocation) const;
+	void UpdateProximity();
+
+	// Registers / unregisters with the voice interface when given one, otherwise gameplay mutes / unmutes on the server
+	void SetInRange(IOnlineVoice* VoiceInterface, const FUniqueNetIdHandle& Handle, FProximityTalker& Entry, bool bInRange);
+	void UpdateAttenuation(FProximityTalker& Entry, APawn* Pawn);
+
+	FIntPoint GetCell(const FVector& Location, float CellSize) const
+	{
+		return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+	}
+
+	TMap<FUniqueNetIdHandle, FProximityTalker> Talkers;
+
+	// Rebuilt every update, pawns by grid cell as indices into GridPawns
+	TMap<FIntPoint, TArray<int32, TInlineAllocator<4>>> Grid;
+	TArray<TPair<FUniqueNetIdHandle, APawn*>> GridPawns;
+
+	// Keeps the VOIP talkers alive, Talkers only holds them weakly
+	UPROPERTY(Transient)
+	TArray<UVOIPTalker*> TalkerComponents;
+};
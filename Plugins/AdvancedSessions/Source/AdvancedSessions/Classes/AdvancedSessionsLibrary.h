@@ -3,6 +3,7 @@
 #pragma once
 #include "CoreMinimal.h"
 #include "BlueprintDataDefinitions.h"
+#include "SessionPropertyBag.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "Online.h"
 #include "OnlineSubsystem.h"
@@ -116,6 +117,36 @@ public:
 		static void GetSessionPropertyFloat(const TArray<FSessionPropertyKeyPair> & ExtraSettings, FName SettingName, ESessionSettingSearchResult &SearchResult, float &SettingValue);
 
 
+		// Build an indexed property bag from a session search result, read properties from it with the GetSessionPropertyBag* functions
+		// Cheaper than the array versions when reading more than a couple of properties per result, build it once and keep the output
+		UFUNCTION(BlueprintCallable, Category = "Online|AdvancedSessions|SessionInfo")
+		static void MakeSessionPropertyBag(const FBlueprintSessionResult& SessionResult, FBPSessionPropertyBag& PropertyBag);
+
+		// Build an indexed property bag from an array of session properties
+		UFUNCTION(BlueprintCallable, Category = "Online|AdvancedSessions|SessionInfo")
+		static void MakeSessionPropertyBagFromArray(const TArray<FSessionPropertyKeyPair>& ExtraSettings, FBPSessionPropertyBag& PropertyBag);
+
+		// Get a property from a property bag as Byte (For Enums)
+		UFUNCTION(BlueprintCallable, Category = "Online|AdvancedSessions|SessionInfo", meta = (ExpandEnumAsExecs = "SearchResult"))
+		static void GetSessionPropertyBagByte(const FBPSessionPropertyBag& PropertyBag, FName SettingName, ESessionSettingSearchResult &SearchResult, uint8 &SettingValue);
+
+		// Get a property from a property bag as Bool
+		UFUNCTION(BlueprintCallable, Category = "Online|AdvancedSessions|SessionInfo", meta = (ExpandEnumAsExecs = "SearchResult"))
+		static void GetSessionPropertyBagBool(const FBPSessionPropertyBag& PropertyBag, FName SettingName, ESessionSettingSearchResult &SearchResult, bool &SettingValue);
+
+		// Get a property from a property bag as String
+		UFUNCTION(BlueprintCallable, Category = "Online|AdvancedSessions|SessionInfo", meta = (ExpandEnumAsExecs = "SearchResult"))
+		static void GetSessionPropertyBagString(const FBPSessionPropertyBag& PropertyBag, FName SettingName, ESessionSettingSearchResult &SearchResult, FString &SettingValue);
+
+		// Get a property from a property bag as Int
+		UFUNCTION(BlueprintCallable, Category = "Online|AdvancedSessions|SessionInfo", meta = (ExpandEnumAsExecs = "SearchResult"))
+		static void GetSessionPropertyBagInt(const FBPSessionPropertyBag& PropertyBag, FName SettingName, ESessionSettingSearchResult &SearchResult, int32 &SettingValue);
+
+		// Get a property from a property bag as Float
+		UFUNCTION(BlueprintCallable, Category = "Online|AdvancedSessions|SessionInfo", meta = (ExpandEnumAsExecs = "SearchResult"))
+		static void GetSessionPropertyBagFloat(const FBPSessionPropertyBag& PropertyBag, FName SettingName, ESessionSettingSearchResult &SearchResult, float &SettingValue);
+
+
 		// Make a literal session custom information key/value pair from Byte (For Enums)
 		UFUNCTION(BlueprintPure, Category = "Online|AdvancedSessions|SessionInfo|Literals")
 		static FSessionPropertyKeyPair MakeLiteralSessionPropertyByte(FName Key, uint8 Value);
@@ -93,7 +93,43 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Online|AdvancedVoice")
 	static bool UnMuteRemoteTalker(uint8 LocalUserNum, const FBPUniqueNetId& UniqueNetId, bool bIsSystemWide = false);
 
+	//********* Bulk Voice Functions *************//
+	// These do one interface lookup for the whole list, PackedResults holds one bit per entry (read with GetPackedVoiceResult)
+	// and the return value is how many entries the call succeeded / was true for
+
+	// Registers a list of remote players as talkers
+	UFUNCTION(BlueprintCallable, Category = "Online|AdvancedVoice|Bulk")
+	static int32 RegisterRemoteTalkers(const TArray<FBPUniqueNetId>& UniqueNetIds, TArray<int32>& PackedResults);
+
+	// UnRegisters a list of remote players as talkers
+	UFUNCTION(BlueprintCallable, Category = "Online|AdvancedVoice|Bulk")
+	static int32 UnRegisterRemoteTalkers(const TArray<FBPUniqueNetId>& UniqueNetIds, TArray<int32>& PackedResults);
+
+	// Mutes a list of players for the specified local player
+	UFUNCTION(BlueprintCallable, Category = "Online|AdvancedVoice|Bulk")
+	static int32 MuteRemoteTalkers(uint8 LocalUserNum, const TArray<FBPUniqueNetId>& UniqueNetIds, TArray<int32>& PackedResults, bool bIsSystemWide = false);
+
+	// UnMutes a list of players for the specified local player
+	UFUNCTION(BlueprintCallable, Category = "Online|AdvancedVoice|Bulk")
+	static int32 UnMuteRemoteTalkers(uint8 LocalUserNum, const TArray<FBPUniqueNetId>& UniqueNetIds, TArray<int32>& PackedResults, bool bIsSystemWide = false);
+
+	// Returns how many of the remote players are talking, their bits are set in PackedResults
+	UFUNCTION(BlueprintPure, Category = "Online|AdvancedVoice|Bulk")
+	static int32 AreRemotePlayersTalking(const TArray<FBPUniqueNetId>& UniqueNetIds, TArray<int32>& PackedResults);
+
+	// Returns how many of the players are muted for the specified local player, their bits are set in PackedResults
+	UFUNCTION(BlueprintPure, Category = "Online|AdvancedVoice|Bulk")
+	static int32 ArePlayersMuted(uint8 LocalUserNumChecking, const TArray<FBPUniqueNetId>& UniqueNetIds, TArray<int32>& PackedResults);
+
+	// Reads the result for one entry of a bulk call
+	UFUNCTION(BlueprintPure, Category = "Online|AdvancedVoice|Bulk")
+	static bool GetPackedVoiceResult(const TArray<int32>& PackedResults, int32 Index);
+
 	// Gets the number of local talkers for this system
 	UFUNCTION(BlueprintPure, Category = "Online|AdvancedVoice|VoiceInfo")
 	static void GetNumLocalTalkers(int32 & NumLocalTalkers);
+
+	// Reads a talker's bit from the bitset passed to OnTalkingStatesChanged / OnPlayerVoiceStatesChanged
+	UFUNCTION(BlueprintPure, Category = "Online|AdvancedVoice|VoiceInfo")
+	static bool IsTalkerSlotTalking(const TArray<int32>& TalkingBits, int32 TalkerSlot);
 };	
@@ -14,6 +14,7 @@
 #include "GameFramework/PlayerController.h"
 #include "Modules/ModuleManager.h"
 #include "OnlineSubsystemUtilsClasses.h"
+#include "UniqueNetIdHandle.h"
 #include "BlueprintDataDefinitions.generated.h"	
 
 UENUM(BlueprintType)
@@ -150,15 +151,28 @@ struct FBPUniqueNetId
 	GENERATED_USTRUCT_BODY()
 
 private:
-	bool bUseDirectPointer;
+	// Interned, so copies are just the handle and the id outlives whatever delegate handed it to us
+	FUniqueNetIdHandle Handle;
 
+	// Deprecated along with UniqueNetId and UniqueNetIdPtr
+	bool bUseDirectPointer;
 
 public:
+
+	// Deprecated, use GetUniqueNetId or GetSharedUniqueNetId. Kept in sync with the handle for one more release so code
+	// still reading or setting them keeps working, they are only looked at when no handle is set
 	TSharedPtr<const FUniqueNetId> UniqueNetId;
 	const FUniqueNetId * UniqueNetIdPtr;
 
+	FBPUniqueNetId()
+		: bUseDirectPointer(false)
+		, UniqueNetIdPtr(nullptr)
+	{
+	}
+
 	void SetUniqueNetId(const TSharedPtr<const FUniqueNetId> &ID)
 	{
+		Handle = FUniqueNetIdHandle::Intern(ID);
 		bUseDirectPointer = false;
 		UniqueNetIdPtr = nullptr;
 		UniqueNetId = ID;
@@ -166,44 +180,71 @@ public:
 
 	void SetUniqueNetId(const FUniqueNetId *ID)
 	{
+		Handle = ID ? FUniqueNetIdHandle::Intern(*ID) : FUniqueNetIdHandle();
 		bUseDirectPointer = true;
-		UniqueNetIdPtr = ID;
+
+		// The interned copy, the id passed in is usually gone once the delegate that handed it over returns
+		UniqueNetIdPtr = Handle.Get();
+		UniqueNetId.Reset();
 	}
 
-	bool IsValid() const
+	void SetUniqueNetId(const FUniqueNetIdHandle &InHandle)
 	{
-		if (bUseDirectPointer && UniqueNetIdPtr != nullptr && UniqueNetIdPtr->IsValid())
-		{
-			return true;
-		}
-		else if (UniqueNetId.IsValid())
-		{
-			return true;
-		}
-		else
-			return false;
+		Handle = InHandle;
+		bUseDirectPointer = false;
+		UniqueNetIdPtr = nullptr;
+		UniqueNetId = InHandle.GetShared();
+	}
 
+	bool IsValid() const
+	{
+		return GetUniqueNetId() != nullptr;
 	}
 
 	const FUniqueNetId* GetUniqueNetId() const
 	{
-		if (bUseDirectPointer && UniqueNetIdPtr != nullptr)
-		{
-			// No longer converting to non const as all functions now pass const UniqueNetIds
-			return /*const_cast<FUniqueNetId*>*/(UniqueNetIdPtr);
-		}
-		else if (UniqueNetId.IsValid())
-		{
-			return UniqueNetId.Get();
-		}
-		else
-			return nullptr;
+		if (Handle.IsValid())
+			return Handle.Get();
+
+		// Only set through the deprecated members
+		if (bUseDirectPointer || UniqueNetIdPtr != nullptr)
+			return UniqueNetIdPtr != nullptr && UniqueNetIdPtr->IsValid() ? UniqueNetIdPtr : nullptr;
+
+		return UniqueNetId.IsValid() ? UniqueNetId.Get() : nullptr;
 	}
 
-	FBPUniqueNetId()
+	// For interfaces that take shared references
+	TSharedPtr<const FUniqueNetId> GetSharedUniqueNetId() const
 	{
-		bUseDirectPointer = false;
-		UniqueNetIdPtr = nullptr;
+		if (Handle.IsValid())
+			return Handle.GetShared();
+
+		// Only set through the deprecated members
+		if (UniqueNetId.IsValid())
+			return UniqueNetId;
+
+		return UniqueNetIdPtr != nullptr ? FUniqueNetIdHandle::Intern(*UniqueNetIdPtr).GetShared() : nullptr;
+	}
+
+	// Invalid if the id was only set through the deprecated members
+	const FUniqueNetIdHandle& GetHandle() const
+	{
+		return Handle;
+	}
+
+	friend bool operator==(const FBPUniqueNetId& A, const FBPUniqueNetId& B)
+	{
+		return A.Handle == B.Handle;
+	}
+
+	friend bool operator!=(const FBPUniqueNetId& A, const FBPUniqueNetId& B)
+	{
+		return A.Handle != B.Handle;
+	}
+
+	friend uint32 GetTypeHash(const FBPUniqueNetId& A)
+	{
+		return GetTypeHash(A.Handle);
 	}
 };
 
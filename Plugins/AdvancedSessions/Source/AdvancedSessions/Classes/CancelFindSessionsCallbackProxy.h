@@ -3,6 +3,7 @@
 #include "CoreMinimal.h"
 #include "Interfaces/OnlineSessionInterface.h"
 #include "BlueprintDataDefinitions.h"
+#include "AdvancedOnlineRequestScheduler.h"
 #include "CancelFindSessionsCallbackProxy.generated.h"
 
 UCLASS(MinimalAPI)
@@ -18,7 +19,7 @@ class UCancelFindSessionsCallbackProxy : public UOnlineBlueprintCallProxyBase
 	UPROPERTY(BlueprintAssignable)
 	FEmptyOnlineDelegate OnFailure;
 
-	// Cancels finding sessions
+	// Cancels finding sessions. Queued with other online calls, fails if the online subsystem hasn't answered within AdvancedSessions.RequestScheduler.Timeout seconds
 	UFUNCTION(BlueprintCallable, meta=(BlueprintInternalUseOnly = "true", WorldContext="WorldContextObject"), Category = "Online|AdvancedSessions")
 	static UCancelFindSessionsCallbackProxy* CancelFindSessions(UObject* WorldContextObject, class APlayerController* PlayerController);
 
@@ -30,6 +31,9 @@ private:
 	// Internal callback when the operation completes, calls out to the public success/failure callbacks
 	void OnCompleted(bool bWasSuccessful);
 
+	// Called by the request scheduler once the request is answered, timed out or dropped
+	void OnRequestFinished(EAdvancedOnlineRequestResult Result);
+
 private:
 	// The player controller triggering things
 	TWeakObjectPtr<APlayerController> PlayerControllerWeakPtr;
@@ -40,6 +44,9 @@ private:
 	// Handle to the registered OnDestroySessionComplete delegate
 	FDelegateHandle DelegateHandle;
 
+	// Id the scheduler gave our online call, 0 if this proxy shares someone else's
+	uint32 RequestId;
+
 	// The world context object in which this call is taking place
 	UObject* WorldContextObject;
 };
@@ -3,6 +3,7 @@
 #include "CoreMinimal.h"
 #include "Interfaces/OnlineSessionInterface.h"
 #include "BlueprintDataDefinitions.h"
+#include "AdvancedOnlineRequestScheduler.h"
 #include "EndSessionCallbackProxy.generated.h"
 
 UCLASS(MinimalAPI)
@@ -18,7 +19,7 @@ class UEndSessionCallbackProxy : public UOnlineBlueprintCallProxyBase
 	UPROPERTY(BlueprintAssignable)
 	FEmptyOnlineDelegate OnFailure;
 
-	// Ends the current session
+	// Ends the current session. Queued with other online calls, fails if the online subsystem hasn't answered within AdvancedSessions.RequestScheduler.Timeout seconds
 	UFUNCTION(BlueprintCallable, meta=(DeprecatedFunction,DeprecationMessage = "This function is deprecated, I realized that people have been using it wrong and it doesn't have much use in blueprints. Use Destroy Session only instead.",BlueprintInternalUseOnly = "true", WorldContext="WorldContextObject"), Category = "Online|AdvancedSessions|Deprecated")
 	static UEndSessionCallbackProxy* EndSession(UObject* WorldContextObject, class APlayerController* PlayerController);
 
@@ -30,6 +31,9 @@ private:
 	// Internal callback when the operation completes, calls out to the public success/failure callbacks
 	void OnCompleted(FName SessionName, bool bWasSuccessful);
 
+	// Called by the request scheduler once the request is answered, timed out or dropped
+	void OnRequestFinished(EAdvancedOnlineRequestResult Result);
+
 private:
 	// The player controller triggering things
 	TWeakObjectPtr<APlayerController> PlayerControllerWeakPtr;
@@ -40,6 +44,9 @@ private:
 	// Handle to the registered OnDestroySessionComplete delegate
 	FDelegateHandle DelegateHandle;
 
+	// Id the scheduler gave our online call, 0 if this proxy shares someone else's
+	uint32 RequestId;
+
 	// The world context object in which this call is taking place
 	UObject* WorldContextObject;
 };
@@ -4,6 +4,7 @@
 #include "CoreMinimal.h"
 #include "BlueprintDataDefinitions.h"
 #include "Engine/LocalPlayer.h"
+#include "AdvancedOnlineRequestScheduler.h"
 #include "FindFriendSessionCallbackProxy.generated.h"
 
 DECLARE_LOG_CATEGORY_EXTERN(AdvancedFindFriendSessionLog, Log, All);
@@ -23,7 +24,7 @@ class UFindFriendSessionCallbackProxy : public UOnlineBlueprintCallProxyBase
 	UPROPERTY(BlueprintAssignable)
 	FBlueprintFindFriendSessionDelegate OnFailure;
 
-	// Attempts to get the current session that a friend is in
+	// Attempts to get the current session that a friend is in. Queued with other online calls, fails if the online subsystem hasn't answered within AdvancedSessions.RequestScheduler.Timeout seconds
 	UFUNCTION(BlueprintCallable, meta=(BlueprintInternalUseOnly = "true", WorldContext="WorldContextObject"), Category = "Online|AdvancedFriends")
 	static UFindFriendSessionCallbackProxy* FindFriendSession(UObject* WorldContextObject, APlayerController *PlayerController, const FBPUniqueNetId &FriendUniqueNetId);
 
@@ -33,6 +34,9 @@ private:
 	// Internal callback when the friends list is retrieved
 	void OnFindFriendSessionCompleted(int32 LocalPlayer, bool bWasSuccessful, const TArray<FOnlineSessionSearchResult>& SessionInfo);
 
+	// Called by the request scheduler once the request is answered, timed out or dropped
+	void OnRequestFinished(EAdvancedOnlineRequestResult Result);
+
 	// The player controller triggering things
 	TWeakObjectPtr<APlayerController> PlayerControllerWeakPtr;
 
@@ -45,6 +49,15 @@ private:
 	// Handles to the registered delegates above
 	FDelegateHandle FindFriendSessionCompleteDelegateHandle;
 
+	// The local player the search was made for
+	int32 LocalPlayerNum;
+
+	// Sessions found, kept until the scheduler finishes the request
+	TArray<FBlueprintSessionResult> SessionResults;
+
+	// Id the scheduler gave our online call, 0 if this proxy shares someone else's
+	uint32 RequestId;
+
 	// The world context object in which this call is taking place
 	UObject* WorldContextObject;
 };
@@ -4,6 +4,7 @@
 #include "Interfaces/OnlineSessionInterface.h"
 #include "FindSessionsCallbackProxy.h"
 #include "BlueprintDataDefinitions.h"
+#include "SessionQosProber.h"
 #include "FindSessionsCallbackProxyAdvanced.generated.h"
 
 UCLASS(MinimalAPI)
@@ -51,9 +52,23 @@ private:
 	// Internal callback when the session search completes, calls out to the public success/failure callbacks
 	void OnCompleted(bool bSuccess);
 
+	// Hands the results to OnSuccess, first ranking them by measured ping when AdvancedSessions.SessionQos.RankSearchResults is set
+	void BroadcastSuccess();
+
+	void OnQosUpdated();
+	bool OnQosProbeTimeout(float DeltaTime);
+	void FinishQosProbe();
+
+	// Only alive while ranking a finished search
+	TUniquePtr<FSessionQosProber> QosProber;
+	FDelegateHandle QosTimeoutHandle;
+
 	bool bRunSecondSearch;
 	bool bIsOnSecondSearch;
 
+	// When the current FindSessions pass was issued, for search telemetry
+	double SearchStartTime;
+
 	TArray<FBlueprintSessionResult> SessionSearchResults;
 
 private:
@@ -4,6 +4,7 @@
 #include "CoreMinimal.h"
 #include "BlueprintDataDefinitions.h"
 #include "Engine/LocalPlayer.h"
+#include "AdvancedOnlineRequestScheduler.h"
 #include "GetFriendsCallbackProxy.generated.h"
 
 DECLARE_LOG_CATEGORY_EXTERN(AdvancedGetFriendsLog, Log, All);
@@ -23,7 +24,7 @@ class UGetFriendsCallbackProxy : public UOnlineBlueprintCallProxyBase
 	UPROPERTY(BlueprintAssignable)
 	FBlueprintGetFriendsListDelegate OnFailure;
 
-	// Gets the players list of friends from the OnlineSubsystem and returns it, can be retrieved later with GetStoredFriendsList
+	// Gets the players list of friends from the OnlineSubsystem and returns it, can be retrieved later with GetStoredFriendsList. Queued with other online calls, fails if the online subsystem hasn't answered within AdvancedSessions.RequestScheduler.Timeout seconds
 	UFUNCTION(BlueprintCallable, meta=(BlueprintInternalUseOnly = "true", WorldContext="WorldContextObject"), Category = "Online|AdvancedFriends")
 	static UGetFriendsCallbackProxy* GetAndStoreFriendsList(UObject* WorldContextObject, class APlayerController* PlayerController);
 
@@ -33,6 +34,9 @@ private:
 	// Internal callback when the friends list is retrieved
 	void OnReadFriendsListCompleted(int32 LocalUserNum, bool bWasSuccessful, const FString& ListName, const FString& ErrorString);
 
+	// Called by the request scheduler once the request is answered, timed out or dropped
+	void OnRequestFinished(EAdvancedOnlineRequestResult Result);
+
 	// The player controller triggering things
 	TWeakObjectPtr<APlayerController> PlayerControllerWeakPtr;
 
@@ -43,6 +47,12 @@ private:
 	// Removed because all but the facebook interfaces don't even currently support anything but the default friends list.
 	//EBPFriendsLists FriendListToGet;
 
+	// Controller id of the local player the list is read for
+	int32 ControllerId;
+
+	// Id the scheduler gave our online call, 0 if this proxy shares someone else's
+	uint32 RequestId;
+
 	// The world context object in which this call is taking place
 	UObject* WorldContextObject;
 };
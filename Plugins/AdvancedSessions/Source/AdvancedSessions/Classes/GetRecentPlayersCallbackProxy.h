@@ -3,6 +3,7 @@
 
 #include "CoreMinimal.h"
 #include "BlueprintDataDefinitions.h"
+#include "AdvancedOnlineRequestScheduler.h"
 #include "GetRecentPlayersCallbackProxy.generated.h"
 
 DECLARE_LOG_CATEGORY_EXTERN(AdvancedGetRecentPlayersLog, Log, All);
@@ -22,7 +23,7 @@ class UGetRecentPlayersCallbackProxy : public UOnlineBlueprintCallProxyBase
 	UPROPERTY(BlueprintAssignable)
 	FBlueprintGetRecentPlayersDelegate OnFailure;
 
-	// Gets the list of recent players from the OnlineSubsystem and returns it, can be retrieved later with GetStoredRecentPlayersList, can fail if no recent players are found
+	// Gets the list of recent players from the OnlineSubsystem and returns it, can be retrieved later with GetStoredRecentPlayersList, can fail if no recent players are found. Queued with other online calls, fails if the online subsystem hasn't answered within AdvancedSessions.RequestScheduler.Timeout seconds
 	UFUNCTION(BlueprintCallable, meta=(BlueprintInternalUseOnly = "true", WorldContext="WorldContextObject"), Category = "Online|AdvancedFriends")
 	static UGetRecentPlayersCallbackProxy* GetAndStoreRecentPlayersList(UObject* WorldContextObject, const FBPUniqueNetId &UniqueNetId);
 
@@ -31,6 +32,9 @@ class UGetRecentPlayersCallbackProxy : public UOnlineBlueprintCallProxyBase
 private:
 	// Internal callback when the friends list is retrieved
 	void OnQueryRecentPlayersCompleted(const FUniqueNetId &UserID, const FString &Namespace, bool bWasSuccessful, const FString& ErrorString);
+
+	// Called by the request scheduler once the request is answered, timed out or dropped
+	void OnRequestFinished(EAdvancedOnlineRequestResult Result);
 	// Handle to the registered OnFindSessionsComplete delegate
 	FDelegateHandle DelegateHandle;
 
@@ -43,6 +47,9 @@ private:
 	// The delegate executed
 	FOnQueryRecentPlayersCompleteDelegate QueryRecentPlayersCompleteDelegate;
 
+	// Id the scheduler gave our online call, 0 if this proxy shares someone else's
+	uint32 RequestId;
+
 	// The world context object in which this call is taking place
 	UObject* WorldContextObject;
 };
@@ -5,6 +5,7 @@
 #include "BlueprintDataDefinitions.h"
 #include "Interfaces/OnlineIdentityInterface.h"
 #include "Engine/LocalPlayer.h"
+#include "AdvancedOnlineRequestScheduler.h"
 #include "LoginUserCallbackProxy.generated.h"
 
 UCLASS(MinimalAPI)
@@ -20,7 +21,7 @@ class ULoginUserCallbackProxy : public UOnlineBlueprintCallProxyBase
 	UPROPERTY(BlueprintAssignable)
 	FEmptyOnlineDelegate OnFailure;
 
-	// Logs into the identity interface
+	// Logs into the identity interface. Queued behind other logins and logouts, waits as long as the online subsystem takes unless AdvancedSessions.RequestScheduler.Timeout.Identity is set
 	UFUNCTION(BlueprintCallable, meta=(BlueprintInternalUseOnly = "true", WorldContext="WorldContextObject"), Category = "Online|AdvancedIdentity")
 	static ULoginUserCallbackProxy* LoginUser(UObject* WorldContextObject, class APlayerController* PlayerController, FString UserID, FString UserToken);
 
@@ -32,6 +33,9 @@ private:
 	// Internal callback when the operation completes, calls out to the public success/failure callbacks
 	void OnCompleted(int32 LocalUserNum, bool bWasSuccessful, const FUniqueNetId& UserId, const FString& ErrorVal);
 
+	// Called by the request scheduler once the request is answered, timed out or dropped
+	void OnRequestFinished(EAdvancedOnlineRequestResult Result);
+
 private:
 	// The player controller triggering things
 	TWeakObjectPtr<APlayerController> PlayerControllerWeakPtr;
@@ -48,6 +52,9 @@ private:
 	// Handle to the registered OnDestroySessionComplete delegate
 	FDelegateHandle DelegateHandle;
 
+	// Id the scheduler gave our online call, 0 if this proxy shares someone else's
+	uint32 RequestId;
+
 	// The world context object in which this call is taking place
 	UObject* WorldContextObject;
 };
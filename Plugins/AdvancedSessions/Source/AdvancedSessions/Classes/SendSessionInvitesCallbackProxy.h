@@ -0,0 +1,60 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BlueprintDataDefinitions.h"
+#include "SessionInviteDispatcher.h"
+#include "Engine/LocalPlayer.h"
+#include "SendSessionInvitesCallbackProxy.generated.h"
+
+USTRUCT(BlueprintType)
+struct FBPSessionInviteResult
+{
+	GENERATED_USTRUCT_BODY()
+
+public:
+	UPROPERTY(BlueprintReadOnly, Category = "Online|AdvancedFriends")
+	FBPUniqueNetId Recipient;
+
+	// False if every attempt to send it failed
+	UPROPERTY(BlueprintReadOnly, Category = "Online|AdvancedFriends")
+	bool bSent = false;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Online|AdvancedFriends")
+	int32 Attempts = 0;
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FBlueprintSendSessionInvitesDelegate, const TArray<FBPSessionInviteResult>&, Results);
+
+UCLASS(MinimalAPI)
+class USendSessionInvitesCallbackProxy : public UOnlineBlueprintCallProxyBase
+{
+	GENERATED_UCLASS_BODY()
+
+	// Called when every invite went out
+	UPROPERTY(BlueprintAssignable)
+	FBlueprintSendSessionInvitesDelegate OnSuccess;
+
+	// Called when any invite failed, the results say which
+	UPROPERTY(BlueprintAssignable)
+	FBlueprintSendSessionInvitesDelegate OnFailure;
+
+	// Invites a list of players to the current session in rate limited chunks, failed chunks are retried (see AdvancedSessions.Invites.*)
+	UFUNCTION(BlueprintCallable, meta=(BlueprintInternalUseOnly = "true", WorldContext="WorldContextObject"), Category = "Online|AdvancedFriends")
+	static USendSessionInvitesCallbackProxy* SendSessionInvites(UObject* WorldContextObject, APlayerController *PlayerController, const TArray<FBPUniqueNetId> &Recipients);
+
+	virtual void Activate() override;
+
+private:
+	// Internal callback when the dispatcher has finished the batch
+	void OnInvitesDispatched(const TArray<FSessionInviteResult>& Results);
+
+	// The player controller triggering things
+	TWeakObjectPtr<APlayerController> PlayerControllerWeakPtr;
+
+	// The people to invite
+	TArray<FBPUniqueNetId> Recipients;
+
+	// The world context object in which this call is taking place
+	UObject* WorldContextObject;
+};
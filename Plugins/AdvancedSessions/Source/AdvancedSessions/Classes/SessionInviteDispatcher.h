@@ -0,0 +1,81 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+#include "CoreMinimal.h"
+#include "UniqueNetIdHandle.h"
+#include "Containers/Ticker.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(AdvancedSessionInviteLog, Log, All);
+
+// Outcome for one invited player
+struct FSessionInviteResult
+{
+	FUniqueNetIdHandle Recipient;
+	bool bSent;
+	int32 Attempts;
+
+	FSessionInviteResult()
+		: bSent(false)
+		, Attempts(0)
+	{
+	}
+};
+
+DECLARE_DELEGATE_OneParam(FOnSessionInvitesDispatched, const TArray<FSessionInviteResult>& /*Results*/);
+
+/**
+ * Sends session invites in backend sized chunks instead of one call for the whole list.
+ * Chunks go out through a token bucket (one token per recipient) so large invite waves stay under the backend's throttle,
+ * chunks the subsystem rejects are retried with exponential backoff and the caller gets a result per recipient once
+ * every chunk of its batch has either gone out or run out of retries.
+ * Limits are the AdvancedSessions.Invites.* cvars. Game thread only.
+ */
+class ADVANCEDSESSIONS_API FSessionInviteDispatcher
+{
+public:
+
+	static FSessionInviteDispatcher& Get();
+
+	// Queues invites to the named session, duplicate and invalid recipients are dropped. Returns the number queued
+	int32 Enqueue(int32 LocalUserNum, FName SessionName, const TArray<FUniqueNetIdHandle>& Recipients, const FOnSessionInvitesDispatched& OnDispatched);
+
+	// Recipients queued or waiting on a retry
+	int32 GetNumPending() const;
+
+private:
+
+	FSessionInviteDispatcher();
+
+	struct FChunk
+	{
+		int32 BatchId;
+		TArray<int32, TInlineAllocator<32>> ResultIndices;
+		int32 Attempts;
+		double NextAttemptTime;
+	};
+
+	struct FBatch
+	{
+		int32 LocalUserNum;
+		FName SessionName;
+		TArray<FSessionInviteResult> Results;
+		int32 ChunksRemaining;
+		FOnSessionInvitesDispatched OnDispatched;
+	};
+
+	bool Tick(float DeltaTime);
+	void RefillTokens(double Now);
+
+	// Returns false if the chunk should be retried
+	bool SendChunk(const FChunk& Chunk, FBatch& Batch, bool& bOutPermanentFailure);
+	void FinishChunk(const FChunk& Chunk, bool bSent);
+
+	TArray<FChunk> Chunks;
+	TMap<int32, FBatch> Batches;
+	int32 NextBatchId;
+
+	double Tokens;
+	double LastRefillTime;
+
+	FDelegateHandle TickerHandle;
+};
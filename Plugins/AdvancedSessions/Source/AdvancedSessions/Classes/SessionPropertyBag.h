@@ -0,0 +1,103 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+#include "CoreMinimal.h"
+#include "BlueprintDataDefinitions.h"
+#include "SessionPropertyBag.generated.h"
+
+// Maps a native type to the variant type it is stored as in session settings
+template<typename T> struct TSessionPropertyType;
+template<> struct TSessionPropertyType<bool> { static const EOnlineKeyValuePairDataType::Type Value = EOnlineKeyValuePairDataType::Bool; };
+template<> struct TSessionPropertyType<int32> { static const EOnlineKeyValuePairDataType::Type Value = EOnlineKeyValuePairDataType::Int32; };
+template<> struct TSessionPropertyType<float> { static const EOnlineKeyValuePairDataType::Type Value = EOnlineKeyValuePairDataType::Float; };
+template<> struct TSessionPropertyType<FString> { static const EOnlineKeyValuePairDataType::Type Value = EOnlineKeyValuePairDataType::String; };
+
+// Session properties indexed by key, build once per result and read as many properties as needed without scanning
+USTRUCT(BlueprintType)
+struct FBPSessionPropertyBag
+{
+	GENERATED_USTRUCT_BODY()
+
+public:
+
+	// Properties in the order they were added
+	TArray<FSessionPropertyKeyPair> Properties;
+
+	// Key to index in Properties
+	TMap<FName, int32> Index;
+
+	void Reset(int32 ExpectedNum = 0)
+	{
+		Properties.Reset(ExpectedNum);
+		Index.Reset();
+		Index.Reserve(ExpectedNum);
+	}
+
+	void Build(const TArray<FSessionPropertyKeyPair>& InProperties)
+	{
+		Reset(InProperties.Num());
+		for (const FSessionPropertyKeyPair& Property : InProperties)
+		{
+			AddOrModify(Property.Key, Property.Data);
+		}
+	}
+
+	void Build(const FOnlineSessionSettings& SessionSettings)
+	{
+		Reset(SessionSettings.Settings.Num());
+		for (const TPair<FName, FOnlineSessionSetting>& Setting : SessionSettings.Settings)
+		{
+			AddOrModify(Setting.Key, Setting.Value.Data);
+		}
+	}
+
+	void AddOrModify(FName Key, const FVariantData& Data)
+	{
+		if (const int32* Existing = Index.Find(Key))
+		{
+			Properties[*Existing].Data = Data;
+			return;
+		}
+
+		Index.Add(Key, Properties.Num());
+		FSessionPropertyKeyPair& NewProperty = Properties.AddDefaulted_GetRef();
+		NewProperty.Key = Key;
+		NewProperty.Data = Data;
+	}
+
+	const FVariantData* Find(FName Key) const
+	{
+		const int32* Found = Index.Find(Key);
+		return Found ? &Properties[*Found].Data : nullptr;
+	}
+
+	template<typename T>
+	ESessionSettingSearchResult Get(FName Key, T& OutValue) const
+	{
+		return GetTypedValue(Find(Key), OutValue);
+	}
+
+	// Single lookup in a plain array for when building a bag isn't worth it, no copies
+	static const FVariantData* FindIn(const TArray<FSessionPropertyKeyPair>& InProperties, FName Key)
+	{
+		for (const FSessionPropertyKeyPair& Property : InProperties)
+		{
+			if (Property.Key == Key)
+				return &Property.Data;
+		}
+		return nullptr;
+	}
+
+	template<typename T>
+	static ESessionSettingSearchResult GetTypedValue(const FVariantData* Data, T& OutValue)
+	{
+		if (!Data)
+			return ESessionSettingSearchResult::NotFound;
+
+		if (Data->GetType() != TSessionPropertyType<T>::Value)
+			return ESessionSettingSearchResult::WrongType;
+
+		Data->GetValue(OutValue);
+		return ESessionSettingSearchResult::Found;
+	}
+};
@@ -0,0 +1,206 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+#include "CoreMinimal.h"
+#include "BlueprintDataDefinitions.h"
+#include "Containers/Queue.h"
+#include "Containers/Ticker.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "IPAddress.h"
+#include "SessionQosProber.generated.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(AdvancedSessionQosLog, Log, All);
+
+// Smoothed latency and loss stats for a single probed host
+USTRUCT(BlueprintType)
+struct FBPSessionQosStats
+{
+	GENERATED_USTRUCT_BODY()
+
+public:
+
+	// Exponentially smoothed round trip time in milliseconds, -1 until the first reply comes back
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Online|AdvancedSessions|Qos")
+	float SmoothedRttMs;
+
+	// Smoothed mean deviation of the round trip time in milliseconds (jitter)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Online|AdvancedSessions|Qos")
+	float RttDeviationMs;
+
+	// Smoothed fraction of probes that never came back (0 - 1)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Online|AdvancedSessions|Qos")
+	float LossRatio;
+
+	// Total probes sent / received for this host
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Online|AdvancedSessions|Qos")
+	int32 ProbesSent;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Online|AdvancedSessions|Qos")
+	int32 ProbesReceived;
+
+	FBPSessionQosStats()
+		: SmoothedRttMs(-1.f)
+		, RttDeviationMs(0.f)
+		, LossRatio(0.f)
+		, ProbesSent(0)
+		, ProbesReceived(0)
+	{
+	}
+
+	bool HasSamples() const
+	{
+		return ProbesReceived > 0;
+	}
+
+	// Lower is better, loss is folded in as a fixed latency penalty so lossy hosts sink in the ranking
+	float GetScore(float LossPenaltyMs) const
+	{
+		return SmoothedRttMs + RttDeviationMs + (LossRatio * LossPenaltyMs);
+	}
+};
+
+// Tuning for the prober, defaults are sane for a server browser
+struct FSessionQosSettings
+{
+	// Most hosts this prober has rounds in flight for at once, the pool threads are shared by every prober
+	int32 MaxConcurrentProbes;
+
+	// Pings sent to a host each round
+	int32 PingsPerRound;
+
+	// How long to wait for each echo before counting it as lost
+	float PingTimeoutSeconds;
+
+	// Delay between probe rounds for the same host
+	float RoundIntervalSeconds;
+
+	// Weight of the newest sample in the moving averages (0 - 1)
+	float SmoothingFactor;
+
+	// Latency penalty applied per unit of loss when ranking
+	float LossPenaltyMs;
+
+	FSessionQosSettings()
+		: MaxConcurrentProbes(4)
+		, PingsPerRound(3)
+		, PingTimeoutSeconds(0.5f)
+		, RoundIntervalSeconds(2.f)
+		, SmoothingFactor(0.25f)
+		, LossPenaltyMs(250.f)
+	{
+	}
+};
+
+// Raw outcome of one probe round, produced on a worker thread
+struct FSessionQosProbeResult
+{
+	FString Key;
+
+	// Generation of the prober when the round was dispatched
+	int32 Generation;
+
+	int32 Sent;
+	int32 Received;
+	TArray<float, TInlineAllocator<8>> RttSamplesMs;
+
+	FSessionQosProbeResult()
+		: Generation(0)
+		, Sent(0)
+		, Received(0)
+	{
+	}
+};
+
+typedef TQueue<FSessionQosProbeResult, EQueueMode::Mpsc> FSessionQosResultQueue;
+
+// Shared between a prober and its queued rounds so a late round never touches a destroyed prober
+struct FSessionQosProbeState
+{
+	FSessionQosResultQueue Results;
+
+	// Bumped when the targets are cleared or the prober goes away, rounds from an older generation are skipped or dropped
+	FThreadSafeCounter Generation;
+};
+
+DECLARE_MULTICAST_DELEGATE(FOnSessionQosUpdated);
+
+/**
+ * Pings candidate hosts over UDP on a small thread pool shared by every prober and keeps smoothed RTT / loss stats per host.
+ * The remote end only needs to echo the datagram back, so a plain UDP echo on loopback works as a stand in host.
+ * Ticks on the game thread, stats and the OnQosUpdated delegate are only touched there.
+ */
+class ADVANCEDSESSIONS_API FSessionQosProber : public FTickerObjectBase
+{
+public:
+
+	FSessionQosProber(const FSessionQosSettings& InSettings = FSessionQosSettings());
+	virtual ~FSessionQosProber();
+
+	// Adds (or re-targets) a host to probe, the key is what the stats are looked up by
+	void AddTarget(const FString& Key, const TSharedRef<FInternetAddr>& Address);
+
+	// Adds a host from a session search result, keyed by its session id. If ProbePort is <= 0 the game port is probed
+	bool AddSearchResult(const FBlueprintSessionResult& SearchResult, int32 ProbePort = 0);
+
+	void RemoveTarget(const FString& Key);
+
+	// Rounds still in flight for the old targets are dropped
+	void ClearTargets();
+
+	// Starts / stops issuing probe rounds, results already in flight are still collected after stopping
+	void Start();
+	void Stop();
+	bool IsRunning() const { return bRunning; }
+
+	// Returns false if the host is unknown
+	bool GetStats(const FString& Key, FBPSessionQosStats& OutStats) const;
+
+	// True once every target has finished at least one round, answered or not
+	bool HasProbedAllTargets() const;
+
+	// Sorts results best first by measured quality, writes the smoothed ping into PingInMs for probed hosts
+	// Hosts without samples yet are ranked by the ping the subsystem reported
+	void RankResults(TArray<FBlueprintSessionResult>& Results) const;
+
+	// Called on the game thread whenever new samples changed the stats (and with it the ranking)
+	FOnSessionQosUpdated OnQosUpdated;
+
+	// FTickerObjectBase
+	virtual bool Tick(float DeltaTime) override;
+
+	// Waits on rounds mid probe and abandons the queued ones, called when the module shuts down
+	static void ShutdownPool();
+
+private:
+
+	struct FQosTarget
+	{
+		TSharedRef<FInternetAddr> Address;
+		FBPSessionQosStats Stats;
+		double LastRoundTime;
+		bool bInFlight;
+
+		FQosTarget(const TSharedRef<FInternetAddr>& InAddress)
+			: Address(InAddress)
+			, LastRoundTime(0.0)
+			, bInFlight(false)
+		{
+		}
+	};
+
+	void ApplyResult(const FSessionQosProbeResult& Result);
+	void DispatchRounds(double Now);
+
+	FSessionQosSettings Settings;
+
+	TMap<FString, FQosTarget> Targets;
+
+	static class FQueuedThreadPool* GetPool();
+
+	TSharedRef<FSessionQosProbeState, ESPMode::ThreadSafe> State;
+
+	int32 NumInFlight;
+	uint32 NextNonce;
+	bool bRunning;
+
+	static class FQueuedThreadPool* Pool;
+};
@@ -0,0 +1,53 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+#include "CoreMinimal.h"
+#include "OnlineSessionSettings.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(AdvancedSessionSearchTelemetryLog, Log, All);
+
+// Upper bounds (inclusive) of the histogram buckets, the last bucket catches everything above
+#define SEARCH_TELEMETRY_LATENCY_BUCKETS 8
+#define SEARCH_TELEMETRY_RESULT_BUCKETS 7
+
+// Point in time copy of the search counters
+struct FSessionSearchTelemetrySnapshot
+{
+	int32 NumSearches;
+	int32 NumFailed;
+	int64 TotalResults;
+	double TotalLatencySeconds;
+	double MaxLatencySeconds;
+
+	int32 LatencyHistogram[SEARCH_TELEMETRY_LATENCY_BUCKETS];
+	int32 ResultCountHistogram[SEARCH_TELEMETRY_RESULT_BUCKETS];
+
+	FSessionSearchTelemetrySnapshot()
+	{
+		FMemory::Memzero(*this);
+	}
+};
+
+/**
+ * Aggregated session search diagnostics, replaces logging every single search result.
+ * Recording is a handful of integer adds, and only one in every AdvancedSessions.SearchTelemetry.SampleRate searches
+ * writes a summary line to the log. Toggle with AdvancedSessions.SearchTelemetry, dump with AdvancedSessions.DumpSearchTelemetry.
+ * Game thread only.
+ */
+class ADVANCEDSESSIONS_API FSessionSearchTelemetry
+{
+public:
+
+	static bool IsEnabled();
+
+	// Records one completed FindSessions pass
+	static void RecordSearch(bool bSuccess, double LatencySeconds, const TArray<FOnlineSessionSearchResult>& Results);
+
+	static void GetSnapshot(FSessionSearchTelemetrySnapshot& OutSnapshot);
+	static void Reset();
+	static void Dump(FOutputDevice& Ar);
+
+	// Bucket bounds, exposed so dumps and external tooling label them the same way
+	static const int32 LatencyBucketMs[SEARCH_TELEMETRY_LATENCY_BUCKETS - 1];
+	static const int32 ResultCountBucket[SEARCH_TELEMETRY_RESULT_BUCKETS - 1];
+};
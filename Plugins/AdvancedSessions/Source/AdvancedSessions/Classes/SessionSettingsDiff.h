@@ -0,0 +1,117 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+#include "CoreMinimal.h"
+#include "BlueprintDataDefinitions.h"
+#include "SessionPropertyBag.h"
+#include "Containers/Ticker.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(AdvancedSessionUpdateLog, Log, All);
+
+// Requested state for the game session, what UpdateSession gets called with
+struct FSessionSettingsUpdate
+{
+	int32 NumPublicConnections;
+	int32 NumPrivateConnections;
+	bool bUseLAN;
+	bool bAllowInvites;
+	bool bAllowJoinInProgress;
+	bool bIsDedicated;
+	bool bRefreshOnlineData;
+
+	// Extra settings to add or modify, settings not in here are left alone
+	FBPSessionPropertyBag ExtraSettings;
+
+	FSessionSettingsUpdate()
+		: NumPublicConnections(0)
+		, NumPrivateConnections(0)
+		, bUseLAN(false)
+		, bAllowInvites(false)
+		, bAllowJoinInProgress(false)
+		, bIsDedicated(false)
+		, bRefreshOnlineData(false)
+	{
+	}
+
+	// Folds a newer request into this one, the newer values win
+	void Merge(const FSessionSettingsUpdate& Newer);
+};
+
+// Which parts of the session settings differ from a requested update
+struct ADVANCEDSESSIONS_API FSessionSettingsDiff
+{
+	enum EField : uint32
+	{
+		PublicConnections	= 1 << 0,
+		PrivateConnections	= 1 << 1,
+		LANMatch			= 1 << 2,
+		AllowInvites		= 1 << 3,
+		AllowJoinInProgress	= 1 << 4,
+		Dedicated			= 1 << 5,
+	};
+
+	uint32 ChangedFields;
+	TArray<FName, TInlineAllocator<8>> ChangedKeys;
+
+	// True if any changed value is advertised and has to be pushed to the online service
+	bool bNeedsOnlineRefresh;
+
+	FSessionSettingsDiff()
+		: ChangedFields(0)
+		, bNeedsOnlineRefresh(false)
+	{
+	}
+
+	bool IsEmpty() const
+	{
+		return ChangedFields == 0 && ChangedKeys.Num() == 0;
+	}
+
+	static FSessionSettingsDiff Compute(const FOnlineSessionSettings& Current, const FSessionSettingsUpdate& Requested);
+
+	// Writes only the changed fields and keys into the settings
+	void Apply(FOnlineSessionSettings& Current, const FSessionSettingsUpdate& Requested) const;
+};
+
+DECLARE_DELEGATE_OneParam(FOnSessionUpdateFlushed, bool /*bWasSuccessful*/);
+
+/**
+ * Funnels UpdateSession requests for the game session so bursts of updates become a single online service call.
+ * Requests arriving within AdvancedSessions.UpdateSessionCoalesceWindow seconds of each other, or while an update is
+ * still in flight, are merged. Each flush diffs against the live settings and skips the call entirely if nothing changed.
+ * An update that hasn't completed within AdvancedSessions.UpdateSessionTimeout seconds fails and the next batch goes out.
+ */
+class ADVANCEDSESSIONS_API FSessionUpdateCoalescer
+{
+public:
+
+	static FSessionUpdateCoalescer& Get();
+
+	// Queues an update, OnFlushed is called once the batch it ended up in has been applied (or skipped)
+	void Submit(const FSessionSettingsUpdate& Update, const FOnSessionUpdateFlushed& OnFlushed);
+
+private:
+
+	FSessionUpdateCoalescer();
+
+	bool OnWindowElapsed(float DeltaTime);
+	void Flush();
+	void OnUpdateSessionComplete(FName SessionName, bool bWasSuccessful);
+	bool OnUpdateTimedOut(float DeltaTime);
+
+	static void NotifyWaiters(TArray<FOnSessionUpdateFlushed>& Waiters, bool bWasSuccessful);
+
+	// Merged request waiting for its window to close
+	FSessionSettingsUpdate Pending;
+	TArray<FOnSessionUpdateFlushed> PendingWaiters;
+	bool bHasPending;
+	bool bWindowElapsed;
+
+	// Waiters on the UpdateSession call currently in flight
+	TArray<FOnSessionUpdateFlushed> InFlightWaiters;
+	bool bInFlight;
+
+	FDelegateHandle WindowTickerHandle;
+	FDelegateHandle UpdateCompleteDelegateHandle;
+	FDelegateHandle TimeoutTickerHandle;
+};
@@ -0,0 +1,72 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+#include "CoreMinimal.h"
+#include "OnlineSubsystemTypes.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(AdvancedUniqueNetIdLog, Log, All);
+
+/**
+ * Compact value handle to a unique net id.
+ * Ids are interned once into a process wide table that owns a copy of them, after that the handle is an index plus the
+ * id's type. Copying, hashing and comparing are integer operations and dereferencing never touches a refcount.
+ * Entries are never released, the table only grows by the number of distinct players seen.
+ * Interning and Find take a lock that guards the table, Get doesn't and can be called from any thread. The lock does
+ * nothing for the ids themselves: unique net id shared pointers don't use thread safe reference counts, and interning a
+ * raw id may ask its subsystem to recreate it. So intern and call GetShared on the game thread.
+ */
+struct ADVANCEDSESSIONS_API FUniqueNetIdHandle
+{
+public:
+
+	FUniqueNetIdHandle()
+		: Index(0)
+	{
+	}
+
+	// Returns the handle for this id, adding a copy of it to the table if it is new
+	static FUniqueNetIdHandle Intern(const FUniqueNetId& UserId);
+	static FUniqueNetIdHandle Intern(const TSharedPtr<const FUniqueNetId>& UserId);
+
+	// Returns the handle for this id if it has been interned, an invalid handle otherwise. Never adds to the table
+	static FUniqueNetIdHandle Find(const FUniqueNetId& UserId);
+
+	bool IsValid() const { return Index != 0; }
+
+	// Subsystem type of the id, readable without resolving the handle
+	FName GetType() const { return Type; }
+
+	// Stable for the life of the process, null for an invalid handle
+	const FUniqueNetId* Get() const;
+
+	// For interfaces that need a shared reference
+	TSharedPtr<const FUniqueNetId> GetShared() const;
+
+	friend bool operator==(const FUniqueNetIdHandle& A, const FUniqueNetIdHandle& B)
+	{
+		// Interning makes the index unique per id, the type comes along for free
+		return A.Index == B.Index;
+	}
+
+	friend bool operator!=(const FUniqueNetIdHandle& A, const FUniqueNetIdHandle& B)
+	{
+		return A.Index != B.Index;
+	}
+
+	friend uint32 GetTypeHash(const FUniqueNetIdHandle& Handle)
+	{
+		return Handle.Index;
+	}
+
+private:
+
+	FUniqueNetIdHandle(uint32 InIndex, FName InType)
+		: Index(InIndex)
+		, Type(InType)
+	{
+	}
+
+	// 0 is reserved for invalid
+	uint32 Index;
+	FName Type;
+};
@@ -27,14 +27,8 @@ class UUpdateSessionCallbackProxyAdvanced : public UOnlineBlueprintCallProxyBase
 	// End of UOnlineBlueprintCallProxyBase interface
 
 private:
-	// Internal callback when session creation completes, calls StartSession
-	void OnUpdateCompleted(FName SessionName, bool bWasSuccessful);
-
-	// The delegate executed by the online subsystem
-	FOnUpdateSessionCompleteDelegate OnUpdateSessionCompleteDelegate;
-
-	// Handles to the registered delegates above
-	FDelegateHandle OnUpdateSessionCompleteDelegateHandle;
+	// Internal callback when the batch this update was merged into has been applied (or skipped as a no-op)
+	void OnUpdateCompleted(bool bWasSuccessful);
 
 	// Number of public connections
 	int NumPublicConnections;
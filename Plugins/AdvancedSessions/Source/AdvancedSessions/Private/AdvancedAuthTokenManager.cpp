@@ -0,0 +1,306 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+#include "AdvancedAuthTokenManager.h"
+
+#include "HAL/IConsoleManager.h"
+#include "OnlineSubsystem.h"
+#include "OnlineSubsystemUtils.h"
+
+DEFINE_LOG_CATEGORY(AdvancedAuthTokenLog);
+
+static TAutoConsoleVariable<float> CVarAuthTokenLifetime(
+	TEXT("AdvancedSessions.AuthToken.Lifetime"),
+	0.f,
+	TEXT("Seconds the platform accepts an auth token for, only set it if the platform really expires them. 0 keeps a token until the player logs out or platform code reports an expiry."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarAuthTokenRefreshLead(
+	TEXT("AdvancedSessions.AuthToken.RefreshLead"),
+	60.f,
+	TEXT("Seconds before a token expires that it is fetched again in the background."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarAuthTokenReuse(
+	TEXT("AdvancedSessions.AuthToken.ReuseAcrossConnects"),
+	0,
+	TEXT("Hand the same cached token to every GetAuthToken call until it expires.\n")
+	TEXT("0: each token is handed out once, later calls fetch a new one (needed where every token is its own ticket, like steam)\n")
+	TEXT("1: reuse the cached token"),
+	ECVF_Default);
+
+FAdvancedAuthTokenManager* FAdvancedAuthTokenManager::Instance = nullptr;
+
+FAdvancedAuthTokenManager& FAdvancedAuthTokenManager::Get()
+{
+	if (!Instance)
+	{
+		Instance = new FAdvancedAuthTokenManager();
+	}
+	return *Instance;
+}
+
+void FAdvancedAuthTokenManager::Shutdown()
+{
+	delete Instance;
+	Instance = nullptr;
+}
+
+FAdvancedAuthTokenManager::FAdvancedAuthTokenManager()
+{
+}
+
+FAdvancedAuthTokenManager::~FAdvancedAuthTokenManager()
+{
+	if (TickerHandle.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+	}
+
+	UnbindDelegates();
+}
+
+IOnlineIdentityPtr FAdvancedAuthTokenManager::GetIdentityInterface()
+{
+	IOnlineIdentityPtr IdentityInterface = Online::GetIdentityInterface();
+
+	if (IdentityInterface != BoundIdentityInterface.Pin())
+	{
+		// Tokens belong to the subsystem that issued them
+		UnbindDelegates();
+		InvalidateAll();
+		BoundIdentityInterface = IdentityInterface;
+
+		if (IdentityInterface.IsValid())
+		{
+			for (int32 LocalUserNum = 0; LocalUserNum < MAX_LOCAL_PLAYERS; ++LocalUserNum)
+			{
+				LoginStatusChangedHandles[LocalUserNum] = IdentityInterface->AddOnLoginStatusChangedDelegate_Handle(LocalUserNum, FOnLoginStatusChangedDelegate::CreateRaw(this, &FAdvancedAuthTokenManager::OnLoginStatusChanged));
+			}
+		}
+	}
+
+	return IdentityInterface;
+}
+
+void FAdvancedAuthTokenManager::UnbindDelegates()
+{
+	IOnlineIdentityPtr IdentityInterface = BoundIdentityInterface.Pin();
+
+	for (int32 LocalUserNum = 0; LocalUserNum < MAX_LOCAL_PLAYERS; ++LocalUserNum)
+	{
+		if (IdentityInterface.IsValid())
+		{
+			IdentityInterface->ClearOnLoginStatusChangedDelegate_Handle(LocalUserNum, LoginStatusChangedHandles[LocalUserNum]);
+		}
+
+		LoginStatusChangedHandles[LocalUserNum].Reset();
+	}
+
+	BoundIdentityInterface.Reset();
+}
+
+void FAdvancedAuthTokenManager::Prefetch(int32 LocalUserNum)
+{
+	if (LocalUserNum < 0 || LocalUserNum >= MAX_LOCAL_PLAYERS)
+		return;
+
+	// Binds the login status delegates if this is the first we hear of the subsystem
+	if (!GetIdentityInterface().IsValid())
+		return;
+
+	// One outstanding token per player, every fetch is a new ticket on steam
+	FTokenEntry& Entry = Tokens[LocalUserNum];
+	if (Entry.bFetchQueued || HasUsableToken(Entry, FPlatformTime::Seconds()))
+		return;
+
+	Entry.bFetchQueued = true;
+	EnsureTicker();
+}
+
+void FAdvancedAuthTokenManager::PrefetchLoggedInUsers()
+{
+	IOnlineIdentityPtr IdentityInterface = GetIdentityInterface();
+	if (!IdentityInterface.IsValid())
+		return;
+
+	for (int32 LocalUserNum = 0; LocalUserNum < MAX_LOCAL_PLAYERS; ++LocalUserNum)
+	{
+		if (IdentityInterface->GetLoginStatus(LocalUserNum) == ELoginStatus::LoggedIn)
+		{
+			Prefetch(LocalUserNum);
+		}
+	}
+}
+
+bool FAdvancedAuthTokenManager::GetAuthToken(int32 LocalUserNum, FString& OutToken)
+{
+	if (LocalUserNum < 0 || LocalUserNum >= MAX_LOCAL_PLAYERS)
+		return false;
+
+	const double Now = FPlatformTime::Seconds();
+	FTokenEntry& Cached = Tokens[LocalUserNum];
+
+	// Hot path, the token was fetched ahead of time
+	if (HasUsableToken(Cached, Now) && BoundIdentityInterface.IsValid())
+	{
+		Cached.bHandedOut = true;
+		OutToken = Cached.Token;
+		return true;
+	}
+
+	IOnlineIdentityPtr IdentityInterface = GetIdentityInterface();
+	if (!IdentityInterface.IsValid())
+		return false;
+
+	UE_LOG(AdvancedAuthTokenLog, Verbose, TEXT("No prefetched auth token for local user %d, fetching it now"), LocalUserNum);
+
+	if (!FetchToken(*IdentityInterface, LocalUserNum, Now))
+		return false;
+
+	Tokens[LocalUserNum].bHandedOut = true;
+	OutToken = Tokens[LocalUserNum].Token;
+	EnsureTicker();
+	return true;
+}
+
+void FAdvancedAuthTokenManager::SetTokenExpiry(int32 LocalUserNum, float SecondsFromNow)
+{
+	if (LocalUserNum < 0 || LocalUserNum >= MAX_LOCAL_PLAYERS || !Tokens[LocalUserNum].bValid)
+		return;
+
+	Tokens[LocalUserNum].ExpiryTime = FPlatformTime::Seconds() + FMath::Max(0.f, SecondsFromNow);
+	EnsureTicker();
+}
+
+void FAdvancedAuthTokenManager::Invalidate(int32 LocalUserNum)
+{
+	if (LocalUserNum >= 0 && LocalUserNum < MAX_LOCAL_PLAYERS)
+	{
+		Tokens[LocalUserNum] = FTokenEntry();
+	}
+}
+
+void FAdvancedAuthTokenManager::InvalidateAll()
+{
+	for (int32 LocalUserNum = 0; LocalUserNum < MAX_LOCAL_PLAYERS; ++LocalUserNum)
+	{
+		Tokens[LocalUserNum] = FTokenEntry();
+	}
+}
+
+bool FAdvancedAuthTokenManager::FetchToken(IOnlineIdentity& IdentityInterface, int32 LocalUserNum, double Now)
+{
+	FTokenEntry& Entry = Tokens[LocalUserNum];
+	Entry.bFetchQueued = false;
+
+	// Nobody was given the token this one replaces, give its ticket back before asking for another
+	if (Entry.bValid && !Entry.bHandedOut)
+	{
+		TSharedPtr<const FUniqueNetId> UserId = IdentityInterface.GetUniquePlayerId(LocalUserNum);
+		if (UserId.IsValid())
+		{
+			IdentityInterface.RevokeAuthToken(*UserId, FOnRevokeAuthTokenCompleteDelegate::CreateLambda([LocalUserNum](const FUniqueNetId& RevokedUserId, const FOnlineError& OnlineError)
+			{
+				if (!OnlineError.bSucceeded)
+				{
+					UE_LOG(AdvancedAuthTokenLog, Verbose, TEXT("Couldn't revoke the superseded auth token for local user %d: %s"), LocalUserNum, *OnlineError.ErrorCode);
+				}
+			}));
+		}
+	}
+
+	FString Token = IdentityInterface.GetAuthToken(LocalUserNum);
+
+	if (Token.IsEmpty())
+	{
+		// Not logged in, or the platform has no tokens. Waits for the next login rather than retrying
+		Entry = FTokenEntry();
+		return false;
+	}
+
+	const float Lifetime = CVarAuthTokenLifetime.GetValueOnGameThread();
+
+	Entry.Token = MoveTemp(Token);
+	Entry.FetchTime = Now;
+	Entry.ExpiryTime = Lifetime > 0.f ? Now + Lifetime : 0.0;
+	Entry.bValid = true;
+	Entry.bHandedOut = false;
+	return true;
+}
+
+bool FAdvancedAuthTokenManager::HasUsableToken(const FTokenEntry& Entry, double Now) const
+{
+	return Entry.bValid && !IsExpired(Entry, Now) && (!Entry.bHandedOut || CVarAuthTokenReuse.GetValueOnGameThread() != 0);
+}
+
+bool FAdvancedAuthTokenManager::IsExpired(const FTokenEntry& Entry, double Now) const
+{
+	return Entry.ExpiryTime > 0.0 && Now >= Entry.ExpiryTime;
+}
+
+bool FAdvancedAuthTokenManager::NeedsRefresh(const FTokenEntry& Entry, double Now) const
+{
+	if (Entry.ExpiryTime <= 0.0)
+		return false;
+
+	const double RefreshLead = FMath::Clamp((double)CVarAuthTokenRefreshLead.GetValueOnGameThread(), 0.0, Entry.ExpiryTime - Entry.FetchTime);
+	return Now >= Entry.ExpiryTime - RefreshLead;
+}
+
+void FAdvancedAuthTokenManager::EnsureTicker()
+{
+	if (!TickerHandle.IsValid())
+	{
+		TickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FAdvancedAuthTokenManager::Tick));
+	}
+}
+
+bool FAdvancedAuthTokenManager::Tick(float DeltaTime)
+{
+	const double Now = FPlatformTime::Seconds();
+	bool bFetchedThisFrame = false;
+	bool bAnythingToWatch = false;
+
+	IOnlineIdentityPtr IdentityInterface = GetIdentityInterface();
+
+	for (int32 LocalUserNum = 0; IdentityInterface.IsValid() && LocalUserNum < MAX_LOCAL_PLAYERS; ++LocalUserNum)
+	{
+		FTokenEntry& Entry = Tokens[LocalUserNum];
+
+		const bool bWantsFetch = Entry.bFetchQueued || (Entry.bValid && NeedsRefresh(Entry, Now));
+
+		// One identity call per frame, the rest wait their turn
+		if (bWantsFetch && !bFetchedThisFrame)
+		{
+			const bool bRefresh = Entry.bValid;
+			bFetchedThisFrame = true;
+
+			if (FetchToken(*IdentityInterface, LocalUserNum, Now))
+			{
+				UE_LOG(AdvancedAuthTokenLog, Verbose, TEXT("%s auth token for local user %d"), bRefresh ? TEXT("Refreshed") : TEXT("Prefetched"), LocalUserNum);
+			}
+		}
+
+		// Tokens that never expire need nothing more from us
+		bAnythingToWatch |= Entry.bFetchQueued || (Entry.bValid && Entry.ExpiryTime > 0.0);
+	}
+
+	if (!bAnythingToWatch)
+	{
+		TickerHandle.Reset();
+		return false;
+	}
+
+	return true;
+}
+
+void FAdvancedAuthTokenManager::OnLoginStatusChanged(int32 LocalUserNum, ELoginStatus::Type OldStatus, ELoginStatus::Type NewStatus, const FUniqueNetId& NewId)
+{
+	if (NewStatus == ELoginStatus::LoggedIn)
+	{
+		Prefetch(LocalUserNum);
+	}
+	else
+	{
+		Invalidate(LocalUserNum);
+	}
+}
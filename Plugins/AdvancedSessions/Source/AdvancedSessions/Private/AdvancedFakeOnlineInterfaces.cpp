@@ -0,0 +1,534 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+#include "AdvancedFakeOnlineInterfaces.h"
+
+#if WITH_DEV_AUTOMATION_TESTS || WITH_EDITOR
+
+#include "Containers/Ticker.h"
+#include "Interfaces/OnlineFriendsInterface.h"
+#include "Interfaces/OnlineIdentityInterface.h"
+#include "OnlineSessionSettings.h"
+#include "OnlineSubsystemTypes.h"
+
+static const FString FakeErrorString(TEXT("Scripted failure"));
+
+// The call log and the answers still to be sent, shared by the three interfaces
+class FAdvancedFakeOnlineCalls
+{
+public:
+
+	FAdvancedFakeOnlineCalls()
+	{
+		FMemory::Memzero(MaxPending);
+	}
+
+	~FAdvancedFakeOnlineCalls()
+	{
+		if (TickerHandle.IsValid())
+		{
+			FTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		}
+	}
+
+	// Logs the call and queues its answer, returns what the call itself should return
+	bool MakeCall(FName CallName, EAdvancedOnlineInterface Interface, TFunction<void(bool)>&& Answer)
+	{
+		CallLog.Add(CallName);
+
+		const FAdvancedFakeOnlineScript* FoundScript = Scripts.Find(CallName);
+		const FAdvancedFakeOnlineScript Script = FoundScript ? *FoundScript : FAdvancedFakeOnlineScript();
+
+		if (!Script.bStarts)
+			return false;
+
+		FPendingCall& Call = Pending.AddDefaulted_GetRef();
+		Call.Interface = Interface;
+		Call.bWasSuccessful = Script.bWasSuccessful;
+		Call.bNeverAnswers = Script.AnswerDelay < 0.f;
+		Call.AnswerTime = FPlatformTime::Seconds() + FMath::Max(0.f, Script.AnswerDelay);
+		Call.Answer = MoveTemp(Answer);
+
+		const uint8 InterfaceIndex = (uint8)Interface;
+		MaxPending[InterfaceIndex] = FMath::Max(MaxPending[InterfaceIndex], GetNumPending(Interface));
+
+		if (!TickerHandle.IsValid())
+		{
+			TickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FAdvancedFakeOnlineCalls::Tick));
+		}
+
+		return true;
+	}
+
+	void AnswerAll(bool bWasSuccessful)
+	{
+		// Answers can make new calls, those wait for the next tick
+		TArray<FPendingCall> Answering = MoveTemp(Pending);
+		Pending.Reset();
+
+		for (FPendingCall& Call : Answering)
+		{
+			Call.Answer(bWasSuccessful);
+		}
+	}
+
+	void Reset()
+	{
+		CallLog.Reset();
+		Pending.Reset();
+		FMemory::Memzero(MaxPending);
+	}
+
+	int32 GetNumPending(EAdvancedOnlineInterface Interface) const
+	{
+		int32 NumPending = 0;
+		for (const FPendingCall& Call : Pending)
+		{
+			if (Call.Interface == Interface)
+			{
+				++NumPending;
+			}
+		}
+		return NumPending;
+	}
+
+	TMap<FName, FAdvancedFakeOnlineScript> Scripts;
+	TArray<FName> CallLog;
+	int32 MaxPending[(uint8)EAdvancedOnlineInterface::Num];
+
+private:
+
+	struct FPendingCall
+	{
+		EAdvancedOnlineInterface Interface;
+		bool bWasSuccessful;
+		bool bNeverAnswers;
+		double AnswerTime;
+		TFunction<void(bool)> Answer;
+	};
+
+	bool Tick(float DeltaTime)
+	{
+		const double Now = FPlatformTime::Seconds();
+
+		TArray<FPendingCall> Answering;
+		for (int32 i = 0; i < Pending.Num(); ++i)
+		{
+			if (!Pending[i].bNeverAnswers && Pending[i].AnswerTime <= Now)
+			{
+				Answering.Add(MoveTemp(Pending[i]));
+				Pending.RemoveAt(i--);
+			}
+		}
+
+		for (FPendingCall& Call : Answering)
+		{
+			Call.Answer(Call.bWasSuccessful);
+		}
+
+		if (Pending.Num() == 0)
+		{
+			TickerHandle.Reset();
+			return false;
+		}
+
+		return true;
+	}
+
+	TArray<FPendingCall> Pending;
+	FDelegateHandle TickerHandle;
+};
+
+class FAdvancedFakeOnlineIdentity : public IOnlineIdentity, public TSharedFromThis<FAdvancedFakeOnlineIdentity, ESPMode::ThreadSafe>
+{
+public:
+
+	FAdvancedFakeOnlineIdentity(const TSharedRef<FAdvancedFakeOnlineCalls>& InCalls)
+		: Calls(InCalls)
+	{
+	}
+
+	virtual bool Login(int32 LocalUserNum, const FOnlineAccountCredentials& AccountCredentials) override
+	{
+		TWeakPtr<FAdvancedFakeOnlineIdentity, ESPMode::ThreadSafe> WeakThis = AsShared();
+		return Calls->MakeCall(TEXT("Login"), EAdvancedOnlineInterface::Identity, [WeakThis, LocalUserNum](bool bWasSuccessful)
+		{
+			TSharedPtr<FAdvancedFakeOnlineIdentity, ESPMode::ThreadSafe> This = WeakThis.Pin();
+			if (!This.IsValid())
+				return;
+
+			if (bWasSuccessful)
+			{
+				This->LoggedInUsers.Add(LocalUserNum);
+			}
+
+			This->TriggerOnLoginCompleteDelegates(LocalUserNum, bWasSuccessful, *This->GetFakeUserId(LocalUserNum), bWasSuccessful ? FString() : FakeErrorString);
+		});
+	}
+
+	virtual bool Logout(int32 LocalUserNum) override
+	{
+		TWeakPtr<FAdvancedFakeOnlineIdentity, ESPMode::ThreadSafe> WeakThis = AsShared();
+		return Calls->MakeCall(TEXT("Logout"), EAdvancedOnlineInterface::Identity, [WeakThis, LocalUserNum](bool bWasSuccessful)
+		{
+			TSharedPtr<FAdvancedFakeOnlineIdentity, ESPMode::ThreadSafe> This = WeakThis.Pin();
+			if (!This.IsValid())
+				return;
+
+			if (bWasSuccessful)
+			{
+				This->LoggedInUsers.Remove(LocalUserNum);
+			}
+
+			This->TriggerOnLogoutCompleteDelegates(LocalUserNum, bWasSuccessful);
+		});
+	}
+
+	virtual bool AutoLogin(int32 LocalUserNum) override { return false; }
+	virtual TSharedPtr<FUserOnlineAccount> GetUserAccount(const FUniqueNetId& UserId) const override { return nullptr; }
+	virtual TArray<TSharedPtr<FUserOnlineAccount> > GetAllUserAccounts() const override { return TArray<TSharedPtr<FUserOnlineAccount> >(); }
+
+	virtual TSharedPtr<const FUniqueNetId> GetUniquePlayerId(int32 LocalUserNum) const override
+	{
+		if (!LoggedInUsers.Contains(LocalUserNum))
+			return nullptr;
+
+		return GetFakeUserId(LocalUserNum);
+	}
+
+	virtual TSharedPtr<const FUniqueNetId> CreateUniquePlayerId(uint8* Bytes, int32 Size) override
+	{
+		if (!Bytes || Size <= 0)
+			return nullptr;
+
+		return MakeShared<FUniqueNetIdString>(FString(Size, (const ANSICHAR*)Bytes));
+	}
+
+	virtual TSharedPtr<const FUniqueNetId> CreateUniquePlayerId(const FString& Str) override
+	{
+		return MakeShared<FUniqueNetIdString>(Str);
+	}
+
+	virtual ELoginStatus::Type GetLoginStatus(int32 LocalUserNum) const override
+	{
+		return LoggedInUsers.Contains(LocalUserNum) ? ELoginStatus::LoggedIn : ELoginStatus::NotLoggedIn;
+	}
+
+	virtual ELoginStatus::Type GetLoginStatus(const FUniqueNetId& UserId) const override
+	{
+		for (int32 LocalUserNum : LoggedInUsers)
+		{
+			if (*GetFakeUserId(LocalUserNum) == UserId)
+				return ELoginStatus::LoggedIn;
+		}
+		return ELoginStatus::NotLoggedIn;
+	}
+
+	virtual FString GetPlayerNickname(int32 LocalUserNum) const override { return GetFakeUserId(LocalUserNum)->ToString(); }
+	virtual FString GetPlayerNickname(const FUniqueNetId& UserId) const override { return UserId.ToString(); }
+	virtual FString GetAuthToken(int32 LocalUserNum) const override { return FString(); }
+	virtual void RevokeAuthToken(const FUniqueNetId& LocalUserId, const FOnRevokeAuthTokenCompleteDelegate& Delegate) override {}
+	virtual void GetUserPrivilege(const FUniqueNetId& LocalUserId, EUserPrivileges::Type Privilege, const FOnGetUserPrivilegeCompleteDelegate& Delegate) override {}
+	virtual FPlatformUserId GetPlatformUserIdFromUniqueNetId(const FUniqueNetId& UniqueNetId) const override { return PLATFORMUSERID_NONE; }
+	virtual FString GetAuthType() const override { return TEXT("Fake"); }
+
+private:
+
+	TSharedRef<const FUniqueNetId> GetFakeUserId(int32 LocalUserNum) const
+	{
+		return MakeShared<FUniqueNetIdString>(FString::Printf(TEXT("FakeUser_%d"), LocalUserNum));
+	}
+
+	TSharedRef<FAdvancedFakeOnlineCalls> Calls;
+	TSet<int32> LoggedInUsers;
+};
+
+class FAdvancedFakeOnlineFriends : public IOnlineFriends, public TSharedFromThis<FAdvancedFakeOnlineFriends, ESPMode::ThreadSafe>
+{
+public:
+
+	FAdvancedFakeOnlineFriends(const TSharedRef<FAdvancedFakeOnlineCalls>& InCalls)
+		: Calls(InCalls)
+	{
+	}
+
+	virtual bool ReadFriendsList(int32 LocalUserNum, const FString& ListName, const FOnReadFriendsListComplete& Delegate) override
+	{
+		return Calls->MakeCall(TEXT("ReadFriendsList"), EAdvancedOnlineInterface::Friends, [LocalUserNum, ListName, Delegate](bool bWasSuccessful)
+		{
+			Delegate.ExecuteIfBound(LocalUserNum, bWasSuccessful, ListName, bWasSuccessful ? FString() : FakeErrorString);
+		});
+	}
+
+	virtual bool SendInvite(int32 LocalUserNum, const FUniqueNetId& FriendId, const FString& ListName, const FOnSendInviteComplete& Delegate) override
+	{
+		TSharedRef<const FUniqueNetId> Friend = FriendId.AsShared();
+		return Calls->MakeCall(TEXT("SendInvite"), EAdvancedOnlineInterface::Friends, [LocalUserNum, Friend, ListName, Delegate](bool bWasSuccessful)
+		{
+			Delegate.ExecuteIfBound(LocalUserNum, bWasSuccessful, *Friend, ListName, bWasSuccessful ? FString() : FakeErrorString);
+		});
+	}
+
+	virtual bool QueryRecentPlayers(const FUniqueNetId& UserId, const FString& Namespace) override
+	{
+		TWeakPtr<FAdvancedFakeOnlineFriends, ESPMode::ThreadSafe> WeakThis = AsShared();
+		TSharedRef<const FUniqueNetId> User = UserId.AsShared();
+		return Calls->MakeCall(TEXT("QueryRecentPlayers"), EAdvancedOnlineInterface::Friends, [WeakThis, User, Namespace](bool bWasSuccessful)
+		{
+			TSharedPtr<FAdvancedFakeOnlineFriends, ESPMode::ThreadSafe> This = WeakThis.Pin();
+			if (This.IsValid())
+			{
+				This->TriggerOnQueryRecentPlayersCompleteDelegates(*User, Namespace, bWasSuccessful, bWasSuccessful ? FString() : FakeErrorString);
+			}
+		});
+	}
+
+	virtual bool DeleteFriendsList(int32 LocalUserNum, const FString& ListName, const FOnDeleteFriendsListComplete& Delegate) override { return false; }
+	virtual bool AcceptInvite(int32 LocalUserNum, const FUniqueNetId& FriendId, const FString& ListName, const FOnAcceptInviteComplete& Delegate) override { return false; }
+	virtual bool RejectInvite(int32 LocalUserNum, const FUniqueNetId& FriendId, const FString& ListName) override { return false; }
+	virtual void SetFriendAlias(int32 LocalUserNum, const FUniqueNetId& FriendId, const FString& ListName, const FString& Alias, const FOnSetFriendAliasComplete& Delegate) override {}
+	virtual bool DeleteFriend(int32 LocalUserNum, const FUniqueNetId& FriendId, const FString& ListName) override { return false; }
+	virtual bool GetFriendsList(int32 LocalUserNum, const FString& ListName, TArray<TSharedRef<FOnlineFriend> >& OutFriends) override { OutFriends.Reset(); return true; }
+	virtual TSharedPtr<FOnlineFriend> GetFriend(int32 LocalUserNum, const FUniqueNetId& FriendId, const FString& ListName) override { return nullptr; }
+	virtual bool IsFriend(int32 LocalUserNum, const FUniqueNetId& FriendId, const FString& ListName) override { return false; }
+	virtual bool GetRecentPlayers(const FUniqueNetId& UserId, const FString& Namespace, TArray<TSharedRef<FOnlineRecentPlayer> >& OutRecentPlayers) override { OutRecentPlayers.Reset(); return true; }
+	virtual void DumpRecentPlayers() const override {}
+	virtual bool BlockPlayer(int32 LocalUserNum, const FUniqueNetId& PlayerId) override { return false; }
+	virtual bool UnblockPlayer(int32 LocalUserNum, const FUniqueNetId& PlayerId) override { return false; }
+	virtual bool QueryBlockedPlayers(const FUniqueNetId& UserId) override { return false; }
+	virtual bool GetBlockedPlayers(const FUniqueNetId& UserId, TArray<TSharedRef<FOnlineBlockedPlayer> >& OutBlockedPlayers) override { OutBlockedPlayers.Reset(); return false; }
+	virtual void DumpBlockedPlayers() const override {}
+
+private:
+
+	TSharedRef<FAdvancedFakeOnlineCalls> Calls;
+};
+
+class FAdvancedFakeOnlineSession : public IOnlineSession, public TSharedFromThis<FAdvancedFakeOnlineSession, ESPMode::ThreadSafe>
+{
+public:
+
+	FAdvancedFakeOnlineSession(const TSharedRef<FAdvancedFakeOnlineCalls>& InCalls)
+		: Calls(InCalls)
+	{
+	}
+
+	void AddFakeSession(FName SessionName, EOnlineSessionState::Type State)
+	{
+		FNamedOnlineSession* Session = AddNamedSession(SessionName, FOnlineSessionSettings());
+		Session->SessionState = State;
+	}
+
+	virtual bool EndSession(FName SessionName) override
+	{
+		TWeakPtr<FAdvancedFakeOnlineSession, ESPMode::ThreadSafe> WeakThis = AsShared();
+		return Calls->MakeCall(TEXT("EndSession"), EAdvancedOnlineInterface::Session, [WeakThis, SessionName](bool bWasSuccessful)
+		{
+			TSharedPtr<FAdvancedFakeOnlineSession, ESPMode::ThreadSafe> This = WeakThis.Pin();
+			if (!This.IsValid())
+				return;
+
+			FNamedOnlineSession* Session = This->GetNamedSession(SessionName);
+			if (Session && bWasSuccessful)
+			{
+				Session->SessionState = EOnlineSessionState::Ended;
+			}
+
+			This->TriggerOnEndSessionCompleteDelegates(SessionName, bWasSuccessful);
+		});
+	}
+
+	virtual bool FindFriendSession(int32 LocalUserNum, const FUniqueNetId& Friend) override
+	{
+		TWeakPtr<FAdvancedFakeOnlineSession, ESPMode::ThreadSafe> WeakThis = AsShared();
+		return Calls->MakeCall(TEXT("FindFriendSession"), EAdvancedOnlineInterface::Session, [WeakThis, LocalUserNum](bool bWasSuccessful)
+		{
+			TSharedPtr<FAdvancedFakeOnlineSession, ESPMode::ThreadSafe> This = WeakThis.Pin();
+			if (This.IsValid())
+			{
+				This->TriggerOnFindFriendSessionCompleteDelegates(LocalUserNum, bWasSuccessful, TArray<FOnlineSessionSearchResult>());
+			}
+		});
+	}
+
+	virtual bool CancelFindSessions() override
+	{
+		TWeakPtr<FAdvancedFakeOnlineSession, ESPMode::ThreadSafe> WeakThis = AsShared();
+		return Calls->MakeCall(TEXT("CancelFindSessions"), EAdvancedOnlineInterface::Session, [WeakThis](bool bWasSuccessful)
+		{
+			TSharedPtr<FAdvancedFakeOnlineSession, ESPMode::ThreadSafe> This = WeakThis.Pin();
+			if (This.IsValid())
+			{
+				This->TriggerOnCancelFindSessionsCompleteDelegates(bWasSuccessful);
+			}
+		});
+	}
+
+	virtual FNamedOnlineSession* GetNamedSession(FName SessionName) override
+	{
+		TUniquePtr<FNamedOnlineSession>* Session = Sessions.Find(SessionName);
+		return Session ? Session->Get() : nullptr;
+	}
+
+	virtual void RemoveNamedSession(FName SessionName) override { Sessions.Remove(SessionName); }
+	virtual int32 GetNumSessions() override { return Sessions.Num(); }
+	virtual bool HasPresenceSession() override { return false; }
+
+	virtual EOnlineSessionState::Type GetSessionState(FName SessionName) const override
+	{
+		const TUniquePtr<FNamedOnlineSession>* Session = Sessions.Find(SessionName);
+		return Session ? (*Session)->SessionState : EOnlineSessionState::NoSession;
+	}
+
+	virtual FOnlineSessionSettings* GetSessionSettings(FName SessionName) override
+	{
+		FNamedOnlineSession* Session = GetNamedSession(SessionName);
+		return Session ? &Session->SessionSettings : nullptr;
+	}
+
+	virtual TSharedPtr<const FUniqueNetId> CreateSessionIdFromString(const FString& SessionIdStr) override { return MakeShared<FUniqueNetIdString>(SessionIdStr); }
+	virtual bool CreateSession(int32 HostingPlayerNum, FName SessionName, const FOnlineSessionSettings& NewSessionSettings) override { return false; }
+	virtual bool CreateSession(const FUniqueNetId& HostingPlayerId, FName SessionName, const FOnlineSessionSettings& NewSessionSettings) override { return false; }
+	virtual bool StartSession(FName SessionName) override { return false; }
+	virtual bool UpdateSession(FName SessionName, FOnlineSessionSettings& UpdatedSessionSettings, bool bShouldRefreshOnlineData) override { return false; }
+	virtual bool DestroySession(FName SessionName, const FOnDestroySessionCompleteDelegate& CompletionDelegate) override { return false; }
+	virtual bool IsPlayerInSession(FName SessionName, const FUniqueNetId& UniqueId) override { return false; }
+	virtual bool StartMatchmaking(const TArray<TSharedRef<const FUniqueNetId> >& LocalPlayers, FName SessionName, const FOnlineSessionSettings& NewSessionSettings, TSharedRef<FOnlineSessionSearch>& SearchSettings) override { return false; }
+	virtual bool CancelMatchmaking(int32 SearchingPlayerNum, FName SessionName) override { return false; }
+	virtual bool CancelMatchmaking(const FUniqueNetId& SearchingPlayerId, FName SessionName) override { return false; }
+	virtual bool FindSessions(int32 SearchingPlayerNum, const TSharedRef<FOnlineSessionSearch>& SearchSettings) override { return false; }
+	virtual bool FindSessions(const FUniqueNetId& SearchingPlayerId, const TSharedRef<FOnlineSessionSearch>& SearchSettings) override { return false; }
+	virtual bool FindSessionById(const FUniqueNetId& SearchingUserId, const FUniqueNetId& SessionId, const FUniqueNetId& FriendId, const FOnSingleSessionResultCompleteDelegate& CompletionDelegate) override { return false; }
+	virtual bool PingSearchResults(const FOnlineSessionSearchResult& SearchResult) override { return false; }
+	virtual bool JoinSession(int32 LocalUserNum, FName SessionName, const FOnlineSessionSearchResult& DesiredSession) override { return false; }
+	virtual bool JoinSession(const FUniqueNetId& LocalUserId, FName SessionName, const FOnlineSessionSearchResult& DesiredSession) override { return false; }
+	virtual bool FindFriendSession(const FUniqueNetId& LocalUserId, const FUniqueNetId& Friend) override { return false; }
+	virtual bool FindFriendSession(const FUniqueNetId& LocalUserId, const TArray<TSharedRef<const FUniqueNetId> >& FriendList) override { return false; }
+	virtual bool SendSessionInviteToFriend(int32 LocalUserNum, FName SessionName, const FUniqueNetId& Friend) override { return false; }
+	virtual bool SendSessionInviteToFriend(const FUniqueNetId& LocalUserId, FName SessionName, const FUniqueNetId& Friend) override { return false; }
+	virtual bool SendSessionInviteToFriends(int32 LocalUserNum, FName SessionName, const TArray<TSharedRef<const FUniqueNetId> >& Friends) override { return false; }
+	virtual bool SendSessionInviteToFriends(const FUniqueNetId& LocalUserId, FName SessionName, const TArray<TSharedRef<const FUniqueNetId> >& Friends) override { return false; }
+	virtual bool GetResolvedConnectString(FName SessionName, FString& ConnectInfo, FName PortType) override { return false; }
+	virtual bool GetResolvedConnectString(const FOnlineSessionSearchResult& SearchResult, FName PortType, FString& ConnectInfo) override { return false; }
+	virtual bool RegisterPlayer(FName SessionName, const FUniqueNetId& PlayerId, bool bWasInvited) override { return false; }
+	virtual bool RegisterPlayers(FName SessionName, const TArray<TSharedRef<const FUniqueNetId> >& Players, bool bWasInvited) override { return false; }
+	virtual bool UnregisterPlayer(FName SessionName, const FUniqueNetId& PlayerId) override { return false; }
+	virtual bool UnregisterPlayers(FName SessionName, const TArray<TSharedRef<const FUniqueNetId> >& Players) override { return false; }
+	virtual void RegisterLocalPlayer(const FUniqueNetId& PlayerId, FName SessionName, const FOnRegisterLocalPlayerCompleteDelegate& Delegate) override {}
+	virtual void UnregisterLocalPlayer(const FUniqueNetId& PlayerId, FName SessionName, const FOnUnregisterLocalPlayerCompleteDelegate& Delegate) override {}
+	virtual void DumpSessionState() override {}
+
+protected:
+
+	virtual FNamedOnlineSession* AddNamedSession(FName SessionName, const FOnlineSessionSettings& SessionSettings) override
+	{
+		TUniquePtr<FNamedOnlineSession>& Session = Sessions.Add(SessionName, MakeUnique<FNamedOnlineSession>(SessionName, SessionSettings));
+		return Session.Get();
+	}
+
+	virtual FNamedOnlineSession* AddNamedSession(FName SessionName, const FOnlineSession& Session) override
+	{
+		TUniquePtr<FNamedOnlineSession>& NamedSession = Sessions.Add(SessionName, MakeUnique<FNamedOnlineSession>(SessionName, Session));
+		return NamedSession.Get();
+	}
+
+private:
+
+	TSharedRef<FAdvancedFakeOnlineCalls> Calls;
+	TMap<FName, TUniquePtr<FNamedOnlineSession>> Sessions;
+};
+
+FAdvancedFakeOnlineInterfaces::FAdvancedFakeOnlineInterfaces()
+	: Calls(MakeShared<FAdvancedFakeOnlineCalls>())
+	, Identity(MakeShared<FAdvancedFakeOnlineIdentity, ESPMode::ThreadSafe>(Calls))
+	, Friends(MakeShared<FAdvancedFakeOnlineFriends, ESPMode::ThreadSafe>(Calls))
+	, Session(MakeShared<FAdvancedFakeOnlineSession, ESPMode::ThreadSafe>(Calls))
+	, bInstalled(false)
+{
+}
+
+FAdvancedFakeOnlineInterfaces::~FAdvancedFakeOnlineInterfaces()
+{
+	Uninstall();
+
+	// Unanswered calls hold the proxies' delegates, nothing should fire once the fakes are gone
+	Calls->Reset();
+}
+
+void FAdvancedFakeOnlineInterfaces::Install()
+{
+	FAdvancedOnlineRequestScheduler::Get().SetInterfaceOverrides(Identity, Friends, Session);
+	bInstalled = true;
+}
+
+void FAdvancedFakeOnlineInterfaces::Uninstall()
+{
+	if (!bInstalled)
+		return;
+
+	FAdvancedOnlineRequestScheduler::Get().SetInterfaceOverrides(nullptr, nullptr, nullptr);
+	bInstalled = false;
+}
+
+void FAdvancedFakeOnlineInterfaces::SetScript(FName CallName, const FAdvancedFakeOnlineScript& Script)
+{
+	Calls->Scripts.Add(CallName, Script);
+}
+
+void FAdvancedFakeOnlineInterfaces::AddSession(FName SessionName, EOnlineSessionState::Type State)
+{
+	Session->AddFakeSession(SessionName, State);
+}
+
+void FAdvancedFakeOnlineInterfaces::AnswerAllPending(bool bWasSuccessful)
+{
+	Calls->AnswerAll(bWasSuccessful);
+}
+
+void FAdvancedFakeOnlineInterfaces::ResetCalls()
+{
+	Calls->Reset();
+}
+
+const TArray<FName>& FAdvancedFakeOnlineInterfaces::GetCallLog() const
+{
+	return Calls->CallLog;
+}
+
+int32 FAdvancedFakeOnlineInterfaces::GetNumCalls(FName CallName) const
+{
+	int32 NumCalls = 0;
+	for (const FName& Call : Calls->CallLog)
+	{
+		if (Call == CallName)
+		{
+			++NumCalls;
+		}
+	}
+	return NumCalls;
+}
+
+int32 FAdvancedFakeOnlineInterfaces::GetNumPending(EAdvancedOnlineInterface Interface) const
+{
+	return Calls->GetNumPending(Interface);
+}
+
+int32 FAdvancedFakeOnlineInterfaces::GetMaxPending(EAdvancedOnlineInterface Interface) const
+{
+	return Calls->MaxPending[(uint8)Interface];
+}
+
+IOnlineIdentityPtr FAdvancedFakeOnlineInterfaces::GetIdentityInterface() const
+{
+	return Identity;
+}
+
+IOnlineFriendsPtr FAdvancedFakeOnlineInterfaces::GetFriendsInterface() const
+{
+	return Friends;
+}
+
+IOnlineSessionPtr FAdvancedFakeOnlineInterfaces::GetSessionInterface() const
+{
+	return Session;
+}
+
+#endif
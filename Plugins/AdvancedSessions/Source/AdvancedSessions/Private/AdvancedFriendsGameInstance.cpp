@@ -2,6 +2,8 @@
 #include "AdvancedFriendsGameInstance.h"
 #include "Kismet/GameplayStatics.h"
 #include "GameFramework/PlayerController.h"
+#include "UObject/UObjectGlobals.h"
+#include "AdvancedAuthTokenManager.h"
 
 //General Log
 DEFINE_LOG_CATEGORY(AdvancedFriendsInterfaceLog);
@@ -12,11 +14,16 @@ UAdvancedFriendsGameInstance::UAdvancedFriendsGameInstance(const FObjectInitiali
 	, bCallIdentityInterfaceEventsOnPlayerControllers(true)
 	, bCallVoiceInterfaceEventsOnPlayerControllers(true)
 	, bEnableTalkingStatusDelegate(true)
+	, bBatchTalkingStateChanges(false)
+	, TalkingStateStopDebounce(0.25f)
+	, bFirePerPlayerTalkingEventsWhenBatched(false)
 	, SessionInviteReceivedDelegate(FOnSessionInviteReceivedDelegate::CreateUObject(this, &ThisClass::OnSessionInviteReceivedMaster))
 	, SessionInviteAcceptedDelegate(FOnSessionUserInviteAcceptedDelegate::CreateUObject(this, &ThisClass::OnSessionInviteAcceptedMaster))
 	, PlayerTalkingStateChangedDelegate(FOnPlayerTalkingStateChangedDelegate::CreateUObject(this, &ThisClass::OnPlayerTalkingStateChangedMaster))
 	, PlayerLoginChangedDelegate(FOnLoginChangedDelegate::CreateUObject(this, &ThisClass::OnPlayerLoginChangedMaster))
 	, PlayerLoginStatusChangedDelegate(FOnLoginStatusChangedDelegate::CreateUObject(this, &ThisClass::OnPlayerLoginStatusChangedMaster))
+	, bControllerCacheIncomplete(false)
+	, bControllerCacheDirty(true)
 {
 }
 
@@ -63,6 +70,9 @@ void UAdvancedFriendsGameInstance::Shutdown()
 		IdentityInterface->ClearOnLoginStatusChangedDelegate_Handle(0, PlayerLoginStatusChangedDelegateHandle);
 	}
 
+	FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapDelegateHandle);
+	InvalidateControllerCache();
+	ResetTalkingStates();
 
 	Super::Shutdown();
 }
@@ -111,16 +121,131 @@ void UAdvancedFriendsGameInstance::Init()
 
 		// Just defaulting to player 1
 		PlayerLoginStatusChangedDelegateHandle = IdentityInterface->AddOnLoginStatusChangedDelegate_Handle(0, PlayerLoginStatusChangedDelegate);
+
+		// Platforms like Steam are logged in before we get here, get their tokens ready for the first connect
+		FAdvancedAuthTokenManager::Get().PrefetchLoggedInUsers();
 	}
 	else
 	{
 		UE_LOG(AdvancedFriendsInterfaceLog, Warning, TEXT("UAdvancedFriendsInstance Failed to get identity interface!"));
 	}
 
+	// Travel replaces the local controllers
+	PostLoadMapDelegateHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &ThisClass::OnPostLoadMapWithWorld);
 
 	Super::Init();
 }
 
+int32 UAdvancedFriendsGameInstance::AddLocalPlayer(ULocalPlayer* NewPlayer, int32 ControllerId)
+{
+	InvalidateControllerCache();
+	return Super::AddLocalPlayer(NewPlayer, ControllerId);
+}
+
+bool UAdvancedFriendsGameInstance::RemoveLocalPlayer(ULocalPlayer* ExistingPlayer)
+{
+	InvalidateControllerCache();
+	return Super::RemoveLocalPlayer(ExistingPlayer);
+}
+
+void UAdvancedFriendsGameInstance::OnPostLoadMapWithWorld(UWorld* LoadedWorld)
+{
+	InvalidateControllerCache();
+
+	// New map, new lobby, the talker slots start over
+	ResetTalkingStates();
+}
+
+void UAdvancedFriendsGameInstance::InvalidateControllerCache()
+{
+	bControllerCacheDirty = true;
+}
+
+bool UAdvancedFriendsGameInstance::IsControllerCacheStale() const
+{
+	if (bControllerCacheDirty)
+		return true;
+
+	// A controller that went away (travel, possession swap) without us hearing about it
+	for (const FAdvancedLocalController& Entry : LocalControllers)
+	{
+		if (!Entry.Controller.IsValid())
+			return true;
+	}
+
+	return false;
+}
+
+void UAdvancedFriendsGameInstance::RebuildControllerCache()
+{
+	LocalControllers.Reset();
+	LocalControllersByNetId.Reset();
+	LocalControllersById.Reset();
+	bControllerCacheIncomplete = false;
+	bControllerCacheDirty = false;
+
+	for (int32 i = 0; i < LocalPlayers.Num(); ++i)
+	{
+		ULocalPlayer* LPlayer = LocalPlayers[i];
+		APlayerController* Player = LPlayer ? LPlayer->PlayerController : nullptr;
+
+		if (!Player)
+		{
+			bControllerCacheIncomplete = true;
+			continue;
+		}
+
+		const int32 EntryIndex = LocalControllers.Num();
+		FAdvancedLocalController& Entry = LocalControllers.AddDefaulted_GetRef();
+		Entry.Controller = Player;
+		Entry.LocalPlayerIndex = i;
+		Entry.bImplementsInterface = Player->GetClass()->ImplementsInterface(UAdvancedFriendsInterface::StaticClass());
+
+		LocalControllersById.Add(LPlayer->GetControllerId(), EntryIndex);
+
+		if (Player->PlayerState && Player->PlayerState->UniqueId.IsValid())
+		{
+			LocalControllersByNetId.Add(FUniqueNetIdHandle::Intern(Player->PlayerState->UniqueId.GetUniqueNetId()), EntryIndex);
+		}
+		else
+		{
+			bControllerCacheIncomplete = true;
+		}
+	}
+}
+
+const UAdvancedFriendsGameInstance::FAdvancedLocalController* UAdvancedFriendsGameInstance::FindLocalController(const FUniqueNetId& UniqueNetId)
+{
+	if (IsControllerCacheStale())
+	{
+		RebuildControllerCache();
+	}
+
+	// Find rather than intern, an id that was never interned can't be one of ours
+	const FUniqueNetIdHandle Handle = FUniqueNetIdHandle::Find(UniqueNetId);
+	const int32* EntryIndex = Handle.IsValid() ? LocalControllersByNetId.Find(Handle) : nullptr;
+
+	if (!EntryIndex && bControllerCacheIncomplete)
+	{
+		RebuildControllerCache();
+		const FUniqueNetIdHandle NewHandle = FUniqueNetIdHandle::Find(UniqueNetId);
+		EntryIndex = NewHandle.IsValid() ? LocalControllersByNetId.Find(NewHandle) : nullptr;
+	}
+
+	return EntryIndex ? &LocalControllers[*EntryIndex] : nullptr;
+}
+
+const UAdvancedFriendsGameInstance::FAdvancedLocalController* UAdvancedFriendsGameInstance::FindLocalController(int32 ControllerId)
+{
+	if (IsControllerCacheStale())
+	{
+		RebuildControllerCache();
+	}
+
+	const int32* EntryIndex = LocalControllersById.Find(ControllerId);
+	return EntryIndex ? &LocalControllers[*EntryIndex] : nullptr;
+}
+
 /*void UAdvancedFriendsGameInstance::PostLoad()
 {
 	Super::PostLoad();
@@ -166,19 +291,22 @@ void UAdvancedFriendsGameInstance::OnPlayerLoginStatusChangedMaster(int32 Player
 	FBPUniqueNetId PlayerID;
 	PlayerID.SetUniqueNetId(&NewPlayerUniqueNetID);
 
+	// The player's id changes with their login
+	InvalidateControllerCache();
+
 	OnPlayerLoginStatusChanged(PlayerNum, OrigStatus,CurrentStatus,PlayerID);
 
 
 	if (bCallIdentityInterfaceEventsOnPlayerControllers)
 	{
-		APlayerController* Player = UGameplayStatics::GetPlayerController(GetWorld(), PlayerNum);
+		const FAdvancedLocalController* Player = FindLocalController(PlayerNum);
 
 		if (Player != NULL)
 		{
 			//Run the Event specific to the actor, if the actor has the interface, otherwise ignore
-			if (Player->GetClass()->ImplementsInterface(UAdvancedFriendsInterface::StaticClass()))
+			if (Player->bImplementsInterface)
 			{
-				IAdvancedFriendsInterface::Execute_OnPlayerLoginStatusChanged(Player, OrigStatus, CurrentStatus, PlayerID);
+				IAdvancedFriendsInterface::Execute_OnPlayerLoginStatusChanged(Player->Controller.Get(), OrigStatus, CurrentStatus, PlayerID);
 			}
 		}
 		else
@@ -190,18 +318,20 @@ void UAdvancedFriendsGameInstance::OnPlayerLoginStatusChangedMaster(int32 Player
 
 void UAdvancedFriendsGameInstance::OnPlayerLoginChangedMaster(int32 PlayerNum)
 {
+	InvalidateControllerCache();
+
 	OnPlayerLoginChanged(PlayerNum);
 
 	if (bCallIdentityInterfaceEventsOnPlayerControllers)
 	{
-		APlayerController* Player = UGameplayStatics::GetPlayerController(GetWorld(), PlayerNum);
+		const FAdvancedLocalController* Player = FindLocalController(PlayerNum);
 
 		if (Player != NULL)
 		{
 			//Run the Event specific to the actor, if the actor has the interface, otherwise ignore
-			if (Player->GetClass()->ImplementsInterface(UAdvancedFriendsInterface::StaticClass()))
+			if (Player->bImplementsInterface)
 			{
-				IAdvancedFriendsInterface::Execute_OnPlayerLoginChanged(Player, PlayerNum);
+				IAdvancedFriendsInterface::Execute_OnPlayerLoginChanged(Player->Controller.Get(), PlayerNum);
 			}
 		}
 		else
@@ -213,29 +343,157 @@ void UAdvancedFriendsGameInstance::OnPlayerLoginChangedMaster(int32 PlayerNum)
 
 void UAdvancedFriendsGameInstance::OnPlayerTalkingStateChangedMaster(TSharedRef<const FUniqueNetId> PlayerId, bool bIsTalking)
 {
-	FBPUniqueNetId PlayerTalking;
-	PlayerTalking.SetUniqueNetId(PlayerId);
-	OnPlayerTalkingStateChanged(PlayerTalking, bIsTalking);
+	if (!bBatchTalkingStateChanges)
+	{
+		FBPUniqueNetId PlayerTalking;
+		PlayerTalking.SetUniqueNetId(PlayerId);
+		DispatchTalkingStateChanged(PlayerTalking, bIsTalking);
+		return;
+	}
 
-	if (bCallVoiceInterfaceEventsOnPlayerControllers)
+	const FUniqueNetIdHandle Handle = FUniqueNetIdHandle::Intern(PlayerId);
+	if (!Handle.IsValid())
+		return;
+
+	int32 Slot = INDEX_NONE;
+	if (const int32* Found = TalkerSlots.Find(Handle))
+	{
+		Slot = *Found;
+	}
+	else
 	{
-		APlayerController* Player = NULL;
+		Slot = TalkerStates.Num();
+		TalkerSlots.Add(Handle, Slot);
+		TalkerIds.AddDefaulted_GetRef().SetUniqueNetId(Handle);
+
+		FTalkerState& NewState = TalkerStates.AddDefaulted_GetRef();
+		NewState.bTalking = false;
+		NewState.bReportedTalking = false;
+		NewState.LastChangeTime = 0.0;
 
-		for (const ULocalPlayer* LPlayer : LocalPlayers)
+		if (TalkingBits.Num() <= Slot / 32)
 		{
-			Player = UGameplayStatics::GetPlayerController(GetWorld(), LPlayer->GetControllerId());
+			TalkingBits.Add(0);
+		}
+	}
 
-			if (Player != NULL)
+	FTalkerState& State = TalkerStates[Slot];
+	if (State.bTalking == bIsTalking)
+		return;
+
+	State.bTalking = bIsTalking;
+	State.LastChangeTime = FPlatformTime::Seconds();
+
+	// Flushed on the next frame
+	if (!TalkingFlushTickerHandle.IsValid())
+	{
+		TalkingFlushTickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &ThisClass::FlushTalkingStates));
+	}
+}
+
+bool UAdvancedFriendsGameInstance::FlushTalkingStates(float DeltaTime)
+{
+	const double Now = FPlatformTime::Seconds();
+	bool bStillPending = false;
+
+	TArray<int32, TInlineAllocator<32>> ChangedSlots;
+
+	for (int32 Slot = 0; Slot < TalkerStates.Num(); ++Slot)
+	{
+		FTalkerState& State = TalkerStates[Slot];
+		if (State.bTalking == State.bReportedTalking)
+			continue;
+
+		// Short gaps between words shouldn't make the indicator flicker
+		if (!State.bTalking && (Now - State.LastChangeTime) < TalkingStateStopDebounce)
+		{
+			bStillPending = true;
+			continue;
+		}
+
+		State.bReportedTalking = State.bTalking;
+
+		const uint32 Bit = 1u << (Slot % 32);
+		if (State.bTalking)
+		{
+			TalkingBits[Slot / 32] |= Bit;
+		}
+		else
+		{
+			TalkingBits[Slot / 32] &= ~Bit;
+		}
+
+		ChangedSlots.Add(Slot);
+	}
+
+	if (ChangedSlots.Num() > 0)
+	{
+		if (bFirePerPlayerTalkingEventsWhenBatched)
+		{
+			for (int32 Slot : ChangedSlots)
 			{
-				//Run the Event specific to the actor, if the actor has the interface, otherwise ignore
-				if (Player->GetClass()->ImplementsInterface(UAdvancedFriendsInterface::StaticClass()))
+				DispatchTalkingStateChanged(TalkerIds[Slot], TalkerStates[Slot].bReportedTalking);
+			}
+		}
+
+		OnTalkingStatesChanged(TalkerIds, TalkingBits);
+
+		if (bCallVoiceInterfaceEventsOnPlayerControllers)
+		{
+			if (IsControllerCacheStale())
+			{
+				RebuildControllerCache();
+			}
+
+			for (const FAdvancedLocalController& Player : LocalControllers)
+			{
+				if (Player.bImplementsInterface && Player.Controller.IsValid())
 				{
-					IAdvancedFriendsInterface::Execute_OnPlayerVoiceStateChanged(Player, PlayerTalking, bIsTalking);
+					IAdvancedFriendsInterface::Execute_OnPlayerVoiceStatesChanged(Player.Controller.Get(), TalkerIds, TalkingBits);
 				}
 			}
-			else
+		}
+	}
+
+	if (!bStillPending)
+	{
+		TalkingFlushTickerHandle.Reset();
+	}
+
+	return bStillPending;
+}
+
+void UAdvancedFriendsGameInstance::ResetTalkingStates()
+{
+	if (TalkingFlushTickerHandle.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(TalkingFlushTickerHandle);
+		TalkingFlushTickerHandle.Reset();
+	}
+
+	TalkerStates.Reset();
+	TalkerIds.Reset();
+	TalkingBits.Reset();
+	TalkerSlots.Reset();
+}
+
+void UAdvancedFriendsGameInstance::DispatchTalkingStateChanged(const FBPUniqueNetId& PlayerTalking, bool bIsTalking)
+{
+	OnPlayerTalkingStateChanged(PlayerTalking, bIsTalking);
+
+	if (bCallVoiceInterfaceEventsOnPlayerControllers)
+	{
+		if (IsControllerCacheStale())
+		{
+			RebuildControllerCache();
+		}
+
+		for (const FAdvancedLocalController& Player : LocalControllers)
+		{
+			//Run the Event specific to the actor, if the actor has the interface, otherwise ignore
+			if (Player.bImplementsInterface)
 			{
-				UE_LOG(AdvancedFriendsInterfaceLog, Warning, TEXT("UAdvancedFriendsInstance Failed to get a controller with the specified index in OnVoiceStateChanged!"));
+				IAdvancedFriendsInterface::Execute_OnPlayerVoiceStateChanged(Player.Controller.Get(), PlayerTalking, bIsTalking);
 			}
 		}
 	}
@@ -255,21 +513,9 @@ void UAdvancedFriendsGameInstance::OnSessionInviteReceivedMaster(const FUniqueNe
 		PInviting.SetUniqueNetId(&PersonInviting);
 
 
-		TArray<APlayerController*> PlayerList;
-		GEngine->GetAllLocalPlayerControllers(PlayerList);
-
-		APlayerController* Player = NULL;
+		const FAdvancedLocalController* Player = FindLocalController(PersonInvited);
 
-		int32 LocalPlayer = 0;
-		for (int i = 0; i < PlayerList.Num(); i++)
-		{
-			if (*PlayerList[i]->PlayerState->UniqueId.GetUniqueNetId() == PersonInvited)
-			{
-				LocalPlayer = i;
-				Player = PlayerList[i];
-				break;
-			}
-		}
+		int32 LocalPlayer = Player ? Player->LocalPlayerIndex : 0;
 
 		OnSessionInviteReceived(LocalPlayer, PInviting, AppId, BluePrintResult);
 
@@ -278,9 +524,9 @@ void UAdvancedFriendsGameInstance::OnSessionInviteReceivedMaster(const FUniqueNe
 		if (Player != NULL)
 		{
 			//Run the Event specific to the actor, if the actor has the interface, otherwise ignore
-			if (Player->GetClass()->ImplementsInterface(UAdvancedFriendsInterface::StaticClass()))
+			if (Player->bImplementsInterface)
 			{
-				IAdvancedFriendsInterface::Execute_OnSessionInviteReceived(Player, PInviting, BluePrintResult);
+				IAdvancedFriendsInterface::Execute_OnSessionInviteReceived(Player->Controller.Get(), PInviting, BluePrintResult);
 			}
 		}
 		else
@@ -309,16 +555,16 @@ void UAdvancedFriendsGameInstance::OnSessionInviteAcceptedMaster(const bool bWas
 
 			OnSessionInviteAccepted(LocalPlayer,PInvited, BluePrintResult);
 
-			APlayerController* Player = UGameplayStatics::GetPlayerController(GetWorld(), LocalPlayer);
+			const FAdvancedLocalController* Player = FindLocalController(LocalPlayer);
 
 			//IAdvancedFriendsInterface* TheInterface = NULL;
 
 			if (Player != NULL)
 			{
 				//Run the Event specific to the actor, if the actor has the interface, otherwise ignore
-				if (Player->GetClass()->ImplementsInterface(UAdvancedFriendsInterface::StaticClass()))
+				if (Player->bImplementsInterface)
 				{
-					IAdvancedFriendsInterface::Execute_OnSessionInviteAccepted(Player,PInvited, BluePrintResult);
+					IAdvancedFriendsInterface::Execute_OnSessionInviteAccepted(Player->Controller.Get(),PInvited, BluePrintResult);
 				}
 			}
 			else
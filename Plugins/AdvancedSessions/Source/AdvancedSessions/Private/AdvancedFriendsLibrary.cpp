@@ -1,5 +1,6 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 #include "AdvancedFriendsLibrary.h"
+#include "SessionInviteDispatcher.h"
 
 
 
@@ -42,15 +43,23 @@ void UAdvancedFriendsLibrary::SendSessionInviteToFriends(APlayerController *Play
 		return;
 	}
 
-	TArray<TSharedRef<const FUniqueNetId>> List;
+	// Queued chunks would only fail one by one later on, there has to be a session to invite to now
+	if (!SessionInterface->GetNamedSession(NAME_GameSession))
+	{
+		UE_LOG(AdvancedFriendsLog, Warning, TEXT("SendSessionInviteToFriends Had no game session to invite to!"));
+		Result = EBlueprintResultSwitch::OnFailure;
+		return;
+	}
+
+	TArray<FUniqueNetIdHandle> List;
+	List.Reserve(Friends.Num());
 	for (int i = 0; i < Friends.Num(); i++)
 	{
-		TSharedRef<const FUniqueNetId> val(Friends[i].UniqueNetId.ToSharedRef());
-		//TSharedRef<const FUniqueNetId> val(Friends[i].GetUniqueNetId());
-		List.Add(val);
+		List.Add(Friends[i].GetHandle());
 	}
 
-	if (SessionInterface->SendSessionInviteToFriends(Player->GetControllerId(), NAME_GameSession, List))
+	// Large lists go out in rate limited chunks, use the SendSessionInvites node to get per player results
+	if (FSessionInviteDispatcher::Get().Enqueue(Player->GetControllerId(), NAME_GameSession, List, FOnSessionInvitesDispatched()) > 0)
 	{
 		Result = EBlueprintResultSwitch::OnSuccess;
 		return;
@@ -119,39 +128,37 @@ void UAdvancedFriendsLibrary::GetFriend(APlayerController *PlayerController, con
 		return;
 	}
 
-	IOnlineFriendsPtr FriendsInterface = Online::GetFriendsInterface();
+	ULocalPlayer* Player = Cast<ULocalPlayer>(PlayerController->Player);
 
-	if (!FriendsInterface.IsValid())
+	if (!Player)
 	{
-		UE_LOG(AdvancedFriendsLog, Warning, TEXT("GetFriend Failed to get friends interface!"));
+		UE_LOG(AdvancedFriendsLog, Warning, TEXT("GetFriend failed to get LocalPlayer!"));
 		return;
 	}
 
-	ULocalPlayer* Player = Cast<ULocalPlayer>(PlayerController->Player);
+	// Once the list has been read this is a hashed lookup, no need to go to the subsystem
+	TSharedPtr<FAdvancedFriendsSnapshot> Snapshot = FAdvancedFriendsSnapshot::Get(Player->GetControllerId());
+	if (Snapshot.IsValid() && Snapshot->IsBuilt())
+	{
+		if (const FBPFriendInfo* Found = Snapshot->FindFriend(FriendUniqueNetId.GetHandle()))
+		{
+			Friend = *Found;
+		}
+		return;
+	}
 
-	if (!Player)
+	IOnlineFriendsPtr FriendsInterface = Online::GetFriendsInterface();
+
+	if (!FriendsInterface.IsValid())
 	{
-		UE_LOG(AdvancedFriendsLog, Warning, TEXT("GetFriend failed to get LocalPlayer!"));
+		UE_LOG(AdvancedFriendsLog, Warning, TEXT("GetFriend Failed to get friends interface!"));
 		return;
 	}
 
 	TSharedPtr<FOnlineFriend> fr = FriendsInterface->GetFriend(Player->GetControllerId(), *FriendUniqueNetId.GetUniqueNetId(), EFriendsLists::ToString(EFriendsLists::Default));
 	if (fr.IsValid())
 	{
-		FOnlineUserPresence pres = fr->GetPresence();
-		Friend.DisplayName = fr->GetDisplayName();
-		Friend.OnlineState = ((EBPOnlinePresenceState)((int32)pres.Status.State));
-		Friend.RealName = fr->GetRealName();
-		Friend.UniqueNetId.SetUniqueNetId(fr->GetUserId());
-		Friend.bIsPlayingSameGame = pres.bIsPlayingThisGame;
-
-		Friend.PresenceInfo.bHasVoiceSupport = pres.bHasVoiceSupport;
-		Friend.PresenceInfo.bIsJoinable = pres.bIsJoinable;
-		Friend.PresenceInfo.bIsOnline = pres.bIsOnline;
-		Friend.PresenceInfo.bIsPlaying = pres.bIsPlaying;
-		Friend.PresenceInfo.bIsPlayingThisGame = pres.bIsPlayingThisGame;
-		Friend.PresenceInfo.PresenceState = ((EBPOnlinePresenceState)((int32)pres.Status.State));
-		Friend.PresenceInfo.StatusString = pres.Status.StatusStr;
+		FAdvancedFriendsSnapshot::FillFriendInfo(*fr, Friend);
 	}
 }
 
@@ -169,19 +176,26 @@ void UAdvancedFriendsLibrary::IsAFriend(APlayerController *PlayerController, con
 		return;
 	}
 
-	IOnlineFriendsPtr FriendsInterface = Online::GetFriendsInterface();
+	ULocalPlayer* Player = Cast<ULocalPlayer>(PlayerController->Player);
 
-	if (!FriendsInterface.IsValid())
+	if (!Player)
 	{
-		UE_LOG(AdvancedFriendsLog, Warning, TEXT("IsAFriend Failed to get friends interface!"));
+		UE_LOG(AdvancedFriendsLog, Warning, TEXT("IsAFriend Failed to get LocalPlayer!"));
 		return;
 	}
 
-	ULocalPlayer* Player = Cast<ULocalPlayer>(PlayerController->Player);
+	TSharedPtr<FAdvancedFriendsSnapshot> Snapshot = FAdvancedFriendsSnapshot::Get(Player->GetControllerId());
+	if (Snapshot.IsValid() && Snapshot->IsBuilt())
+	{
+		IsFriend = Snapshot->FindFriend(UniqueNetId.GetHandle()) != nullptr;
+		return;
+	}
 
-	if (!Player)
+	IOnlineFriendsPtr FriendsInterface = Online::GetFriendsInterface();
+
+	if (!FriendsInterface.IsValid())
 	{
-		UE_LOG(AdvancedFriendsLog, Warning, TEXT("IsAFriend Failed to get LocalPlayer!"));
+		UE_LOG(AdvancedFriendsLog, Warning, TEXT("IsAFriend Failed to get friends interface!"));
 		return;
 	}
 
@@ -229,14 +243,6 @@ void UAdvancedFriendsLibrary::GetStoredFriendsList(APlayerController *PlayerCont
 		return;
 	}
 
-	IOnlineFriendsPtr FriendsInterface = Online::GetFriendsInterface();
-	
-	if (!FriendsInterface.IsValid())
-	{
-		UE_LOG(AdvancedFriendsLog, Warning, TEXT("GetFriendsList Failed to get friends interface!"));
-		return;
-	}
-
 	ULocalPlayer* Player = Cast<ULocalPlayer>(PlayerController->Player);
 
 	if (!Player)
@@ -245,30 +251,65 @@ void UAdvancedFriendsLibrary::GetStoredFriendsList(APlayerController *PlayerCont
 		return;
 	}
 
+	TSharedPtr<FAdvancedFriendsSnapshot> Snapshot = FAdvancedFriendsSnapshot::Get(Player->GetControllerId());
+
+	if (!Snapshot.IsValid() || !Snapshot->IsBuilt())
+	{
+		IOnlineFriendsPtr FriendsInterface = Online::GetFriendsInterface();
+
+		if (!FriendsInterface.IsValid())
+		{
+			UE_LOG(AdvancedFriendsLog, Warning, TEXT("GetFriendsList Failed to get friends interface!"));
+			return;
+		}
+
+		// List was read before the snapshot existed, build it once from what the subsystem has cached
+		TArray< TSharedRef<FOnlineFriend> > FriendList;
+		FriendsInterface->GetFriendsList(Player->GetControllerId(), EFriendsLists::ToString((EFriendsLists::Default)), FriendList);
+
+		Snapshot = FAdvancedFriendsSnapshot::FindOrCreate(Player->GetControllerId());
+		Snapshot->Rebuild(FriendList);
+	}
+
+	FriendsList.Append(Snapshot->GetFriends());
+}
+
+void UAdvancedFriendsLibrary::GetStoredFriendsListVersion(APlayerController *PlayerController, int32 &Version)
+{
+	Version = 0;
 
-	TArray< TSharedRef<FOnlineFriend> > FriendList;
-	FriendsInterface->GetFriendsList(Player->GetControllerId(), EFriendsLists::ToString((EFriendsLists::Default)), FriendList);
+	ULocalPlayer* Player = PlayerController ? Cast<ULocalPlayer>(PlayerController->Player) : nullptr;
 
-	for (int32 i = 0; i < FriendList.Num(); i++)
+	if (!Player)
 	{
-		TSharedRef<FOnlineFriend> Friend = FriendList[i];
-		FBPFriendInfo BPF;
-		FOnlineUserPresence pres = Friend->GetPresence();
+		UE_LOG(AdvancedFriendsLog, Warning, TEXT("GetStoredFriendsListVersion Had a bad Player Controller!"));
+		return;
+	}
 
-		BPF.OnlineState = ((EBPOnlinePresenceState)((int32)pres.Status.State));
-		BPF.DisplayName = Friend->GetDisplayName();
-		BPF.RealName = Friend->GetRealName();
-		BPF.UniqueNetId.SetUniqueNetId(Friend->GetUserId());
-		BPF.bIsPlayingSameGame = pres.bIsPlayingThisGame;
+	TSharedPtr<FAdvancedFriendsSnapshot> Snapshot = FAdvancedFriendsSnapshot::Get(Player->GetControllerId());
+	if (Snapshot.IsValid())
+	{
+		Version = Snapshot->GetVersion();
+	}
+}
 
-		BPF.PresenceInfo.bIsOnline = pres.bIsOnline;
-		BPF.PresenceInfo.bHasVoiceSupport = pres.bHasVoiceSupport;
-		BPF.PresenceInfo.bIsPlaying = pres.bIsPlaying;
-		BPF.PresenceInfo.PresenceState = ((EBPOnlinePresenceState)((int32)pres.Status.State));
-		BPF.PresenceInfo.StatusString = pres.Status.StatusStr;
-		BPF.PresenceInfo.bIsJoinable = pres.bIsJoinable;
-		BPF.PresenceInfo.bIsPlayingThisGame = pres.bIsPlayingThisGame;
+void UAdvancedFriendsLibrary::GetChangedFriendsSince(APlayerController *PlayerController, int32 SinceVersion, TArray<FBPFriendInfo> &ChangedFriends, int32 &CurrentVersion, bool &bNeedsFullRefresh)
+{
+	CurrentVersion = 0;
+	bNeedsFullRefresh = true;
 
-		FriendsList.Add(BPF);
+	ULocalPlayer* Player = PlayerController ? Cast<ULocalPlayer>(PlayerController->Player) : nullptr;
+
+	if (!Player)
+	{
+		UE_LOG(AdvancedFriendsLog, Warning, TEXT("GetChangedFriendsSince Had a bad Player Controller!"));
+		return;
 	}
-}
\ No newline at end of file
+
+	TSharedPtr<FAdvancedFriendsSnapshot> Snapshot = FAdvancedFriendsSnapshot::Get(Player->GetControllerId());
+	if (!Snapshot.IsValid() || !Snapshot->IsBuilt())
+		return;
+
+	CurrentVersion = Snapshot->GetVersion();
+	bNeedsFullRefresh = !Snapshot->GetChangedSince(SinceVersion, ChangedFriends);
+}
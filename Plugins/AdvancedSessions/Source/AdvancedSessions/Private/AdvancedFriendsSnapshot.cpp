@@ -0,0 +1,323 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+#include "AdvancedFriendsSnapshot.h"
+
+#include "HAL/IConsoleManager.h"
+#include "OnlineSubsystemTypes.h"
+
+DEFINE_LOG_CATEGORY(AdvancedFriendsSnapshotLog);
+
+namespace FriendsSnapshot
+{
+	static TMap<int32, TSharedRef<FAdvancedFriendsSnapshot>>& GetSnapshots()
+	{
+		static TMap<int32, TSharedRef<FAdvancedFriendsSnapshot>> Snapshots;
+		return Snapshots;
+	}
+
+	static bool PresenceEquals(const FBPFriendPresenceInfo& A, const FBPFriendPresenceInfo& B)
+	{
+		return A.bIsOnline == B.bIsOnline
+			&& A.bIsPlaying == B.bIsPlaying
+			&& A.bIsPlayingThisGame == B.bIsPlayingThisGame
+			&& A.bIsJoinable == B.bIsJoinable
+			&& A.bHasVoiceSupport == B.bHasVoiceSupport
+			&& A.PresenceState == B.PresenceState
+			&& A.StatusString.Equals(B.StatusString, ESearchCase::CaseSensitive);
+	}
+}
+
+FAdvancedFriendsSnapshot::FAdvancedFriendsSnapshot(int32 InLocalUserNum)
+	: LocalUserNum(InLocalUserNum)
+	, bBuilt(false)
+	, Version(0)
+	, RosterVersion(0)
+{
+}
+
+FAdvancedFriendsSnapshot::~FAdvancedFriendsSnapshot()
+{
+	if (PresenceReceivedHandle.IsValid())
+	{
+		IOnlinePresencePtr PresenceInterface = Online::GetPresenceInterface();
+		if (PresenceInterface.IsValid())
+		{
+			PresenceInterface->ClearOnPresenceReceivedDelegate_Handle(PresenceReceivedHandle);
+		}
+	}
+
+	if (FriendsChangeHandle.IsValid() || FriendRemovedHandle.IsValid())
+	{
+		IOnlineFriendsPtr FriendsInterface = Online::GetFriendsInterface();
+		if (FriendsInterface.IsValid())
+		{
+			FriendsInterface->ClearOnFriendsChangeDelegate_Handle(LocalUserNum, FriendsChangeHandle);
+			FriendsInterface->ClearOnFriendRemovedDelegate_Handle(FriendRemovedHandle);
+		}
+	}
+}
+
+TSharedPtr<FAdvancedFriendsSnapshot> FAdvancedFriendsSnapshot::Get(int32 LocalUserNum)
+{
+	const TSharedRef<FAdvancedFriendsSnapshot>* Snapshot = FriendsSnapshot::GetSnapshots().Find(LocalUserNum);
+	return Snapshot ? TSharedPtr<FAdvancedFriendsSnapshot>(*Snapshot) : nullptr;
+}
+
+TSharedRef<FAdvancedFriendsSnapshot> FAdvancedFriendsSnapshot::FindOrCreate(int32 LocalUserNum)
+{
+	TMap<int32, TSharedRef<FAdvancedFriendsSnapshot>>& Snapshots = FriendsSnapshot::GetSnapshots();
+
+	if (const TSharedRef<FAdvancedFriendsSnapshot>* Existing = Snapshots.Find(LocalUserNum))
+	{
+		return *Existing;
+	}
+
+	TSharedRef<FAdvancedFriendsSnapshot> Snapshot = MakeShareable(new FAdvancedFriendsSnapshot(LocalUserNum));
+	Snapshot->BindDelegates();
+	Snapshots.Add(LocalUserNum, Snapshot);
+	return Snapshot;
+}
+
+void FAdvancedFriendsSnapshot::Remove(int32 LocalUserNum)
+{
+	FriendsSnapshot::GetSnapshots().Remove(LocalUserNum);
+}
+
+void FAdvancedFriendsSnapshot::Shutdown()
+{
+	FriendsSnapshot::GetSnapshots().Empty();
+}
+
+void FAdvancedFriendsSnapshot::FillFriendInfo(const FOnlineFriend& Friend, FBPFriendInfo& OutInfo)
+{
+	OutInfo.DisplayName = Friend.GetDisplayName();
+	OutInfo.RealName = Friend.GetRealName();
+	OutInfo.UniqueNetId.SetUniqueNetId(Friend.GetUserId());
+	FillPresenceInfo(Friend.GetPresence(), OutInfo);
+}
+
+void FAdvancedFriendsSnapshot::FillPresenceInfo(const FOnlineUserPresence& Presence, FBPFriendInfo& OutInfo)
+{
+	OutInfo.OnlineState = ((EBPOnlinePresenceState)((int32)Presence.Status.State));
+	OutInfo.bIsPlayingSameGame = Presence.bIsPlayingThisGame;
+
+	OutInfo.PresenceInfo.bIsOnline = Presence.bIsOnline;
+	OutInfo.PresenceInfo.bHasVoiceSupport = Presence.bHasVoiceSupport;
+	OutInfo.PresenceInfo.bIsPlaying = Presence.bIsPlaying;
+	OutInfo.PresenceInfo.PresenceState = ((EBPOnlinePresenceState)((int32)Presence.Status.State));
+	OutInfo.PresenceInfo.StatusString = Presence.Status.StatusStr;
+	OutInfo.PresenceInfo.bIsJoinable = Presence.bIsJoinable;
+	OutInfo.PresenceInfo.bIsPlayingThisGame = Presence.bIsPlayingThisGame;
+}
+
+void FAdvancedFriendsSnapshot::Rebuild(const TArray<TSharedRef<FOnlineFriend>>& Friends)
+{
+	++Version;
+	RosterVersion = Version;
+	bBuilt = true;
+
+	Rows.Reset(Friends.Num());
+	RowVersions.Reset(Friends.Num());
+	RowIndex.Reset();
+	RowIndex.Reserve(Friends.Num());
+
+	for (const TSharedRef<FOnlineFriend>& Friend : Friends)
+	{
+		const int32 RowNum = Rows.Num();
+		FBPFriendInfo& Row = Rows.AddDefaulted_GetRef();
+		FillFriendInfo(*Friend, Row);
+		RowVersions.Add(Version);
+
+		// FillFriendInfo interned the id, the index just reuses the handle
+		if (Row.UniqueNetId.IsValid())
+		{
+			RowIndex.Add(Row.UniqueNetId.GetHandle(), RowNum);
+		}
+	}
+
+	UE_LOG(AdvancedFriendsSnapshotLog, Verbose, TEXT("Rebuilt friends snapshot for user %d with %d friends (version %d)"), LocalUserNum, Rows.Num(), Version);
+}
+
+bool FAdvancedFriendsSnapshot::ApplyPresence(const FUniqueNetId& UserId, const FOnlineUserPresence& Presence)
+{
+	const int32 RowNum = FindRow(UserId);
+	if (RowNum == INDEX_NONE)
+		return false;
+
+	FBPFriendInfo Updated = Rows[RowNum];
+	FillPresenceInfo(Presence, Updated);
+
+	if (FriendsSnapshot::PresenceEquals(Updated.PresenceInfo, Rows[RowNum].PresenceInfo))
+		return false;
+
+	Rows[RowNum] = MoveTemp(Updated);
+	RowVersions[RowNum] = ++Version;
+	return true;
+}
+
+bool FAdvancedFriendsSnapshot::GetChangedSince(int32 SinceVersion, TArray<FBPFriendInfo>& OutChanged) const
+{
+	if (SinceVersion < RosterVersion)
+		return false;
+
+	for (int32 i = 0; i < Rows.Num(); ++i)
+	{
+		if (RowVersions[i] > SinceVersion)
+		{
+			OutChanged.Add(Rows[i]);
+		}
+	}
+
+	return true;
+}
+
+void FAdvancedFriendsSnapshot::BindDelegates()
+{
+	// The snapshot owns these bindings and clears them on destruction, so raw bindings are safe
+	IOnlinePresencePtr PresenceInterface = Online::GetPresenceInterface();
+	if (PresenceInterface.IsValid())
+	{
+		PresenceReceivedHandle = PresenceInterface->AddOnPresenceReceivedDelegate_Handle(FOnPresenceReceivedDelegate::CreateRaw(this, &FAdvancedFriendsSnapshot::OnPresenceReceived));
+	}
+
+	IOnlineFriendsPtr FriendsInterface = Online::GetFriendsInterface();
+	if (FriendsInterface.IsValid() && LocalUserNum >= 0 && LocalUserNum < MAX_LOCAL_PLAYERS)
+	{
+		FriendsChangeHandle = FriendsInterface->AddOnFriendsChangeDelegate_Handle(LocalUserNum, FOnFriendsChangeDelegate::CreateRaw(this, &FAdvancedFriendsSnapshot::OnFriendsChange));
+		FriendRemovedHandle = FriendsInterface->AddOnFriendRemovedDelegate_Handle(FOnFriendRemovedDelegate::CreateRaw(this, &FAdvancedFriendsSnapshot::OnFriendRemoved));
+	}
+}
+
+void FAdvancedFriendsSnapshot::OnPresenceReceived(const FUniqueNetId& UserId, const TSharedRef<FOnlineUserPresence>& Presence)
+{
+	if (bBuilt)
+	{
+		ApplyPresence(UserId, *Presence);
+	}
+}
+
+void FAdvancedFriendsSnapshot::OnFriendsChange()
+{
+	if (bBuilt)
+	{
+		RebuildFromSubsystem();
+	}
+}
+
+void FAdvancedFriendsSnapshot::OnFriendRemoved(const FUniqueNetId& UserId, const FUniqueNetId& FriendId)
+{
+	if (bBuilt && FindRow(FriendId) != INDEX_NONE)
+	{
+		RebuildFromSubsystem();
+	}
+}
+
+void FAdvancedFriendsSnapshot::RebuildFromSubsystem()
+{
+	IOnlineFriendsPtr FriendsInterface = Online::GetFriendsInterface();
+	if (!FriendsInterface.IsValid())
+		return;
+
+	TArray< TSharedRef<FOnlineFriend> > FriendList;
+	FriendsInterface->GetFriendsList(LocalUserNum, EFriendsLists::ToString((EFriendsLists::Default)), FriendList);
+	Rebuild(FriendList);
+}
+
+#if !UE_BUILD_SHIPPING
+
+// Minimal friend for the lookup benchmark, nothing but an id
+class FBenchmarkOnlineFriend : public FOnlineFriend
+{
+public:
+
+	FBenchmarkOnlineFriend(const FString& InId)
+		: UserId(MakeShared<FUniqueNetIdString>(InId))
+	{
+	}
+
+	virtual TSharedRef<const FUniqueNetId> GetUserId() const { return UserId; }
+	virtual FString GetRealName() const { return FString(); }
+	virtual FString GetDisplayName(const FString& Platform = FString()) const { return FString(); }
+	virtual bool GetUserAttribute(const FString& AttrName, FString& OutAttrValue) const { return false; }
+	virtual bool SetUserLocalAttribute(const FString& AttrName, const FString& InAttrValue) { return false; }
+	virtual EInviteStatus::Type GetInviteStatus() const { return EInviteStatus::Accepted; }
+	virtual const FOnlineUserPresence& GetPresence() const { return Presence; }
+
+private:
+
+	TSharedRef<const FUniqueNetId> UserId;
+	FOnlineUserPresence Presence;
+};
+
+void FAdvancedFriendsSnapshot::RunLookupBenchmark(int32 NumFriends, int32 QueriesPerFrame, int32 NumFrames, FOutputDevice& Ar)
+{
+	NumFriends = FMath::Max(1, NumFriends);
+	QueriesPerFrame = FMath::Max(1, QueriesPerFrame);
+	NumFrames = FMath::Max(1, NumFrames);
+
+	TArray<TSharedRef<FOnlineFriend>> Friends;
+	Friends.Reserve(NumFriends);
+	for (int32 i = 0; i < NumFriends; ++i)
+	{
+		Friends.Add(MakeShared<FBenchmarkOnlineFriend>(FString::Printf(TEXT("BenchFriend_%d"), i)));
+	}
+
+	// Stand alone so the benchmark never touches a real user's snapshot or the subsystem
+	FAdvancedFriendsSnapshot Snapshot(INDEX_NONE);
+	Snapshot.Rebuild(Friends);
+
+	// Half the queries miss, which is the worst case for the scan
+	TArray<TSharedRef<const FUniqueNetId>> Queries;
+	Queries.Reserve(QueriesPerFrame);
+	for (int32 i = 0; i < QueriesPerFrame; ++i)
+	{
+		Queries.Add((i & 1) ? MakeShared<FUniqueNetIdString>(FString::Printf(TEXT("NotAFriend_%d"), i)) : Friends[FMath::RandHelper(NumFriends)]->GetUserId());
+	}
+
+	int32 Hits = 0;
+	double Start = FPlatformTime::Seconds();
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		for (const TSharedRef<const FUniqueNetId>& Query : Queries)
+		{
+			Hits += Snapshot.FindFriend(*Query) ? 1 : 0;
+		}
+	}
+	const double IndexedSeconds = FPlatformTime::Seconds() - Start;
+
+	int32 ScanHits = 0;
+	Start = FPlatformTime::Seconds();
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		for (const TSharedRef<const FUniqueNetId>& Query : Queries)
+		{
+			for (const FBPFriendInfo& Row : Snapshot.GetFriends())
+			{
+				if (*Row.UniqueNetId.GetUniqueNetId() == *Query)
+				{
+					++ScanHits;
+					break;
+				}
+			}
+		}
+	}
+	const double ScanSeconds = FPlatformTime::Seconds() - Start;
+
+	const double NumQueries = (double)QueriesPerFrame * NumFrames;
+	Ar.Logf(TEXT("Friend lookups: %d friends, %d queries per frame, %d frames (%d / %d hits)"), NumFriends, QueriesPerFrame, NumFrames, Hits, ScanHits);
+	Ar.Logf(TEXT("  Indexed: %.3fms per frame, %.1fns per query"), (IndexedSeconds * 1000.0) / NumFrames, (IndexedSeconds * 1e9) / NumQueries);
+	Ar.Logf(TEXT("  Scan:    %.3fms per frame, %.1fns per query"), (ScanSeconds * 1000.0) / NumFrames, (ScanSeconds * 1e9) / NumQueries);
+}
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice BenchFriendLookupsCommand(
+	TEXT("AdvancedFriends.BenchFriendLookups"),
+	TEXT("Benchmarks friend lookups. Args: [NumFriends=1000] [QueriesPerFrame=100] [NumFrames=600]"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		FAdvancedFriendsSnapshot::RunLookupBenchmark(
+			Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 1000,
+			Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 100,
+			Args.Num() > 2 ? FCString::Atoi(*Args[2]) : 600,
+			Ar);
+	}));
+
+#endif
@@ -0,0 +1,333 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+#include "AdvancedIdentityCache.h"
+
+#include "HAL/IConsoleManager.h"
+#include "OnlineSubsystem.h"
+#include "OnlineSubsystemUtils.h"
+
+DEFINE_LOG_CATEGORY(AdvancedIdentityCacheLog);
+
+static TAutoConsoleVariable<float> CVarIdentityCacheNicknameLifetime(
+	TEXT("AdvancedSessions.IdentityCache.NicknameLifetime"),
+	60.f,
+	TEXT("Seconds a cached nickname is used before it is read from the identity interface again, 0 keeps them until invalidated."),
+	ECVF_Default);
+
+FAdvancedIdentityCache* FAdvancedIdentityCache::Instance = nullptr;
+
+FAdvancedIdentityCache& FAdvancedIdentityCache::Get()
+{
+	if (!Instance)
+	{
+		Instance = new FAdvancedIdentityCache();
+	}
+	return *Instance;
+}
+
+void FAdvancedIdentityCache::Shutdown()
+{
+	delete Instance;
+	Instance = nullptr;
+}
+
+FAdvancedIdentityCache::FAdvancedIdentityCache()
+{
+}
+
+FAdvancedIdentityCache::~FAdvancedIdentityCache()
+{
+	UnbindDelegates();
+}
+
+IOnlineIdentityPtr FAdvancedIdentityCache::GetIdentityInterface()
+{
+	IOnlineIdentityPtr IdentityInterface = Online::GetIdentityInterface();
+
+	if (IdentityInterface != BoundIdentityInterface.Pin())
+	{
+		// New subsystem (or none), nothing we have can be trusted. The old interface may still be around, don't leave it calling us
+		UnbindDelegates();
+		InvalidateAll();
+		BoundIdentityInterface = IdentityInterface;
+
+		if (IdentityInterface.IsValid())
+		{
+			BindDelegates(IdentityInterface);
+		}
+	}
+
+	return IdentityInterface;
+}
+
+void FAdvancedIdentityCache::BindDelegates(const IOnlineIdentityPtr& IdentityInterface)
+{
+	for (int32 LocalUserNum = 0; LocalUserNum < MAX_LOCAL_PLAYERS; ++LocalUserNum)
+	{
+		LoginStatusChangedHandles[LocalUserNum] = IdentityInterface->AddOnLoginStatusChangedDelegate_Handle(LocalUserNum, FOnLoginStatusChangedDelegate::CreateRaw(this, &FAdvancedIdentityCache::OnLoginStatusChanged));
+	}
+
+	LoginChangedHandle = IdentityInterface->AddOnLoginChangedDelegate_Handle(FOnLoginChangedDelegate::CreateRaw(this, &FAdvancedIdentityCache::OnLoginChanged));
+}
+
+void FAdvancedIdentityCache::UnbindDelegates()
+{
+	IOnlineIdentityPtr IdentityInterface = BoundIdentityInterface.Pin();
+
+	if (IdentityInterface.IsValid())
+	{
+		for (int32 LocalUserNum = 0; LocalUserNum < MAX_LOCAL_PLAYERS; ++LocalUserNum)
+		{
+			IdentityInterface->ClearOnLoginStatusChangedDelegate_Handle(LocalUserNum, LoginStatusChangedHandles[LocalUserNum]);
+		}
+
+		IdentityInterface->ClearOnLoginChangedDelegate_Handle(LoginChangedHandle);
+	}
+
+	for (FDelegateHandle& Handle : LoginStatusChangedHandles)
+	{
+		Handle.Reset();
+	}
+
+	LoginChangedHandle.Reset();
+	BoundIdentityInterface.Reset();
+}
+
+const FAdvancedIdentityCache::FEntry* FAdvancedIdentityCache::FindLiveEntry(const FUniqueNetIdHandle& UserId) const
+{
+	// Once the interface we bound to is gone so are our delegates, nothing cached can be trusted
+	return BoundIdentityInterface.IsValid() ? Entries.Find(UserId) : nullptr;
+}
+
+bool FAdvancedIdentityCache::IsNicknameFresh(const FEntry& Entry, double Now) const
+{
+	if (!Entry.bHasNickname)
+		return false;
+
+	const float Lifetime = CVarIdentityCacheNicknameLifetime.GetValueOnGameThread();
+	return Lifetime <= 0.f || (Now - Entry.NicknameTime) < Lifetime;
+}
+
+bool FAdvancedIdentityCache::GetPlayerNickname(const FUniqueNetIdHandle& UserId, FString& OutNickname)
+{
+	if (!UserId.IsValid())
+		return false;
+
+	const double Now = FPlatformTime::Seconds();
+
+	// Hot path, no subsystem access at all
+	if (const FEntry* Cached = FindLiveEntry(UserId))
+	{
+		if (IsNicknameFresh(*Cached, Now))
+		{
+			OutNickname = Cached->Nickname;
+			return true;
+		}
+	}
+
+	IOnlineIdentityPtr IdentityInterface = GetIdentityInterface();
+	if (!IdentityInterface.IsValid())
+		return false;
+
+	FEntry& Entry = Entries.FindOrAdd(UserId);
+
+	if (!IsNicknameFresh(Entry, Now))
+	{
+		Entry.Nickname = IdentityInterface->GetPlayerNickname(*UserId.Get());
+		Entry.NicknameTime = Now;
+		Entry.bHasNickname = true;
+	}
+
+	OutNickname = Entry.Nickname;
+	return true;
+}
+
+int32 FAdvancedIdentityCache::ResolvePlayerNicknames(const TArray<FUniqueNetIdHandle>& UserIds, TArray<FString>& OutNicknames)
+{
+	OutNicknames.Reset(UserIds.Num());
+	OutNicknames.SetNum(UserIds.Num());
+
+	const double Now = FPlatformTime::Seconds();
+	int32 NumResolved = 0;
+
+	// Resolved once, and only if something actually missed
+	IOnlineIdentityPtr IdentityInterface;
+
+	for (int32 i = 0; i < UserIds.Num(); ++i)
+	{
+		const FUniqueNetIdHandle& UserId = UserIds[i];
+		if (!UserId.IsValid())
+			continue;
+
+		if (const FEntry* Cached = FindLiveEntry(UserId))
+		{
+			if (IsNicknameFresh(*Cached, Now))
+			{
+				OutNicknames[i] = Cached->Nickname;
+				++NumResolved;
+				continue;
+			}
+		}
+
+		if (!IdentityInterface.IsValid())
+		{
+			IdentityInterface = GetIdentityInterface();
+			if (!IdentityInterface.IsValid())
+				return NumResolved;
+		}
+
+		FEntry& Entry = Entries.FindOrAdd(UserId);
+
+		if (!IsNicknameFresh(Entry, Now))
+		{
+			Entry.Nickname = IdentityInterface->GetPlayerNickname(*UserId.Get());
+			Entry.NicknameTime = Now;
+			Entry.bHasNickname = true;
+		}
+
+		OutNicknames[i] = Entry.Nickname;
+		++NumResolved;
+	}
+
+	return NumResolved;
+}
+
+bool FAdvancedIdentityCache::GetLoginStatus(const FUniqueNetIdHandle& UserId, ELoginStatus::Type& OutStatus)
+{
+	if (!UserId.IsValid())
+		return false;
+
+	if (const FEntry* Cached = FindLiveEntry(UserId))
+	{
+		if (Cached->bHasLoginStatus)
+		{
+			OutStatus = Cached->LoginStatus;
+			return true;
+		}
+	}
+
+	IOnlineIdentityPtr IdentityInterface = GetIdentityInterface();
+	if (!IdentityInterface.IsValid())
+		return false;
+
+	FEntry& Entry = Entries.FindOrAdd(UserId);
+
+	if (!Entry.bHasLoginStatus)
+	{
+		Entry.LoginStatus = IdentityInterface->GetLoginStatus(*UserId.Get());
+		Entry.bHasLoginStatus = true;
+	}
+
+	OutStatus = Entry.LoginStatus;
+	return true;
+}
+
+TSharedPtr<FUserOnlineAccount> FAdvancedIdentityCache::GetUserAccount(const FUniqueNetIdHandle& UserId)
+{
+	if (!UserId.IsValid())
+		return nullptr;
+
+	if (const FEntry* Cached = FindLiveEntry(UserId))
+	{
+		if (Cached->bHasAccount)
+			return Cached->Account;
+	}
+
+	IOnlineIdentityPtr IdentityInterface = GetIdentityInterface();
+	if (!IdentityInterface.IsValid())
+		return nullptr;
+
+	FEntry& Entry = Entries.FindOrAdd(UserId);
+
+	if (!Entry.bHasAccount)
+	{
+		Entry.Account = IdentityInterface->GetUserAccount(*UserId.Get());
+		Entry.bHasAccount = true;
+		Entry.Attributes.Reset();
+	}
+
+	return Entry.Account;
+}
+
+bool FAdvancedIdentityCache::GetUserAttribute(const TSharedRef<FUserOnlineAccount>& Account, const FString& AttributeName, FString& OutValue)
+{
+	// Make sure a subsystem swap has flushed us before trusting anything
+	if (!BoundIdentityInterface.IsValid())
+	{
+		GetIdentityInterface();
+	}
+
+	const FUniqueNetIdHandle UserId = FUniqueNetIdHandle::Intern(Account->GetUserId());
+	if (!UserId.IsValid())
+		return Account->GetUserAttribute(AttributeName, OutValue);
+
+	FEntry& Entry = Entries.FindOrAdd(UserId);
+
+	// An account we haven't seen, or a newer one than we hold, starts the attributes over
+	if (Entry.Account != Account)
+	{
+		Entry.Account = Account;
+		Entry.bHasAccount = true;
+		Entry.Attributes.Reset();
+	}
+
+	if (const TOptional<FString>* Cached = Entry.Attributes.Find(AttributeName))
+	{
+		if (Cached->IsSet())
+		{
+			OutValue = Cached->GetValue();
+			return true;
+		}
+		return false;
+	}
+
+	FString Value;
+	if (Account->GetUserAttribute(AttributeName, Value))
+	{
+		Entry.Attributes.Add(AttributeName, Value);
+		OutValue = MoveTemp(Value);
+		return true;
+	}
+
+	Entry.Attributes.Add(AttributeName, TOptional<FString>());
+	return false;
+}
+
+void FAdvancedIdentityCache::OnUserAttributeSet(const TSharedRef<FUserOnlineAccount>& Account, const FString& AttributeName, const FString& NewValue)
+{
+	const FUniqueNetIdHandle UserId = FUniqueNetIdHandle::Find(*Account->GetUserId());
+
+	if (FEntry* Entry = Entries.Find(UserId))
+	{
+		if (Entry->Account == Account)
+		{
+			Entry->Attributes.Add(AttributeName, NewValue);
+		}
+	}
+}
+
+void FAdvancedIdentityCache::Invalidate(const FUniqueNetIdHandle& UserId)
+{
+	Entries.Remove(UserId);
+}
+
+void FAdvancedIdentityCache::InvalidateAll()
+{
+	Entries.Reset();
+}
+
+void FAdvancedIdentityCache::OnLoginStatusChanged(int32 LocalUserNum, ELoginStatus::Type OldStatus, ELoginStatus::Type NewStatus, const FUniqueNetId& NewId)
+{
+	// Logging out resets whatever the subsystem knew about everyone else too
+	if (NewStatus == ELoginStatus::NotLoggedIn)
+	{
+		InvalidateAll();
+		return;
+	}
+
+	Invalidate(FUniqueNetIdHandle::Find(NewId));
+}
+
+void FAdvancedIdentityCache::OnLoginChanged(int32 LocalUserNum)
+{
+	InvalidateAll();
+}
@@ -1,5 +1,7 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 #include "AdvancedIdentityLibrary.h"
+#include "AdvancedIdentityCache.h"
+#include "AdvancedAuthTokenManager.h"
 
 //General Log
 DEFINE_LOG_CATEGORY(AdvancedIdentityLog);
@@ -23,16 +25,14 @@ void UAdvancedIdentityLibrary::GetPlayerAuthToken(APlayerController * PlayerCont
 		return;
 	}
 
-	IOnlineIdentityPtr IdentityInterface = Online::GetIdentityInterface();
-
-	if (!IdentityInterface.IsValid())
+	// Usually prefetched after login, only goes to the identity interface if it wasn't
+	if (!FAdvancedAuthTokenManager::Get().GetAuthToken(Player->GetControllerId(), AuthToken))
 	{
-		UE_LOG(AdvancedIdentityLog, Warning, TEXT("GetPlayerAuthToken Failed to get identity interface!"));
+		UE_LOG(AdvancedIdentityLog, Warning, TEXT("GetPlayerAuthToken Failed to get an auth token!"));
 		Result = EBlueprintResultSwitch::OnFailure;
 		return;
 	}
 
-	AuthToken = IdentityInterface->GetAuthToken(Player->GetControllerId());
 	Result = EBlueprintResultSwitch::OnSuccess;
 }
 
@@ -44,14 +44,24 @@ void UAdvancedIdentityLibrary::GetPlayerNickname(const FBPUniqueNetId & UniqueNe
 		return;
 	}
 
-	IOnlineIdentityPtr IdentityInterface = Online::GetIdentityInterface();
-
-	if (!IdentityInterface.IsValid())
+	if (!FAdvancedIdentityCache::Get().GetPlayerNickname(UniqueNetID.GetHandle(), PlayerNickname))
 	{
 		UE_LOG(AdvancedIdentityLog, Warning, TEXT("GetPlayerNickname Failed to get identity interface!"));
 		return;
 	}
-	PlayerNickname = IdentityInterface->GetPlayerNickname(*UniqueNetID.GetUniqueNetId());
+}
+
+int32 UAdvancedIdentityLibrary::ResolvePlayerNicknames(const TArray<FBPUniqueNetId> & UniqueNetIDs, TArray<FString> & PlayerNicknames)
+{
+	TArray<FUniqueNetIdHandle> Handles;
+	Handles.Reserve(UniqueNetIDs.Num());
+
+	for (const FBPUniqueNetId& UniqueNetID : UniqueNetIDs)
+	{
+		Handles.Add(UniqueNetID.GetHandle());
+	}
+
+	return FAdvancedIdentityCache::Get().ResolvePlayerNicknames(Handles, PlayerNicknames);
 }
 
 
@@ -64,16 +74,16 @@ void UAdvancedIdentityLibrary::GetLoginStatus(const FBPUniqueNetId & UniqueNetID
 		return;
 	}
 
-	IOnlineIdentityPtr IdentityInterface = Online::GetIdentityInterface();
+	ELoginStatus::Type Status;
 
-	if (!IdentityInterface.IsValid())
+	if (!FAdvancedIdentityCache::Get().GetLoginStatus(UniqueNetID.GetHandle(), Status))
 	{
 		UE_LOG(AdvancedIdentityLog, Warning, TEXT("GetLoginStatus Failed to get identity interface!"));
 		Result = EBlueprintResultSwitch::OnFailure;
 		return;
 	}
 
-	LoginStatus = (EBPLoginStatus)IdentityInterface->GetLoginStatus(*UniqueNetID.GetUniqueNetId());
+	LoginStatus = (EBPLoginStatus)Status;
 	Result = EBlueprintResultSwitch::OnSuccess;
 }
 
@@ -101,8 +111,6 @@ void UAdvancedIdentityLibrary::GetAllUserAccounts(TArray<FBPUserOnlineAccount> &
 
 void UAdvancedIdentityLibrary::GetUserAccount(const FBPUniqueNetId & UniqueNetId, FBPUserOnlineAccount & AccountInfo, EBlueprintResultSwitch &Result)
 {
-	IOnlineIdentityPtr IdentityInterface = Online::GetIdentityInterface();
-
 	if(!UniqueNetId.IsValid())
 	{
 		UE_LOG(AdvancedIdentityLog, Warning, TEXT("GetUserAccount was passed a bad unique net id!"));
@@ -110,14 +118,7 @@ void UAdvancedIdentityLibrary::GetUserAccount(const FBPUniqueNetId & UniqueNetId
 		return;
 	}
 
-	if (!IdentityInterface.IsValid())
-	{
-		UE_LOG(AdvancedIdentityLog, Warning, TEXT("GetUserAccount Failed to get identity interface!"));
-		Result = EBlueprintResultSwitch::OnFailure;
-		return;
-	}
-
-	TSharedPtr<FUserOnlineAccount> accountInfo = IdentityInterface->GetUserAccount(*UniqueNetId.GetUniqueNetId());
+	TSharedPtr<FUserOnlineAccount> accountInfo = FAdvancedIdentityCache::Get().GetUserAccount(UniqueNetId.GetHandle());
 
 	if (!accountInfo.IsValid())
 	{
@@ -176,6 +177,8 @@ void UAdvancedIdentityLibrary::SetUserAccountAttribute(const FBPUserOnlineAccoun
 		return;
 	}
 
+	FAdvancedIdentityCache::Get().OnUserAttributeSet(AccountInfo.UserAccountInfo.ToSharedRef(), AttributeName, NewAttributeValue);
+
 	Result = EBlueprintResultSwitch::OnSuccess;
 }
 
@@ -224,7 +227,7 @@ void UAdvancedIdentityLibrary::GetUserAccountAttribute(const FBPUserOnlineAccoun
 		return;
 	}
 
-	if (!AccountInfo.UserAccountInfo->GetUserAttribute(AttributeName, AttributeValue))
+	if (!FAdvancedIdentityCache::Get().GetUserAttribute(AccountInfo.UserAccountInfo.ToSharedRef(), AttributeName, AttributeValue))
 	{
 		UE_LOG(AdvancedIdentityLog, Warning, TEXT("GetUserAccountAttribute failed to get user attribute!"));
 		Result = EBlueprintResultSwitch::OnFailure;
@@ -0,0 +1,363 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+#include "AdvancedOnlineRequestScheduler.h"
+
+#include "HAL/IConsoleManager.h"
+#include "OnlineSubsystemUtils.h"
+#include "Templates/UnrealTemplate.h"
+
+DEFINE_LOG_CATEGORY(AdvancedOnlineRequestLog);
+
+static TAutoConsoleVariable<float> CVarRequestSchedulerTimeout(
+	TEXT("AdvancedSessions.RequestScheduler.Timeout"),
+	60.f,
+	TEXT("Seconds an online request may spend queued and running before it fails as timed out, unless the request sets its own."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarRequestSchedulerIdentityTimeout(
+	TEXT("AdvancedSessions.RequestScheduler.Timeout.Identity"),
+	0.f,
+	TEXT("Seconds a login or logout may spend queued and running before it fails as timed out, 0 waits for the online subsystem however long it takes.\n")
+	TEXT("Logins can sit behind platform account prompts, so they don't use AdvancedSessions.RequestScheduler.Timeout."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarRequestSchedulerMaxIdentity(
+	TEXT("AdvancedSessions.RequestScheduler.MaxConcurrent.Identity"),
+	1,
+	TEXT("Most identity interface requests (login, logout) running at once."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarRequestSchedulerMaxFriends(
+	TEXT("AdvancedSessions.RequestScheduler.MaxConcurrent.Friends"),
+	4,
+	TEXT("Most friends interface requests (friends list, recent players, invites) running at once."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarRequestSchedulerMaxSession(
+	TEXT("AdvancedSessions.RequestScheduler.MaxConcurrent.Session"),
+	2,
+	TEXT("Most session interface requests (end session, find friend session, cancel find) running at once."),
+	ECVF_Default);
+
+FAdvancedOnlineRequestScheduler* FAdvancedOnlineRequestScheduler::Instance = nullptr;
+
+FAdvancedOnlineRequestScheduler& FAdvancedOnlineRequestScheduler::Get()
+{
+	if (!Instance)
+	{
+		Instance = new FAdvancedOnlineRequestScheduler();
+	}
+	return *Instance;
+}
+
+void FAdvancedOnlineRequestScheduler::Shutdown()
+{
+	delete Instance;
+	Instance = nullptr;
+}
+
+FAdvancedOnlineRequestScheduler::FAdvancedOnlineRequestScheduler()
+	: NextId(0)
+	, bPumping(false)
+{
+	FMemory::Memzero(NumRunning);
+}
+
+FAdvancedOnlineRequestScheduler::~FAdvancedOnlineRequestScheduler()
+{
+	if (TickerHandle.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+	}
+}
+
+int32 FAdvancedOnlineRequestScheduler::GetConcurrencyLimit(EAdvancedOnlineInterface Interface)
+{
+	int32 Limit = 1;
+
+	switch (Interface)
+	{
+	case EAdvancedOnlineInterface::Identity: Limit = CVarRequestSchedulerMaxIdentity.GetValueOnGameThread(); break;
+	case EAdvancedOnlineInterface::Friends: Limit = CVarRequestSchedulerMaxFriends.GetValueOnGameThread(); break;
+	case EAdvancedOnlineInterface::Session: Limit = CVarRequestSchedulerMaxSession.GetValueOnGameThread(); break;
+	default: break;
+	}
+
+	return FMath::Max(1, Limit);
+}
+
+void FAdvancedOnlineRequestScheduler::SetInterfaceOverrides(const IOnlineIdentityPtr& Identity, const IOnlineFriendsPtr& Friends, const IOnlineSessionPtr& Session)
+{
+	IdentityOverride = Identity;
+	FriendsOverride = Friends;
+	SessionOverride = Session;
+}
+
+IOnlineIdentityPtr FAdvancedOnlineRequestScheduler::GetIdentityInterface(UWorld* World) const
+{
+	return IdentityOverride.IsValid() ? IdentityOverride : Online::GetIdentityInterface(World);
+}
+
+IOnlineFriendsPtr FAdvancedOnlineRequestScheduler::GetFriendsInterface(UWorld* World) const
+{
+	return FriendsOverride.IsValid() ? FriendsOverride : Online::GetFriendsInterface(World);
+}
+
+IOnlineSessionPtr FAdvancedOnlineRequestScheduler::GetSessionInterface(UWorld* World) const
+{
+	return SessionOverride.IsValid() ? SessionOverride : Online::GetSessionInterface(World);
+}
+
+uint32 FAdvancedOnlineRequestScheduler::Submit(FAdvancedOnlineRequest&& Request)
+{
+	// 0 is never handed out so callers can use it for no ticket
+	if (++NextId == 0)
+	{
+		++NextId;
+	}
+
+	const uint32 Ticket = NextId;
+
+	FWaiter Waiter;
+	Waiter.Ticket = Ticket;
+	Waiter.OnFinished = Request.OnFinished;
+
+	if (!Request.DedupeKey.IsEmpty())
+	{
+		if (const uint32* ExistingId = RequestsByKey.Find(Request.DedupeKey))
+		{
+			FScheduledRequest& Existing = *Requests[*ExistingId];
+			Existing.Waiters.Add(Waiter);
+
+			// A more urgent caller moves the shared request up the queue
+			if (!Existing.bRunning && Request.Priority > Existing.Priority)
+			{
+				Existing.Priority = Request.Priority;
+				Queued.Remove(Existing.RequestId);
+				Enqueue(Existing.RequestId);
+			}
+
+			UE_LOG(AdvancedOnlineRequestLog, Verbose, TEXT("Request %s joined one already in flight"), *Request.DedupeKey);
+			return Ticket;
+		}
+	}
+
+	float Timeout = Request.Timeout;
+	if (Timeout <= 0.f)
+	{
+		Timeout = Request.Interface == EAdvancedOnlineInterface::Identity ? CVarRequestSchedulerIdentityTimeout.GetValueOnGameThread() : CVarRequestSchedulerTimeout.GetValueOnGameThread();
+	}
+
+	TUniquePtr<FScheduledRequest> Scheduled = MakeUnique<FScheduledRequest>();
+	Scheduled->RequestId = Ticket;
+	Scheduled->Interface = Request.Interface;
+	Scheduled->Priority = Request.Priority;
+	Scheduled->DedupeKey = MoveTemp(Request.DedupeKey);
+	Scheduled->ExclusiveKey = MoveTemp(Request.ExclusiveKey);
+	Scheduled->Start = MoveTemp(Request.Start);
+	Scheduled->Waiters.Add(Waiter);
+	Scheduled->Deadline = Timeout > 0.f ? FPlatformTime::Seconds() + Timeout : MAX_dbl;
+	Scheduled->bRunning = false;
+
+	if (!Scheduled->DedupeKey.IsEmpty())
+	{
+		RequestsByKey.Add(Scheduled->DedupeKey, Ticket);
+	}
+
+	Requests.Add(Ticket, MoveTemp(Scheduled));
+	Enqueue(Ticket);
+
+	EnsureTicker();
+	Pump();
+
+	return Ticket;
+}
+
+void FAdvancedOnlineRequestScheduler::Enqueue(uint32 RequestId)
+{
+	const EAdvancedOnlineRequestPriority Priority = Requests[RequestId]->Priority;
+
+	int32 InsertIndex = Queued.Num();
+	for (int32 i = 0; i < Queued.Num(); ++i)
+	{
+		if (Requests[Queued[i]]->Priority < Priority)
+		{
+			InsertIndex = i;
+			break;
+		}
+	}
+
+	Queued.Insert(RequestId, InsertIndex);
+}
+
+void FAdvancedOnlineRequestScheduler::Pump()
+{
+	// Starting a request can submit or finish others, the outer pump picks those up
+	if (bPumping)
+		return;
+
+	TGuardValue<bool> PumpGuard(bPumping, true);
+
+	int32 Index = 0;
+	while (Index < Queued.Num())
+	{
+		FScheduledRequest& Request = *Requests[Queued[Index]];
+		const uint8 InterfaceIndex = (uint8)Request.Interface;
+
+		if (NumRunning[InterfaceIndex] >= GetConcurrencyLimit(Request.Interface) ||
+			(!Request.ExclusiveKey.IsEmpty() && RunningExclusiveKeys.Contains(Request.ExclusiveKey)))
+		{
+			++Index;
+			continue;
+		}
+
+		Queued.RemoveAt(Index);
+		Request.bRunning = true;
+		++NumRunning[InterfaceIndex];
+
+		if (!Request.ExclusiveKey.IsEmpty())
+		{
+			RunningExclusiveKeys.Add(Request.ExclusiveKey);
+		}
+
+		const uint32 RequestId = Request.RequestId;
+		TFunction<bool(uint32)> Start = MoveTemp(Request.Start);
+
+		// May complete before it returns, subsystems without a backend often answer straight away
+		if (!Start || !Start(RequestId))
+		{
+			Finish(RequestId, EAdvancedOnlineRequestResult::Failure);
+		}
+
+		// The queue may have changed underneath us
+		Index = 0;
+	}
+}
+
+void FAdvancedOnlineRequestScheduler::Complete(uint32 RequestId, bool bWasSuccessful)
+{
+	if (!Requests.Contains(RequestId))
+	{
+		UE_LOG(AdvancedOnlineRequestLog, Verbose, TEXT("Ignoring answer for request %u, it already timed out or was dropped"), RequestId);
+		return;
+	}
+
+	Finish(RequestId, bWasSuccessful ? EAdvancedOnlineRequestResult::Success : EAdvancedOnlineRequestResult::Failure);
+}
+
+void FAdvancedOnlineRequestScheduler::Finish(uint32 RequestId, EAdvancedOnlineRequestResult Result)
+{
+	TUniquePtr<FScheduledRequest> Request;
+	if (!Requests.RemoveAndCopyValue(RequestId, Request))
+		return;
+
+	if (Request->bRunning)
+	{
+		--NumRunning[(uint8)Request->Interface];
+
+		if (!Request->ExclusiveKey.IsEmpty())
+		{
+			RunningExclusiveKeys.Remove(Request->ExclusiveKey);
+		}
+	}
+	else
+	{
+		Queued.Remove(RequestId);
+	}
+
+	if (!Request->DedupeKey.IsEmpty())
+	{
+		RequestsByKey.Remove(Request->DedupeKey);
+	}
+
+	for (const FWaiter& Waiter : Request->Waiters)
+	{
+		Waiter.OnFinished.ExecuteIfBound(Result);
+	}
+
+	Pump();
+}
+
+void FAdvancedOnlineRequestScheduler::Cancel(uint32 Ticket)
+{
+	for (TPair<uint32, TUniquePtr<FScheduledRequest>>& Pair : Requests)
+	{
+		FScheduledRequest& Request = *Pair.Value;
+
+		const int32 WaiterIndex = Request.Waiters.IndexOfByPredicate([Ticket](const FWaiter& Waiter) { return Waiter.Ticket == Ticket; });
+		if (WaiterIndex == INDEX_NONE)
+			continue;
+
+		FOnAdvancedOnlineRequestFinished OnFinished = Request.Waiters[WaiterIndex].OnFinished;
+		Request.Waiters.RemoveAt(WaiterIndex);
+
+		// Nobody wants it and it hasn't gone out yet, no point sending it
+		if (Request.Waiters.Num() == 0 && !Request.bRunning)
+		{
+			const uint32 RequestId = Request.RequestId;
+			Queued.Remove(RequestId);
+
+			if (!Request.DedupeKey.IsEmpty())
+			{
+				RequestsByKey.Remove(Request.DedupeKey);
+			}
+
+			Requests.Remove(RequestId);
+		}
+
+		OnFinished.ExecuteIfBound(EAdvancedOnlineRequestResult::Cancelled);
+		return;
+	}
+}
+
+void FAdvancedOnlineRequestScheduler::CancelAll()
+{
+	TArray<uint32> Tickets;
+	for (const TPair<uint32, TUniquePtr<FScheduledRequest>>& Pair : Requests)
+	{
+		for (const FWaiter& Waiter : Pair.Value->Waiters)
+		{
+			Tickets.Add(Waiter.Ticket);
+		}
+	}
+
+	for (uint32 Ticket : Tickets)
+	{
+		Cancel(Ticket);
+	}
+}
+
+void FAdvancedOnlineRequestScheduler::EnsureTicker()
+{
+	if (!TickerHandle.IsValid())
+	{
+		TickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FAdvancedOnlineRequestScheduler::Tick));
+	}
+}
+
+bool FAdvancedOnlineRequestScheduler::Tick(float DeltaTime)
+{
+	const double Now = FPlatformTime::Seconds();
+
+	TArray<uint32, TInlineAllocator<8>> Expired;
+	for (const TPair<uint32, TUniquePtr<FScheduledRequest>>& Pair : Requests)
+	{
+		if (Pair.Value->Deadline <= Now)
+		{
+			Expired.Add(Pair.Key);
+		}
+	}
+
+	for (uint32 RequestId : Expired)
+	{
+		UE_LOG(AdvancedOnlineRequestLog, Warning, TEXT("Online request %u timed out"), RequestId);
+		Finish(RequestId, EAdvancedOnlineRequestResult::TimedOut);
+	}
+
+	if (Requests.Num() == 0)
+	{
+		TickerHandle.Reset();
+		return false;
+	}
+
+	return true;
+}
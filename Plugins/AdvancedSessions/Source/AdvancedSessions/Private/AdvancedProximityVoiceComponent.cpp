@@ -0,0 +1,357 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+#include "AdvancedProximityVoiceComponent.h"
+
+#include "Engine/World.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/PlayerState.h"
+#include "Net/VoiceConfig.h"
+#include "Interfaces/VoiceInterface.h"
+
+DEFINE_LOG_CATEGORY(AdvancedProximityVoiceLog);
+
+UAdvancedProximityVoiceComponent::UAdvancedProximityVoiceComponent(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+	, HearingRadius(2500.f)
+	, HysteresisMargin(500.f)
+	, UpdateInterval(0.25f)
+	, bServerSideCulling(true)
+	, VoiceAttenuation(nullptr)
+{
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = true;
+}
+
+void UAdvancedProximityVoiceComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	SetComponentTickInterval(UpdateInterval);
+
+	// Other clients' controllers have nothing to hear with, on the server they only matter for culling
+	if (!IsLocalListener() && !IsServerListener())
+	{
+		SetComponentTickEnabled(false);
+	}
+}
+
+void UAdvancedProximityVoiceComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	// Put back everyone we dropped so voice works as normal without us
+	if (IsServerListener())
+	{
+		APlayerController* PC = Cast<APlayerController>(GetOwner());
+		for (TPair<FUniqueNetIdHandle, FProximityTalker>& Pair : Talkers)
+		{
+			APlayerState* PlayerState = Pair.Value.PlayerState.Get();
+			if (Pair.Value.bApplied && !Pair.Value.bInRange && PlayerState)
+			{
+				PC->GameplayUnmutePlayer(PlayerState->UniqueId);
+			}
+		}
+	}
+	else
+	{
+		IOnlineVoicePtr VoiceInterface = Online::GetVoiceInterface(GetWorld());
+		if (VoiceInterface.IsValid())
+		{
+			for (TPair<FUniqueNetIdHandle, FProximityTalker>& Pair : Talkers)
+			{
+				if (Pair.Value.bApplied && !Pair.Value.bInRange && Pair.Key.IsValid())
+				{
+					VoiceInterface->RegisterRemoteTalker(*Pair.Key.Get());
+				}
+			}
+		}
+	}
+
+	Talkers.Reset();
+	Grid.Reset();
+	GridPawns.Reset();
+	TalkerComponents.Reset();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UAdvancedProximityVoiceComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	if (GetComponentTickInterval() != UpdateInterval)
+	{
+		SetComponentTickInterval(UpdateInterval);
+	}
+
+	if (IsLocalListener() || IsServerListener())
+	{
+		UpdateProximity();
+	}
+}
+
+void UAdvancedProximityVoiceComponent::GetTalkersInRange(TArray<FBPUniqueNetId>& TalkersInRange) const
+{
+	TalkersInRange.Reset();
+
+	for (const TPair<FUniqueNetIdHandle, FProximityTalker>& Pair : Talkers)
+	{
+		if (Pair.Value.bInRange)
+		{
+			TalkersInRange.AddDefaulted_GetRef().SetUniqueNetId(Pair.Key);
+		}
+	}
+}
+
+bool UAdvancedProximityVoiceComponent::IsLocalListener() const
+{
+	const APlayerController* PC = Cast<APlayerController>(GetOwner());
+	return PC && PC->IsLocalController();
+}
+
+bool UAdvancedProximityVoiceComponent::IsServerListener() const
+{
+	const APlayerController* PC = Cast<APlayerController>(GetOwner());
+	return bServerSideCulling && PC && !PC->IsLocalController() && GetOwnerRole() == ROLE_Authority;
+}
+
+bool UAdvancedProximityVoiceComponent::GetListenerLocation(FVector& OutLocation) const
+{
+	const APlayerController* PC = Cast<APlayerController>(GetOwner());
+	if (!PC)
+		return false;
+
+	if (const APawn* Pawn = PC->GetPawn())
+	{
+		OutLocation = Pawn->GetActorLocation();
+		return true;
+	}
+
+	// Spectating, listen from the camera
+	FRotator ViewRotation;
+	PC->GetPlayerViewPoint(OutLocation, ViewRotation);
+	return true;
+}
+
+void UAdvancedProximityVoiceComponent::UpdateProximity()
+{
+	UWorld* World = GetWorld();
+	AGameStateBase* GameState = World ? World->GetGameState() : nullptr;
+	const APlayerController* PC = Cast<APlayerController>(GetOwner());
+
+	FVector ListenerLocation;
+	if (!GameState || !PC || !GetListenerLocation(ListenerLocation))
+		return;
+
+	// The server mutes instead, it has no local voice to register talkers with
+	const bool bServer = IsServerListener();
+
+	IOnlineVoicePtr VoiceInterface;
+	if (!bServer)
+	{
+		VoiceInterface = Online::GetVoiceInterface(World);
+		if (!VoiceInterface.IsValid())
+		{
+			UE_LOG(AdvancedProximityVoiceLog, Warning, TEXT("Proximity Voice couldn't get the voice interface!"));
+			return;
+		}
+	}
+
+	const APlayerState* ListenerState = PC->PlayerState;
+
+	for (TPair<FUniqueNetIdHandle, FProximityTalker>& Pair : Talkers)
+	{
+		Pair.Value.bSeenThisUpdate = false;
+		Pair.Value.bEvaluatedThisUpdate = false;
+	}
+
+	// Everyone remote in the game, whether or not they have a pawn right now
+	for (APlayerState* PlayerState : GameState->PlayerArray)
+	{
+		if (!PlayerState || PlayerState == ListenerState || PlayerState->bIsABot || !PlayerState->UniqueId.IsValid())
+			continue;
+
+		const FUniqueNetIdHandle Handle = FUniqueNetIdHandle::Intern(PlayerState->UniqueId.GetUniqueNetId());
+		if (!Handle.IsValid())
+			continue;
+
+		FProximityTalker* Entry = Talkers.Find(Handle);
+		if (!Entry)
+		{
+			Entry = &Talkers.Add(Handle);
+			Entry->bInRange = false;
+			Entry->bApplied = false;
+			Entry->bEvaluatedThisUpdate = false;
+		}
+
+		Entry->PlayerState = PlayerState;
+		Entry->bSeenThisUpdate = true;
+	}
+
+	const float InnerRadius = FMath::Max(1.f, HearingRadius);
+	const float OuterRadius = InnerRadius + FMath::Max(0.f, HysteresisMargin);
+	const float CellSize = OuterRadius;
+
+	Grid.Reset();
+	GridPawns.Reset();
+
+	for (FConstPawnIterator Iterator = World->GetPawnIterator(); Iterator; ++Iterator)
+	{
+		APawn* Pawn = Iterator->Get();
+		APlayerState* PlayerState = Pawn ? Pawn->GetPlayerState() : nullptr;
+
+		if (!PlayerState || PlayerState == ListenerState || !PlayerState->UniqueId.IsValid())
+			continue;
+
+		// Already interned above if they are in the player array, Find keeps stray pawns from growing the table
+		const FUniqueNetIdHandle Handle = FUniqueNetIdHandle::Find(*PlayerState->UniqueId);
+		if (!Handle.IsValid())
+			continue;
+
+		const int32 PawnIndex = GridPawns.Emplace(Handle, Pawn);
+		Grid.FindOrAdd(GetCell(Pawn->GetActorLocation(), CellSize)).Add(PawnIndex);
+	}
+
+	// Cells are as big as the outer radius, nobody outside these nine can be in range
+	const FIntPoint ListenerCell = GetCell(ListenerLocation, CellSize);
+
+	for (int32 X = -1; X <= 1; ++X)
+	{
+		for (int32 Y = -1; Y <= 1; ++Y)
+		{
+			const TArray<int32, TInlineAllocator<4>>* Cell = Grid.Find(ListenerCell + FIntPoint(X, Y));
+			if (!Cell)
+				continue;
+
+			for (int32 PawnIndex : *Cell)
+			{
+				const FUniqueNetIdHandle& Handle = GridPawns[PawnIndex].Key;
+				APawn* Pawn = GridPawns[PawnIndex].Value;
+
+				FProximityTalker* Entry = Talkers.Find(Handle);
+				if (!Entry || !Entry->bSeenThisUpdate)
+					continue;
+
+				const float DistSquared = FVector::DistSquared2D(Pawn->GetActorLocation(), ListenerLocation);
+
+				// Between the two radii whatever they were stays, that is the hysteresis
+				bool bInRange = Entry->bInRange;
+				if (DistSquared <= FMath::Square(InnerRadius))
+				{
+					bInRange = true;
+				}
+				else if (DistSquared > FMath::Square(OuterRadius))
+				{
+					bInRange = false;
+				}
+
+				Entry->bEvaluatedThisUpdate = true;
+				SetInRange(VoiceInterface.Get(), Handle, *Entry, bInRange);
+
+				if (bInRange && !bServer)
+				{
+					UpdateAttenuation(*Entry, Pawn);
+				}
+			}
+		}
+	}
+
+	for (auto It = Talkers.CreateIterator(); It; ++It)
+	{
+		FProximityTalker& Entry = It.Value();
+
+		// Left the game, the voice interface drops them itself
+		if (!Entry.bSeenThisUpdate)
+		{
+			TalkerComponents.Remove(Entry.Talker.Get());
+			It.RemoveCurrent();
+			continue;
+		}
+
+		// Too far away to be in the nine cells, or no pawn to hear them from
+		if (!Entry.bEvaluatedThisUpdate)
+		{
+			SetInRange(VoiceInterface.Get(), It.Key(), Entry, false);
+		}
+	}
+}
+
+void UAdvancedProximityVoiceComponent::SetInRange(IOnlineVoice* VoiceInterface, const FUniqueNetIdHandle& Handle, FProximityTalker& Entry, bool bInRange)
+{
+	if (Entry.bApplied && Entry.bInRange == bInRange)
+		return;
+
+	const FUniqueNetId* UniqueNetId = Handle.Get();
+	if (!UniqueNetId)
+		return;
+
+	if (VoiceInterface)
+	{
+		if (bInRange)
+		{
+			VoiceInterface->RegisterRemoteTalker(*UniqueNetId);
+		}
+		else
+		{
+			VoiceInterface->UnregisterRemoteTalker(*UniqueNetId);
+		}
+	}
+	else
+	{
+		APlayerController* PC = Cast<APlayerController>(GetOwner());
+		APlayerState* PlayerState = Entry.PlayerState.Get();
+		if (!PC || !PlayerState)
+			return;
+
+		// Nobody starts out muted, no need to tell the client about players who were in range all along
+		if (!Entry.bApplied && bInRange)
+		{
+			Entry.bInRange = true;
+			Entry.bApplied = true;
+			return;
+		}
+
+		// Gameplay mutes are kept apart from the player's own mute list, unmuting here never undoes one of theirs
+		if (bInRange)
+		{
+			PC->GameplayUnmutePlayer(PlayerState->UniqueId);
+		}
+		else
+		{
+			PC->GameplayMutePlayer(PlayerState->UniqueId);
+		}
+	}
+
+	UE_LOG(AdvancedProximityVoiceLog, Verbose, TEXT("%s %s voice range"), *UniqueNetId->ToDebugString(), bInRange ? TEXT("entered") : TEXT("left"));
+
+	Entry.bInRange = bInRange;
+	Entry.bApplied = true;
+}
+
+void UAdvancedProximityVoiceComponent::UpdateAttenuation(FProximityTalker& Entry, APawn* Pawn)
+{
+	if (!VoiceAttenuation || !Pawn)
+		return;
+
+	UVOIPTalker* Talker = Entry.Talker.Get();
+	if (!Talker)
+	{
+		APlayerState* PlayerState = Entry.PlayerState.Get();
+		if (!PlayerState)
+			return;
+
+		Talker = UVOIPTalker::CreateTalkerForPlayer(PlayerState);
+		if (!Talker)
+			return;
+
+		Entry.Talker = Talker;
+		TalkerComponents.Add(Talker);
+	}
+
+	// Pawns change on respawn, follow whichever one they have now
+	USceneComponent* Root = Pawn->GetRootComponent();
+	if (Talker->Settings.ComponentToAttachTo != Root || Talker->Settings.AttenuationSettings != VoiceAttenuation)
+	{
+		Talker->Settings.ComponentToAttachTo = Root;
+		Talker->Settings.AttenuationSettings = VoiceAttenuation;
+	}
+}
@@ -1,5 +1,10 @@
 //#include "StandAlonePrivatePCH.h"
 #include "AdvancedSessions.h"
+#include "AdvancedOnlineRequestScheduler.h"
+#include "AdvancedFriendsSnapshot.h"
+#include "AdvancedIdentityCache.h"
+#include "AdvancedAuthTokenManager.h"
+#include "SessionQosProber.h"
 
 void AdvancedSessions::StartupModule()
 {
@@ -7,6 +12,11 @@ void AdvancedSessions::StartupModule()
  
 void AdvancedSessions::ShutdownModule()
 {
+	FAdvancedOnlineRequestScheduler::Shutdown();
+	FAdvancedFriendsSnapshot::Shutdown();
+	FAdvancedIdentityCache::Shutdown();
+	FAdvancedAuthTokenManager::Shutdown();
+	FSessionQosProber::ShutdownPool();
 }
  
 IMPLEMENT_MODULE(AdvancedSessions, AdvancedSessions)
\ No newline at end of file
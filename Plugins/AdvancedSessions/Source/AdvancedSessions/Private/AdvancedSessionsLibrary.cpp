@@ -88,36 +88,22 @@ void UAdvancedSessionsLibrary::FindSessionPropertyIndexByName(const TArray<FSess
 
 void UAdvancedSessionsLibrary::AddOrModifyExtraSettings(UPARAM(ref) TArray<FSessionPropertyKeyPair> & SettingsArray, UPARAM(ref) TArray<FSessionPropertyKeyPair> & NewOrChangedSettings, TArray<FSessionPropertyKeyPair> & ModifiedSettingsArray)
 {
-	ModifiedSettingsArray = SettingsArray;
+	// Index the existing settings once instead of scanning them for every new setting
+	FBPSessionPropertyBag Bag;
+	Bag.Build(SettingsArray);
 
-	bool bFoundSetting = false;
-	// For each new setting
 	for (const FSessionPropertyKeyPair& Setting : NewOrChangedSettings)
 	{
-		bFoundSetting = false;
-
-		for (FSessionPropertyKeyPair & itr : ModifiedSettingsArray)
-		{
-			// Manually comparing the keys
-			if (itr.Key == Setting.Key)
-			{
-				bFoundSetting = true;
-				itr.Data = Setting.Data;
-			}
-		}
-
-		// If it was not found, add to the array instead
-		if (!bFoundSetting)
-		{
-			ModifiedSettingsArray.Add(Setting);
-		}
+		Bag.AddOrModify(Setting.Key, Setting.Data);
 	}
 
+	ModifiedSettingsArray = MoveTemp(Bag.Properties);
 }
 
 void UAdvancedSessionsLibrary::GetExtraSettings(FBlueprintSessionResult SessionResult, TArray<FSessionPropertyKeyPair> & ExtraSettings)
 {
 	FSessionPropertyKeyPair NewSetting;
+	ExtraSettings.Reserve(ExtraSettings.Num() + SessionResult.OnlineResult.Session.SessionSettings.Settings.Num());
 	for (auto& Elem : SessionResult.OnlineResult.Session.SessionSettings.Settings)
 	{
 		NewSetting.Key = Elem.Key;
@@ -168,6 +154,7 @@ void UAdvancedSessionsLibrary::GetSessionSettings(int32 &NumConnections, int32 &
 	bAllowJoinInProgress = settings->bAllowJoinInProgress;
 
 	FSessionPropertyKeyPair NewSetting;
+	ExtraSettings.Reserve(ExtraSettings.Num() + settings->Settings.Num());
 
 	for (auto& Elem : settings->Settings)
 	{
@@ -244,119 +231,69 @@ FSessionPropertyKeyPair UAdvancedSessionsLibrary::MakeLiteralSessionPropertyFloa
 
 void UAdvancedSessionsLibrary::GetSessionPropertyByte(const TArray<FSessionPropertyKeyPair> & ExtraSettings, FName SettingName, ESessionSettingSearchResult &SearchResult, uint8 &SettingValue)
 {
-	for (FSessionPropertyKeyPair itr : ExtraSettings)
-	{
-		if (itr.Key == SettingName)
-		{
-			if (itr.Data.GetType() == EOnlineKeyValuePairDataType::Int32)
-			{
-				int32 Val;
-				itr.Data.GetValue(Val);
-				SettingValue = (uint8)(Val);
-				SearchResult = ESessionSettingSearchResult::Found;
-			}
-			else
-			{
-				SearchResult = ESessionSettingSearchResult::WrongType;
-			}
-			return;
-		}
-	}
-
-	SearchResult = ESessionSettingSearchResult::NotFound;
-	return;
+	// Bytes are stored as Int32
+	int32 Val;
+	SearchResult = FBPSessionPropertyBag::GetTypedValue(FBPSessionPropertyBag::FindIn(ExtraSettings, SettingName), Val);
+	if (SearchResult == ESessionSettingSearchResult::Found)
+		SettingValue = (uint8)(Val);
 }
 
 void UAdvancedSessionsLibrary::GetSessionPropertyBool(const TArray<FSessionPropertyKeyPair> & ExtraSettings, FName SettingName, ESessionSettingSearchResult &SearchResult, bool &SettingValue)
 {
-	for (FSessionPropertyKeyPair itr : ExtraSettings)
-	{
-		if (itr.Key == SettingName)
-		{
-			if (itr.Data.GetType() == EOnlineKeyValuePairDataType::Bool)
-			{
-				itr.Data.GetValue(SettingValue);
-				SearchResult = ESessionSettingSearchResult::Found;
-			}
-			else
-			{
-				SearchResult = ESessionSettingSearchResult::WrongType;
-			}
-			return;
-		}
-	}
-
-	SearchResult = ESessionSettingSearchResult::NotFound;
-	return;
+	SearchResult = FBPSessionPropertyBag::GetTypedValue(FBPSessionPropertyBag::FindIn(ExtraSettings, SettingName), SettingValue);
 }
 
 void UAdvancedSessionsLibrary::GetSessionPropertyString(const TArray<FSessionPropertyKeyPair> & ExtraSettings, FName SettingName, ESessionSettingSearchResult &SearchResult, FString &SettingValue)
 {
-	for (FSessionPropertyKeyPair itr : ExtraSettings)
-	{
-		if (itr.Key == SettingName)
-		{
-			if (itr.Data.GetType() == EOnlineKeyValuePairDataType::String)
-			{
-				itr.Data.GetValue(SettingValue);
-				SearchResult = ESessionSettingSearchResult::Found;
-			}
-			else
-			{
-				SearchResult = ESessionSettingSearchResult::WrongType;
-			}
-			return;
-		}
-	}
-
-	SearchResult = ESessionSettingSearchResult::NotFound;
-	return;
+	SearchResult = FBPSessionPropertyBag::GetTypedValue(FBPSessionPropertyBag::FindIn(ExtraSettings, SettingName), SettingValue);
 }
 
 void UAdvancedSessionsLibrary::GetSessionPropertyInt(const TArray<FSessionPropertyKeyPair> & ExtraSettings, FName SettingName, ESessionSettingSearchResult &SearchResult, int32 &SettingValue)
 {
-	for (FSessionPropertyKeyPair itr : ExtraSettings)
-	{
-		if (itr.Key == SettingName)
-		{
-			if (itr.Data.GetType() == EOnlineKeyValuePairDataType::Int32)
-			{
-				itr.Data.GetValue(SettingValue);
-				SearchResult = ESessionSettingSearchResult::Found;
-			}
-			else
-			{
-				SearchResult = ESessionSettingSearchResult::WrongType;
-			}
-			return;
-		}
-	}
-
-	SearchResult = ESessionSettingSearchResult::NotFound;
-	return;
+	SearchResult = FBPSessionPropertyBag::GetTypedValue(FBPSessionPropertyBag::FindIn(ExtraSettings, SettingName), SettingValue);
 }
 
 void UAdvancedSessionsLibrary::GetSessionPropertyFloat(const TArray<FSessionPropertyKeyPair> & ExtraSettings, FName SettingName, ESessionSettingSearchResult &SearchResult, float &SettingValue)
 {
-	for (FSessionPropertyKeyPair itr : ExtraSettings)
-	{
-		if (itr.Key == SettingName)
-		{
-			if (itr.Data.GetType() == EOnlineKeyValuePairDataType::Float)
-			{
-				itr.Data.GetValue(SettingValue);
-				SearchResult = ESessionSettingSearchResult::Found;
-			}
-			else
-			{
-				SearchResult = ESessionSettingSearchResult::WrongType;
-			}
-			return;
-		}
-	}
+	SearchResult = FBPSessionPropertyBag::GetTypedValue(FBPSessionPropertyBag::FindIn(ExtraSettings, SettingName), SettingValue);
+}
 
-	SearchResult = ESessionSettingSearchResult::NotFound;
-	return;
+void UAdvancedSessionsLibrary::MakeSessionPropertyBag(const FBlueprintSessionResult& SessionResult, FBPSessionPropertyBag& PropertyBag)
+{
+	PropertyBag.Build(SessionResult.OnlineResult.Session.SessionSettings);
+}
+
+void UAdvancedSessionsLibrary::MakeSessionPropertyBagFromArray(const TArray<FSessionPropertyKeyPair>& ExtraSettings, FBPSessionPropertyBag& PropertyBag)
+{
+	PropertyBag.Build(ExtraSettings);
+}
+
+void UAdvancedSessionsLibrary::GetSessionPropertyBagByte(const FBPSessionPropertyBag& PropertyBag, FName SettingName, ESessionSettingSearchResult &SearchResult, uint8 &SettingValue)
+{
+	int32 Val;
+	SearchResult = PropertyBag.Get(SettingName, Val);
+	if (SearchResult == ESessionSettingSearchResult::Found)
+		SettingValue = (uint8)(Val);
+}
+
+void UAdvancedSessionsLibrary::GetSessionPropertyBagBool(const FBPSessionPropertyBag& PropertyBag, FName SettingName, ESessionSettingSearchResult &SearchResult, bool &SettingValue)
+{
+	SearchResult = PropertyBag.Get(SettingName, SettingValue);
+}
+
+void UAdvancedSessionsLibrary::GetSessionPropertyBagString(const FBPSessionPropertyBag& PropertyBag, FName SettingName, ESessionSettingSearchResult &SearchResult, FString &SettingValue)
+{
+	SearchResult = PropertyBag.Get(SettingName, SettingValue);
+}
+
+void UAdvancedSessionsLibrary::GetSessionPropertyBagInt(const FBPSessionPropertyBag& PropertyBag, FName SettingName, ESessionSettingSearchResult &SearchResult, int32 &SettingValue)
+{
+	SearchResult = PropertyBag.Get(SettingName, SettingValue);
+}
+
+void UAdvancedSessionsLibrary::GetSessionPropertyBagFloat(const FBPSessionPropertyBag& PropertyBag, FName SettingName, ESessionSettingSearchResult &SearchResult, float &SettingValue)
+{
+	SearchResult = PropertyBag.Get(SettingName, SettingValue);
 }
 
 
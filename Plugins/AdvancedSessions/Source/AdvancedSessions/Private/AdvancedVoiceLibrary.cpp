@@ -5,6 +5,60 @@
 //General Log
 DEFINE_LOG_CATEGORY(AdvancedVoiceLog);
 
+namespace AdvancedVoice
+{
+	static bool GetPackedBit(const TArray<int32>& Packed, int32 Index)
+	{
+		if (Index < 0 || (Index / 32) >= Packed.Num())
+			return false;
+
+		return (Packed[Index / 32] & (1u << (Index % 32))) != 0;
+	}
+
+	// Runs Func for every valid id against a single voice interface lookup, setting a bit for each true result
+	template<typename FuncType>
+	static int32 ForEachTalker(const TCHAR* FunctionName, const TArray<FBPUniqueNetId>& UniqueNetIds, TArray<int32>& PackedResults, FuncType&& Func)
+	{
+		PackedResults.Reset();
+		PackedResults.SetNumZeroed((UniqueNetIds.Num() + 31) / 32);
+
+		IOnlineVoicePtr VoiceInterface = Online::GetVoiceInterface();
+
+		if (!VoiceInterface.IsValid())
+		{
+			UE_LOG(AdvancedVoiceLog, Warning, TEXT("%s couldn't get the voice interface!"), FunctionName);
+			return 0;
+		}
+
+		int32 NumTrue = 0;
+		int32 NumInvalid = 0;
+
+		for (int32 i = 0; i < UniqueNetIds.Num(); ++i)
+		{
+			const FUniqueNetId* UniqueNetId = UniqueNetIds[i].GetUniqueNetId();
+
+			if (!UniqueNetId)
+			{
+				++NumInvalid;
+				continue;
+			}
+
+			if (Func(*VoiceInterface, *UniqueNetId))
+			{
+				PackedResults[i / 32] |= (1u << (i % 32));
+				++NumTrue;
+			}
+		}
+
+		if (NumInvalid > 0)
+		{
+			UE_LOG(AdvancedVoiceLog, Warning, TEXT("%s was passed %d invalid unique net ids!"), FunctionName, NumInvalid);
+		}
+
+		return NumTrue;
+	}
+}
+
 void UAdvancedVoiceLibrary::IsHeadsetPresent(bool & bHasHeadset, uint8 LocalPlayerNum)
 {
 	IOnlineVoicePtr VoiceInterface = Online::GetVoiceInterface();
@@ -251,4 +305,61 @@ void UAdvancedVoiceLibrary::GetNumLocalTalkers(int32 & NumLocalTalkers)
 	}
 
 	NumLocalTalkers = VoiceInterface->GetNumLocalTalkers();
-}
\ No newline at end of file
+}
+int32 UAdvancedVoiceLibrary::RegisterRemoteTalkers(const TArray<FBPUniqueNetId>& UniqueNetIds, TArray<int32>& PackedResults)
+{
+	return AdvancedVoice::ForEachTalker(TEXT("Register Remote Talkers"), UniqueNetIds, PackedResults, [](IOnlineVoice& VoiceInterface, const FUniqueNetId& UniqueNetId)
+	{
+		return VoiceInterface.RegisterRemoteTalker(UniqueNetId);
+	});
+}
+
+int32 UAdvancedVoiceLibrary::UnRegisterRemoteTalkers(const TArray<FBPUniqueNetId>& UniqueNetIds, TArray<int32>& PackedResults)
+{
+	return AdvancedVoice::ForEachTalker(TEXT("UnRegister Remote Talkers"), UniqueNetIds, PackedResults, [](IOnlineVoice& VoiceInterface, const FUniqueNetId& UniqueNetId)
+	{
+		return VoiceInterface.UnregisterRemoteTalker(UniqueNetId);
+	});
+}
+
+int32 UAdvancedVoiceLibrary::MuteRemoteTalkers(uint8 LocalUserNum, const TArray<FBPUniqueNetId>& UniqueNetIds, TArray<int32>& PackedResults, bool bIsSystemWide)
+{
+	return AdvancedVoice::ForEachTalker(TEXT("Mute Remote Talkers"), UniqueNetIds, PackedResults, [LocalUserNum, bIsSystemWide](IOnlineVoice& VoiceInterface, const FUniqueNetId& UniqueNetId)
+	{
+		return VoiceInterface.MuteRemoteTalker(LocalUserNum, UniqueNetId, bIsSystemWide);
+	});
+}
+
+int32 UAdvancedVoiceLibrary::UnMuteRemoteTalkers(uint8 LocalUserNum, const TArray<FBPUniqueNetId>& UniqueNetIds, TArray<int32>& PackedResults, bool bIsSystemWide)
+{
+	return AdvancedVoice::ForEachTalker(TEXT("Unmute Remote Talkers"), UniqueNetIds, PackedResults, [LocalUserNum, bIsSystemWide](IOnlineVoice& VoiceInterface, const FUniqueNetId& UniqueNetId)
+	{
+		return VoiceInterface.UnmuteRemoteTalker(LocalUserNum, UniqueNetId, bIsSystemWide);
+	});
+}
+
+int32 UAdvancedVoiceLibrary::AreRemotePlayersTalking(const TArray<FBPUniqueNetId>& UniqueNetIds, TArray<int32>& PackedResults)
+{
+	return AdvancedVoice::ForEachTalker(TEXT("Are Remote Players Talking"), UniqueNetIds, PackedResults, [](IOnlineVoice& VoiceInterface, const FUniqueNetId& UniqueNetId)
+	{
+		return VoiceInterface.IsRemotePlayerTalking(UniqueNetId);
+	});
+}
+
+int32 UAdvancedVoiceLibrary::ArePlayersMuted(uint8 LocalUserNumChecking, const TArray<FBPUniqueNetId>& UniqueNetIds, TArray<int32>& PackedResults)
+{
+	return AdvancedVoice::ForEachTalker(TEXT("Are Players Muted"), UniqueNetIds, PackedResults, [LocalUserNumChecking](IOnlineVoice& VoiceInterface, const FUniqueNetId& UniqueNetId)
+	{
+		return VoiceInterface.IsMuted(LocalUserNumChecking, UniqueNetId);
+	});
+}
+
+bool UAdvancedVoiceLibrary::GetPackedVoiceResult(const TArray<int32>& PackedResults, int32 Index)
+{
+	return AdvancedVoice::GetPackedBit(PackedResults, Index);
+}
+
+bool UAdvancedVoiceLibrary::IsTalkerSlotTalking(const TArray<int32>& TalkingBits, int32 TalkerSlot)
+{
+	return AdvancedVoice::GetPackedBit(TalkingBits, TalkerSlot);
+}
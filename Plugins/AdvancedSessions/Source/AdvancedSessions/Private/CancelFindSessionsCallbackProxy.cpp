@@ -9,6 +9,7 @@
 UCancelFindSessionsCallbackProxy::UCancelFindSessionsCallbackProxy(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 	, Delegate(FOnCancelFindSessionsCompleteDelegate::CreateUObject(this, &ThisClass::OnCompleted))
+	, RequestId(0)
 {
 }
 
@@ -27,13 +28,32 @@ void UCancelFindSessionsCallbackProxy::Activate()
 
 	if (Helper.IsValid())
 	{
-		auto Sessions = Helper.OnlineSub->GetSessionInterface();
+		auto Sessions = FAdvancedOnlineRequestScheduler::Get().GetSessionInterface(GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull));
 		if (Sessions.IsValid())		
 		{
-			DelegateHandle = Sessions->AddOnCancelFindSessionsCompleteDelegate_Handle(Delegate);
-			Sessions->CancelFindSessions();
+			TWeakObjectPtr<UCancelFindSessionsCallbackProxy> WeakThis(this);
+			TWeakPtr<IOnlineSession, ESPMode::ThreadSafe> WeakSessions = Sessions;
 
-			// OnCompleted will get called, nothing more to do now
+			FAdvancedOnlineRequest Request;
+			Request.Interface = EAdvancedOnlineInterface::Session;
+			Request.Priority = EAdvancedOnlineRequestPriority::High;
+			Request.DedupeKey = TEXT("CancelFindSessions");
+			Request.OnFinished = FOnAdvancedOnlineRequestFinished::CreateUObject(this, &ThisClass::OnRequestFinished);
+			Request.Start = [WeakThis, WeakSessions](uint32 InRequestId)
+			{
+				IOnlineSessionPtr SessionInterface = WeakSessions.Pin();
+
+				if (!WeakThis.IsValid() || !SessionInterface.IsValid())
+					return false;
+
+				WeakThis->RequestId = InRequestId;
+				WeakThis->DelegateHandle = SessionInterface->AddOnCancelFindSessionsCompleteDelegate_Handle(WeakThis->Delegate);
+				return SessionInterface->CancelFindSessions();
+			};
+
+			FAdvancedOnlineRequestScheduler::Get().Submit(MoveTemp(Request));
+
+			// OnRequestFinished will get called, nothing more to do now
 			return;
 		}
 		else
@@ -47,20 +67,25 @@ void UCancelFindSessionsCallbackProxy::Activate()
 }
 
 void UCancelFindSessionsCallbackProxy::OnCompleted(bool bWasSuccessful)
+{
+	FAdvancedOnlineRequestScheduler::Get().Complete(RequestId, bWasSuccessful);
+}
+
+void UCancelFindSessionsCallbackProxy::OnRequestFinished(EAdvancedOnlineRequestResult Result)
 {
 	FOnlineSubsystemBPCallHelperAdvanced Helper(TEXT("CancelFindSessionsCallback"), GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull));
 	Helper.QueryIDFromPlayerController(PlayerControllerWeakPtr.Get());
 
 	if (Helper.IsValid())
 	{
-		auto Sessions = Helper.OnlineSub->GetSessionInterface();
+		auto Sessions = FAdvancedOnlineRequestScheduler::Get().GetSessionInterface(GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull));
 		if (Sessions.IsValid())
 		{
 			Sessions->ClearOnCancelFindSessionsCompleteDelegate_Handle(DelegateHandle);
 		}
 	}
 
-	if (bWasSuccessful)
+	if (Result == EAdvancedOnlineRequestResult::Success)
 	{
 		OnSuccess.Broadcast();
 	}
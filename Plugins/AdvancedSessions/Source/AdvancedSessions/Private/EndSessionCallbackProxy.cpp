@@ -9,6 +9,7 @@
 UEndSessionCallbackProxy::UEndSessionCallbackProxy(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 	, Delegate(FOnEndSessionCompleteDelegate::CreateUObject(this, &ThisClass::OnCompleted))
+	, RequestId(0)
 {
 }
 
@@ -27,21 +28,40 @@ void UEndSessionCallbackProxy::Activate()
 
 	if (Helper.IsValid())
 	{
-		auto Sessions = Helper.OnlineSub->GetSessionInterface();
+		auto Sessions = FAdvancedOnlineRequestScheduler::Get().GetSessionInterface(GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull));
 		if (Sessions.IsValid())
 		{
 			FNamedOnlineSession* Session = Sessions->GetNamedSession(NAME_GameSession);
 			if (Session &&
 				Session->SessionState == EOnlineSessionState::InProgress)
 			{
-				DelegateHandle = Sessions->AddOnEndSessionCompleteDelegate_Handle(Delegate);
-				Sessions->EndSession(NAME_GameSession);
+				TWeakObjectPtr<UEndSessionCallbackProxy> WeakThis(this);
+				TWeakPtr<IOnlineSession, ESPMode::ThreadSafe> WeakSessions = Sessions;
+
+				FAdvancedOnlineRequest Request;
+				Request.Interface = EAdvancedOnlineInterface::Session;
+				Request.Priority = EAdvancedOnlineRequestPriority::High;
+				Request.DedupeKey = TEXT("EndSession:GameSession");
+				Request.OnFinished = FOnAdvancedOnlineRequestFinished::CreateUObject(this, &ThisClass::OnRequestFinished);
+				Request.Start = [WeakThis, WeakSessions](uint32 InRequestId)
+				{
+					IOnlineSessionPtr SessionInterface = WeakSessions.Pin();
+
+					if (!WeakThis.IsValid() || !SessionInterface.IsValid())
+						return false;
+
+					WeakThis->RequestId = InRequestId;
+					WeakThis->DelegateHandle = SessionInterface->AddOnEndSessionCompleteDelegate_Handle(WeakThis->Delegate);
+					return SessionInterface->EndSession(NAME_GameSession);
+				};
+
+				FAdvancedOnlineRequestScheduler::Get().Submit(MoveTemp(Request));
 			}
 			else
 			{
 				OnSuccess.Broadcast();
 			}
-			// OnCompleted will get called, nothing more to do now
+			// OnRequestFinished will get called, nothing more to do now
 			return;
 		}
 		else
@@ -55,20 +75,25 @@ void UEndSessionCallbackProxy::Activate()
 }
 
 void UEndSessionCallbackProxy::OnCompleted(FName SessionName, bool bWasSuccessful)
+{
+	FAdvancedOnlineRequestScheduler::Get().Complete(RequestId, bWasSuccessful);
+}
+
+void UEndSessionCallbackProxy::OnRequestFinished(EAdvancedOnlineRequestResult Result)
 {
 	FOnlineSubsystemBPCallHelperAdvanced Helper(TEXT("EndSessionCallback"), GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull));
 	Helper.QueryIDFromPlayerController(PlayerControllerWeakPtr.Get());
 
 	if (Helper.IsValid())
 	{
-		auto Sessions = Helper.OnlineSub->GetSessionInterface();
+		auto Sessions = FAdvancedOnlineRequestScheduler::Get().GetSessionInterface(GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull));
 		if (Sessions.IsValid())
 		{
 			Sessions->ClearOnEndSessionCompleteDelegate_Handle(DelegateHandle);
 		}
 	}
 
-	if (bWasSuccessful)
+	if (Result == EAdvancedOnlineRequestResult::Success)
 	{
 		OnSuccess.Broadcast();
 	}
@@ -9,6 +9,8 @@ DEFINE_LOG_CATEGORY(AdvancedFindFriendSessionLog);
 UFindFriendSessionCallbackProxy::UFindFriendSessionCallbackProxy(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 	, OnFindFriendSessionCompleteDelegate(FOnFindFriendSessionCompleteDelegate::CreateUObject(this, &ThisClass::OnFindFriendSessionCompleted))
+	, LocalPlayerNum(0)
+	, RequestId(0)
 {
 }
 
@@ -41,7 +43,7 @@ void UFindFriendSessionCallbackProxy::Activate()
 		return;
 	}
 
-	IOnlineSessionPtr Sessions = Online::GetSessionInterface();
+	IOnlineSessionPtr Sessions = FAdvancedOnlineRequestScheduler::Get().GetSessionInterface();
 
 	if (Sessions.IsValid())
 	{	
@@ -56,10 +58,32 @@ void UFindFriendSessionCallbackProxy::Activate()
 			return;
 		}
 
-		FindFriendSessionCompleteDelegateHandle = Sessions->AddOnFindFriendSessionCompleteDelegate_Handle(Player->GetControllerId(), OnFindFriendSessionCompleteDelegate);
+		LocalPlayerNum = Player->GetControllerId();
+		SessionResults.Empty();
 
-		Sessions->FindFriendSession(Player->GetControllerId(), *cUniqueNetId.GetUniqueNetId());
+		TWeakObjectPtr<UFindFriendSessionCallbackProxy> WeakThis(this);
 
+		// Not shared since each search is for a different friend. The complete delegate is per local player and doesn't say
+		// which friend it answers for, so one player's searches run one at a time or the first answer would finish both
+		FAdvancedOnlineRequest Request;
+		Request.Interface = EAdvancedOnlineInterface::Session;
+		Request.Priority = EAdvancedOnlineRequestPriority::Normal;
+		Request.ExclusiveKey = FString::Printf(TEXT("FindFriendSession:%d"), LocalPlayerNum);
+		Request.OnFinished = FOnAdvancedOnlineRequestFinished::CreateUObject(this, &ThisClass::OnRequestFinished);
+		Request.Start = [WeakThis](uint32 InRequestId)
+		{
+			IOnlineSessionPtr SessionInterface = FAdvancedOnlineRequestScheduler::Get().GetSessionInterface();
+
+			if (!WeakThis.IsValid() || !SessionInterface.IsValid() || !WeakThis->cUniqueNetId.IsValid())
+				return false;
+
+			WeakThis->RequestId = InRequestId;
+			WeakThis->FindFriendSessionCompleteDelegateHandle = SessionInterface->AddOnFindFriendSessionCompleteDelegate_Handle(WeakThis->LocalPlayerNum, WeakThis->OnFindFriendSessionCompleteDelegate);
+			return SessionInterface->FindFriendSession(WeakThis->LocalPlayerNum, *WeakThis->cUniqueNetId.GetUniqueNetId());
+		};
+
+		// OnRequestFinished will get called, nothing more to do now
+		FAdvancedOnlineRequestScheduler::Get().Submit(MoveTemp(Request));
 		return;
 	}
 
@@ -71,36 +95,59 @@ void UFindFriendSessionCallbackProxy::Activate()
 
 void UFindFriendSessionCallbackProxy::OnFindFriendSessionCompleted(int32 LocalPlayer, bool bWasSuccessful, const TArray<FOnlineSessionSearchResult>& SessionInfo)
 {
-	IOnlineSessionPtr Sessions = Online::GetSessionInterface();
+	if (LocalPlayer != LocalPlayerNum)
+		return;
 
-	if (Sessions.IsValid())
-		Sessions->ClearOnFindFriendSessionCompleteDelegate_Handle(LocalPlayer, FindFriendSessionCompleteDelegateHandle);
+	// A search that timed out can still answer late while the next one runs, its friend's session isn't ours
+	if (SessionInfo.Num() > 0 && SessionInfo[0].Session.OwningUserId.IsValid() && cUniqueNetId.IsValid() &&
+		!(*SessionInfo[0].Session.OwningUserId == *cUniqueNetId.GetUniqueNetId()))
+		return;
+
+	SessionResults.Empty();
 
 	if ( bWasSuccessful )
 	{ 
-		TArray<FBlueprintSessionResult> Result;
-
 		for (auto& Sesh : SessionInfo)
 		{
 			if (Sesh.IsValid())
 			{
 				FBlueprintSessionResult BSesh;
 				BSesh.OnlineResult = Sesh;
-				Result.Add(BSesh);
+				SessionResults.Add(BSesh);
 			}
 		}
 
-		if(Result.Num() > 0)
-			OnSuccess.Broadcast(Result);
-		else
+		if (SessionResults.Num() == 0)
 		{
 			UE_LOG(AdvancedFindFriendSessionLog, Warning, TEXT("FindFriendSession Failed, returned an invalid session."));
-			OnFailure.Broadcast(Result);
 		}
 	}
 	else
 	{
 		UE_LOG(AdvancedFindFriendSessionLog, Warning, TEXT("FindFriendSession Failed"));
+	}
+
+	FAdvancedOnlineRequestScheduler::Get().Complete(RequestId, bWasSuccessful && SessionResults.Num() > 0);
+}
+
+void UFindFriendSessionCallbackProxy::OnRequestFinished(EAdvancedOnlineRequestResult Result)
+{
+	IOnlineSessionPtr Sessions = FAdvancedOnlineRequestScheduler::Get().GetSessionInterface();
+
+	if (Sessions.IsValid())
+		Sessions->ClearOnFindFriendSessionCompleteDelegate_Handle(LocalPlayerNum, FindFriendSessionCompleteDelegateHandle);
+
+	if (Result == EAdvancedOnlineRequestResult::Success)
+	{
+		OnSuccess.Broadcast(SessionResults);
+	}
+	else
+	{
+		if (Result == EAdvancedOnlineRequestResult::TimedOut)
+		{
+			UE_LOG(AdvancedFindFriendSessionLog, Warning, TEXT("FindFriendSession Failed, timed out"));
+		}
+
 		TArray<FBlueprintSessionResult> EmptyResult;
 		OnFailure.Broadcast(EmptyResult);
 	}
@@ -1,6 +1,28 @@
 // Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
 
 #include "FindSessionsCallbackProxyAdvanced.h"
+#include "SessionSearchTelemetry.h"
+
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<int32> CVarSessionQosRankResults(
+	TEXT("AdvancedSessions.SessionQos.RankSearchResults"),
+	0,
+	TEXT("Ping the hosts FindSessionsAdvanced found and sort its results best first before returning them.\n")
+	TEXT("0: off, 1: on"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarSessionQosProbeTime(
+	TEXT("AdvancedSessions.SessionQos.ProbeTime"),
+	2.f,
+	TEXT("Most seconds a search waits on QoS probes before returning, hosts that haven't answered by then rank by the ping the subsystem reported."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarSessionQosProbePort(
+	TEXT("AdvancedSessions.SessionQos.ProbePort"),
+	0,
+	TEXT("UDP port hosts echo QoS probes on, 0 probes the game port."),
+	ECVF_Default);
 
 
 //////////////////////////////////////////////////////////////////////////
@@ -14,6 +36,7 @@ UFindSessionsCallbackProxyAdvanced::UFindSessionsCallbackProxyAdvanced(const FOb
 {
 	bRunSecondSearch = false;
 	bIsOnSecondSearch = false;
+	SearchStartTime = 0.0;
 }
 
 UFindSessionsCallbackProxyAdvanced* UFindSessionsCallbackProxyAdvanced::FindSessionsAdvanced(UObject* WorldContextObject, class APlayerController* PlayerController, int MaxResults, bool bUseLAN, EBPServerPresenceSearchType ServerTypeToSearch, const TArray<FSessionsSearchSetting> &Filters, bool bEmptyServersOnly, bool bNonEmptyServersOnly, bool bSecureServersOnly, int MinSlotsAvailable)
@@ -139,6 +162,7 @@ void UFindSessionsCallbackProxyAdvanced::Activate()
 			// Copy the derived temp variable over to it's base class
 			SearchObject->QuerySettings = tem;
 
+			SearchStartTime = FPlatformTime::Seconds();
 			Sessions->FindSessions(*Helper.UserID, SearchObject.ToSharedRef());
 
 			// OnQueryCompleted will get called, nothing more to do now
@@ -174,18 +198,14 @@ void UFindSessionsCallbackProxyAdvanced::OnCompleted(bool bSuccess)
 		{
 			if (SearchObjectDedicated.IsValid())
 			{
-				// Just log the results for now, will need to add a blueprint-compatible search result struct
+				FSessionSearchTelemetry::RecordSearch(true, FPlatformTime::Seconds() - SearchStartTime, SearchObjectDedicated->SearchResults);
+
+				SessionSearchResults.Reserve(SessionSearchResults.Num() + SearchObjectDedicated->SearchResults.Num());
 				for (auto& Result : SearchObjectDedicated->SearchResults)
 				{
-					FString ResultText = FString::Printf(TEXT("Found a session. Ping is %d"), Result.PingInMs);
-
-					FFrame::KismetExecutionMessage(*ResultText, ELogVerbosity::Log);
-
-					FBlueprintSessionResult BPResult;
-					BPResult.OnlineResult = Result;
-					SessionSearchResults.Add(BPResult);
+					SessionSearchResults.AddDefaulted_GetRef().OnlineResult = Result;
 				}
-				OnSuccess.Broadcast(SessionSearchResults);
+				BroadcastSuccess();
 				return;
 			}
 		}
@@ -193,20 +213,16 @@ void UFindSessionsCallbackProxyAdvanced::OnCompleted(bool bSuccess)
 		{
 			if (SearchObject.IsValid())
 			{
-				// Just log the results for now, will need to add a blueprint-compatible search result struct
+				FSessionSearchTelemetry::RecordSearch(true, FPlatformTime::Seconds() - SearchStartTime, SearchObject->SearchResults);
+
+				SessionSearchResults.Reserve(SessionSearchResults.Num() + SearchObject->SearchResults.Num());
 				for (auto& Result : SearchObject->SearchResults)
 				{
-					FString ResultText = FString::Printf(TEXT("Found a session. Ping is %d"), Result.PingInMs);
-
-					FFrame::KismetExecutionMessage(*ResultText, ELogVerbosity::Log);
-
-					FBlueprintSessionResult BPResult;
-					BPResult.OnlineResult = Result;
-					SessionSearchResults.Add(BPResult);
+					SessionSearchResults.AddDefaulted_GetRef().OnlineResult = Result;
 				}
 				if (!bRunSecondSearch)
 				{
-					OnSuccess.Broadcast(SessionSearchResults);
+					BroadcastSuccess();
 					return;
 				}
 			}
@@ -214,11 +230,14 @@ void UFindSessionsCallbackProxyAdvanced::OnCompleted(bool bSuccess)
 	}
 	else
 	{
+		static const TArray<FOnlineSessionSearchResult> NoResults;
+		FSessionSearchTelemetry::RecordSearch(false, FPlatformTime::Seconds() - SearchStartTime, NoResults);
+
 		if (!bRunSecondSearch)
 		{
 			// Need to account for only one of the searches failing
 			if (SessionSearchResults.Num() > 0)
-				OnSuccess.Broadcast(SessionSearchResults);
+				BroadcastSuccess();
 			else
 				OnFailure.Broadcast(SessionSearchResults);
 			return;
@@ -230,12 +249,13 @@ void UFindSessionsCallbackProxyAdvanced::OnCompleted(bool bSuccess)
 		bRunSecondSearch = false;
 		bIsOnSecondSearch = true;
 		auto Sessions = Helper.OnlineSub->GetSessionInterface();
+		SearchStartTime = FPlatformTime::Seconds();
 		Sessions->FindSessions(*Helper.UserID, SearchObjectDedicated.ToSharedRef());
 	}
 	else // We lost our player controller
 	{
 		if (bSuccess && SessionSearchResults.Num() > 0)
-			OnSuccess.Broadcast(SessionSearchResults);
+			BroadcastSuccess();
 		else
 			OnFailure.Broadcast(SessionSearchResults);
 	}
@@ -418,4 +438,85 @@ bool UFindSessionsCallbackProxyAdvanced::CompareVariants(const FVariantData &A,
 
 
 
-}
\ No newline at end of file
+}
+
+void UFindSessionsCallbackProxyAdvanced::BroadcastSuccess()
+{
+	if (CVarSessionQosRankResults.GetValueOnGameThread() == 0 || SessionSearchResults.Num() == 0)
+	{
+		OnSuccess.Broadcast(SessionSearchResults);
+		return;
+	}
+
+	// A search started again while the last one was still being probed
+	if (QosTimeoutHandle.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(QosTimeoutHandle);
+		QosTimeoutHandle.Reset();
+	}
+
+	QosProber = MakeUnique<FSessionQosProber>();
+
+	const int32 ProbePort = CVarSessionQosProbePort.GetValueOnGameThread();
+	int32 NumTargets = 0;
+
+	for (const FBlueprintSessionResult& Result : SessionSearchResults)
+	{
+		if (QosProber->AddSearchResult(Result, ProbePort))
+		{
+			++NumTargets;
+		}
+	}
+
+	QosProber->Start();
+
+	if (NumTargets == 0 || !QosProber->IsRunning())
+	{
+		QosProber.Reset();
+		OnSuccess.Broadcast(SessionSearchResults);
+		return;
+	}
+
+	QosProber->OnQosUpdated.AddUObject(this, &ThisClass::OnQosUpdated);
+	QosTimeoutHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &ThisClass::OnQosProbeTimeout), FMath::Max(0.f, CVarSessionQosProbeTime.GetValueOnGameThread()));
+}
+
+void UFindSessionsCallbackProxyAdvanced::OnQosUpdated()
+{
+	if (QosProber.IsValid() && QosProber->HasProbedAllTargets())
+	{
+		FinishQosProbe();
+	}
+}
+
+bool UFindSessionsCallbackProxyAdvanced::OnQosProbeTimeout(float DeltaTime)
+{
+	QosTimeoutHandle.Reset();
+	FinishQosProbe();
+	return false;
+}
+
+void UFindSessionsCallbackProxyAdvanced::FinishQosProbe()
+{
+	if (!QosProber.IsValid())
+		return;
+
+	if (QosTimeoutHandle.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(QosTimeoutHandle);
+		QosTimeoutHandle.Reset();
+	}
+
+	QosProber->Stop();
+	QosProber->OnQosUpdated.RemoveAll(this);
+	QosProber->RankResults(SessionSearchResults);
+
+	// Can be inside the prober's own tick here, so it is deleted on the next one instead of right away
+	TSharedPtr<FSessionQosProber> FinishedProber(QosProber.Release());
+	FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([FinishedProber](float DeltaTime)
+	{
+		return false;
+	}));
+
+	OnSuccess.Broadcast(SessionSearchResults);
+}
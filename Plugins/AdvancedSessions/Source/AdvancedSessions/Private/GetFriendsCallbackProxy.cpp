@@ -1,5 +1,6 @@
 // Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
 #include "GetFriendsCallbackProxy.h"
+#include "AdvancedFriendsSnapshot.h"
 
 
 //////////////////////////////////////////////////////////////////////////
@@ -9,6 +10,8 @@ DEFINE_LOG_CATEGORY(AdvancedGetFriendsLog);
 UGetFriendsCallbackProxy::UGetFriendsCallbackProxy(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 	, FriendListReadCompleteDelegate(FOnReadFriendsListComplete::CreateUObject(this, &ThisClass::OnReadFriendsListCompleted))
+	, ControllerId(0)
+	, RequestId(0)
 {
 }
 
@@ -31,12 +34,42 @@ void UGetFriendsCallbackProxy::Activate()
 		return;
 	}
 
-	IOnlineFriendsPtr Friends = Online::GetFriendsInterface();
+	IOnlineFriendsPtr Friends = FAdvancedOnlineRequestScheduler::Get().GetFriendsInterface();
 	if (Friends.IsValid())
 	{	
 		ULocalPlayer* Player = Cast<ULocalPlayer>(PlayerControllerWeakPtr->Player);
 
-		Friends->ReadFriendsList(Player->GetControllerId(), EFriendsLists::ToString((EFriendsLists::Default)), FriendListReadCompleteDelegate);
+		if (!Player)
+		{
+			// Fail immediately
+			UE_LOG(AdvancedGetFriendsLog, Warning, TEXT("GetFriends Failed couldn't cast to ULocalPlayer!"));
+			TArray<FBPFriendInfo> EmptyArray;
+			OnFailure.Broadcast(EmptyArray);
+			return;
+		}
+
+		ControllerId = Player->GetControllerId();
+		TWeakObjectPtr<UGetFriendsCallbackProxy> WeakThis(this);
+
+		// Everyone reading the same player's list gets it from the snapshot the first read rebuilds
+		FAdvancedOnlineRequest Request;
+		Request.Interface = EAdvancedOnlineInterface::Friends;
+		Request.Priority = EAdvancedOnlineRequestPriority::Normal;
+		Request.DedupeKey = FString::Printf(TEXT("ReadFriendsList:%d"), ControllerId);
+		Request.OnFinished = FOnAdvancedOnlineRequestFinished::CreateUObject(this, &ThisClass::OnRequestFinished);
+		Request.Start = [WeakThis](uint32 InRequestId)
+		{
+			IOnlineFriendsPtr FriendsInterface = FAdvancedOnlineRequestScheduler::Get().GetFriendsInterface();
+
+			if (!WeakThis.IsValid() || !FriendsInterface.IsValid())
+				return false;
+
+			WeakThis->RequestId = InRequestId;
+			return FriendsInterface->ReadFriendsList(WeakThis->ControllerId, EFriendsLists::ToString((EFriendsLists::Default)), WeakThis->FriendListReadCompleteDelegate);
+		};
+
+		// OnRequestFinished will get called, nothing more to do now
+		FAdvancedOnlineRequestScheduler::Get().Submit(MoveTemp(Request));
 		return;
 	}
 
@@ -50,41 +83,29 @@ void UGetFriendsCallbackProxy::OnReadFriendsListCompleted(int32 LocalUserNum, bo
 {
 	if (bWasSuccessful)
 	{
-		IOnlineFriendsPtr Friends = Online::GetFriendsInterface();
+		IOnlineFriendsPtr Friends = FAdvancedOnlineRequestScheduler::Get().GetFriendsInterface();
 		if (Friends.IsValid())
 		{
-			// Not actually needed anymore, plus was not being validated and causing a crash
-			//ULocalPlayer* Player = Cast<ULocalPlayer>(PlayerControllerWeakPtr->Player);
-
-			TArray<FBPFriendInfo> FriendsListOut;
 			TArray< TSharedRef<FOnlineFriend> > FriendList;
 			Friends->GetFriendsList(LocalUserNum, ListName, FriendList);
 
-			for (int32 i = 0; i < FriendList.Num(); i++)
-			{
-				TSharedRef<FOnlineFriend> Friend = FriendList[i];
-				FBPFriendInfo BPF;
-				FOnlineUserPresence pres = Friend->GetPresence();
-				BPF.OnlineState = ((EBPOnlinePresenceState)((int32)pres.Status.State));
-				BPF.DisplayName = Friend->GetDisplayName();
-				BPF.RealName = Friend->GetRealName();
-				BPF.UniqueNetId.SetUniqueNetId(Friend->GetUserId());
-				BPF.bIsPlayingSameGame = pres.bIsPlayingThisGame;
-
-				BPF.PresenceInfo.bIsOnline = pres.bIsOnline;
-				BPF.PresenceInfo.bHasVoiceSupport = pres.bHasVoiceSupport;
-				BPF.PresenceInfo.bIsPlaying = pres.bIsPlaying;
-				BPF.PresenceInfo.PresenceState = ((EBPOnlinePresenceState)((int32)pres.Status.State));
-				BPF.PresenceInfo.StatusString = pres.Status.StatusStr;
-				BPF.PresenceInfo.bIsJoinable = pres.bIsJoinable;
-				BPF.PresenceInfo.bIsPlayingThisGame = pres.bIsPlayingThisGame;
-
-
-				FriendsListOut.Add(BPF);
-			}
-
-			OnSuccess.Broadcast(FriendsListOut);
+			// Build the snapshot once here, GetStoredFriendsList, presence updates and anyone sharing this read work off of it from now on
+			FAdvancedFriendsSnapshot::FindOrCreate(LocalUserNum)->Rebuild(FriendList);
 		}
+		else
+		{
+			bWasSuccessful = false;
+		}
+	}
+
+	FAdvancedOnlineRequestScheduler::Get().Complete(RequestId, bWasSuccessful);
+}
+
+void UGetFriendsCallbackProxy::OnRequestFinished(EAdvancedOnlineRequestResult Result)
+{
+	if (Result == EAdvancedOnlineRequestResult::Success)
+	{
+		OnSuccess.Broadcast(FAdvancedFriendsSnapshot::FindOrCreate(ControllerId)->GetFriends());
 	}
 	else
 	{
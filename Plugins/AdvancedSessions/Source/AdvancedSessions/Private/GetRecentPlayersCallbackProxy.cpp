@@ -9,6 +9,7 @@ DEFINE_LOG_CATEGORY(AdvancedGetRecentPlayersLog);
 UGetRecentPlayersCallbackProxy::UGetRecentPlayersCallbackProxy(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 	, QueryRecentPlayersCompleteDelegate(FOnQueryRecentPlayersCompleteDelegate::CreateUObject(this, &ThisClass::OnQueryRecentPlayersCompleted))
+	, RequestId(0)
 {
 }
 
@@ -31,13 +32,33 @@ void UGetRecentPlayersCallbackProxy::Activate()
 		return;
 	}
 
-	IOnlineFriendsPtr Friends = Online::GetFriendsInterface();
+	IOnlineFriendsPtr Friends = FAdvancedOnlineRequestScheduler::Get().GetFriendsInterface();
 	if (Friends.IsValid())
 	{	
-		DelegateHandle = Friends->AddOnQueryRecentPlayersCompleteDelegate_Handle(QueryRecentPlayersCompleteDelegate);
+		TWeakObjectPtr<UGetRecentPlayersCallbackProxy> WeakThis(this);
 
-		// Testing with null namespace
-		Friends->QueryRecentPlayers(*(cUniqueNetId.GetUniqueNetId()), "");
+		// Everyone asking for the same user reads the same stored list back
+		FAdvancedOnlineRequest Request;
+		Request.Interface = EAdvancedOnlineInterface::Friends;
+		Request.Priority = EAdvancedOnlineRequestPriority::Low;
+		Request.DedupeKey = FString::Printf(TEXT("QueryRecentPlayers:%s"), *cUniqueNetId.GetUniqueNetId()->ToString());
+		Request.OnFinished = FOnAdvancedOnlineRequestFinished::CreateUObject(this, &ThisClass::OnRequestFinished);
+		Request.Start = [WeakThis](uint32 InRequestId)
+		{
+			IOnlineFriendsPtr FriendsInterface = FAdvancedOnlineRequestScheduler::Get().GetFriendsInterface();
+
+			if (!WeakThis.IsValid() || !FriendsInterface.IsValid() || !WeakThis->cUniqueNetId.IsValid())
+				return false;
+
+			WeakThis->RequestId = InRequestId;
+			WeakThis->DelegateHandle = FriendsInterface->AddOnQueryRecentPlayersCompleteDelegate_Handle(WeakThis->QueryRecentPlayersCompleteDelegate);
+
+			// Testing with null namespace
+			return FriendsInterface->QueryRecentPlayers(*(WeakThis->cUniqueNetId.GetUniqueNetId()), "");
+		};
+
+		// OnRequestFinished will get called, nothing more to do now
+		FAdvancedOnlineRequestScheduler::Get().Submit(MoveTemp(Request));
 		return;
 	}
 	// Fail immediately
@@ -47,35 +68,37 @@ void UGetRecentPlayersCallbackProxy::Activate()
 
 void UGetRecentPlayersCallbackProxy::OnQueryRecentPlayersCompleted(const FUniqueNetId &UserID, const FString &Namespace, bool bWasSuccessful, const FString& ErrorString)
 {
-	
-	IOnlineFriendsPtr Friends = Online::GetFriendsInterface();
+	// The delegate isn't per user, another query may be answering
+	if (!cUniqueNetId.IsValid() || !(UserID == *cUniqueNetId.GetUniqueNetId()))
+		return;
+
+	FAdvancedOnlineRequestScheduler::Get().Complete(RequestId, bWasSuccessful);
+}
+
+void UGetRecentPlayersCallbackProxy::OnRequestFinished(EAdvancedOnlineRequestResult Result)
+{
+	IOnlineFriendsPtr Friends = FAdvancedOnlineRequestScheduler::Get().GetFriendsInterface();
+
 	if (Friends.IsValid())
 		Friends->ClearOnQueryRecentPlayersCompleteDelegate_Handle(DelegateHandle);
 
-
-	if (bWasSuccessful)
+	if (Result == EAdvancedOnlineRequestResult::Success && Friends.IsValid())
 	{
-		// WHOOPS
-		//IOnlineFriendsPtr Friends = Online::GetFriendsInterface();
-		if (Friends.IsValid())
+		TArray<FBPOnlineRecentPlayer> PlayersListOut;
+		TArray< TSharedRef<FOnlineRecentPlayer> > PlayerList;
+		Friends->GetRecentPlayers(*(cUniqueNetId.GetUniqueNetId()), "", PlayerList);
+
+		for (int32 i = 0; i < PlayerList.Num(); i++)
 		{
-			TArray<FBPOnlineRecentPlayer> PlayersListOut;
-			TArray< TSharedRef<FOnlineRecentPlayer> > PlayerList;
-
-			Friends->GetRecentPlayers(*(cUniqueNetId.GetUniqueNetId()), "", PlayerList);
-				
-			for (int32 i = 0; i < PlayerList.Num(); i++)
-			{
-				TSharedRef<FOnlineRecentPlayer> Player = PlayerList[i];
-				FBPOnlineRecentPlayer BPF;
-				BPF.DisplayName = Player->GetDisplayName();
-				BPF.RealName = Player->GetRealName();
-				BPF.UniqueNetId.SetUniqueNetId(Player->GetUserId());
-				PlayersListOut.Add(BPF);
-			}
-
-			OnSuccess.Broadcast(PlayersListOut);
+			TSharedRef<FOnlineRecentPlayer> Player = PlayerList[i];
+			FBPOnlineRecentPlayer BPF;
+			BPF.DisplayName = Player->GetDisplayName();
+			BPF.RealName = Player->GetRealName();
+			BPF.UniqueNetId.SetUniqueNetId(Player->GetUserId());
+			PlayersListOut.Add(BPF);
 		}
+
+		OnSuccess.Broadcast(PlayersListOut);
 	}
 	else
 	{
@@ -1,6 +1,7 @@
 // Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
 
 #include "LoginUserCallbackProxy.h"
+#include "AdvancedAuthTokenManager.h"
 
 
 //////////////////////////////////////////////////////////////////////////
@@ -9,6 +10,7 @@
 ULoginUserCallbackProxy::ULoginUserCallbackProxy(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 	, Delegate(FOnLoginCompleteDelegate::CreateUObject(this, &ThisClass::OnCompleted))
+	, RequestId(0)
 {
 }
 
@@ -39,13 +41,33 @@ void ULoginUserCallbackProxy::Activate()
 		return;
 	}
 
-	auto Identity = Online::GetIdentityInterface();
+	auto Identity = FAdvancedOnlineRequestScheduler::Get().GetIdentityInterface();
 
 	if (Identity.IsValid())
 	{
-		DelegateHandle = Identity->AddOnLoginCompleteDelegate_Handle(Player->GetControllerId(), Delegate);
-		FOnlineAccountCredentials AccountCreds(Identity->GetAuthType(), UserID, UserToken);
-		Identity->Login(Player->GetControllerId(), AccountCreds);
+		const int32 ControllerId = Player->GetControllerId();
+		TWeakObjectPtr<ULoginUserCallbackProxy> WeakThis(this);
+
+		FAdvancedOnlineRequest Request;
+		Request.Interface = EAdvancedOnlineInterface::Identity;
+		Request.Priority = EAdvancedOnlineRequestPriority::High;
+		Request.DedupeKey = FString::Printf(TEXT("Login:%d:%s"), ControllerId, *UserID);
+		Request.OnFinished = FOnAdvancedOnlineRequestFinished::CreateUObject(this, &ThisClass::OnRequestFinished);
+		Request.Start = [WeakThis, ControllerId](uint32 InRequestId)
+		{
+			IOnlineIdentityPtr IdentityInterface = FAdvancedOnlineRequestScheduler::Get().GetIdentityInterface();
+
+			if (!WeakThis.IsValid() || !IdentityInterface.IsValid())
+				return false;
+
+			WeakThis->RequestId = InRequestId;
+			WeakThis->DelegateHandle = IdentityInterface->AddOnLoginCompleteDelegate_Handle(ControllerId, WeakThis->Delegate);
+			FOnlineAccountCredentials AccountCreds(IdentityInterface->GetAuthType(), WeakThis->UserID, WeakThis->UserToken);
+			return IdentityInterface->Login(ControllerId, AccountCreds);
+		};
+
+		// OnRequestFinished will get called, nothing more to do now
+		FAdvancedOnlineRequestScheduler::Get().Submit(MoveTemp(Request));
 		return;
 	}
 
@@ -54,6 +76,17 @@ void ULoginUserCallbackProxy::Activate()
 }
 
 void ULoginUserCallbackProxy::OnCompleted(int32 LocalUserNum, bool bWasSuccessful, const FUniqueNetId& UserId, const FString& ErrorVal)
+{
+	if (bWasSuccessful)
+	{
+		// Have the token ready before the first connect asks for it
+		FAdvancedAuthTokenManager::Get().Prefetch(LocalUserNum);
+	}
+
+	FAdvancedOnlineRequestScheduler::Get().Complete(RequestId, bWasSuccessful);
+}
+
+void ULoginUserCallbackProxy::OnRequestFinished(EAdvancedOnlineRequestResult Result)
 {
 	if (PlayerControllerWeakPtr.IsValid())
 	{
@@ -61,7 +94,7 @@ void ULoginUserCallbackProxy::OnCompleted(int32 LocalUserNum, bool bWasSuccessfu
 
 		if (Player)
 		{
-			auto Identity = Online::GetIdentityInterface();
+			auto Identity = FAdvancedOnlineRequestScheduler::Get().GetIdentityInterface();
 
 			if (Identity.IsValid())
 			{
@@ -70,7 +103,7 @@ void ULoginUserCallbackProxy::OnCompleted(int32 LocalUserNum, bool bWasSuccessfu
 		}
 	}
 
-	if (bWasSuccessful)
+	if (Result == EAdvancedOnlineRequestResult::Success)
 	{
 		OnSuccess.Broadcast();
 	}
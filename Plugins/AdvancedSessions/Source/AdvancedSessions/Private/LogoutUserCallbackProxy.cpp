@@ -9,6 +9,7 @@
 ULogoutUserCallbackProxy::ULogoutUserCallbackProxy(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 	, Delegate(FOnLogoutCompleteDelegate::CreateUObject(this, &ThisClass::OnCompleted))
+	, RequestId(0)
 {
 }
 
@@ -38,12 +39,32 @@ void ULogoutUserCallbackProxy::Activate()
 		return;
 	}
 
-	auto Identity = Online::GetIdentityInterface();
+	auto Identity = FAdvancedOnlineRequestScheduler::Get().GetIdentityInterface();
 
 	if (Identity.IsValid())
 	{
-		DelegateHandle = Identity->AddOnLogoutCompleteDelegate_Handle(Player->GetControllerId(), Delegate);
-		Identity->Logout(Player->GetControllerId());
+		const int32 ControllerId = Player->GetControllerId();
+		TWeakObjectPtr<ULogoutUserCallbackProxy> WeakThis(this);
+
+		FAdvancedOnlineRequest Request;
+		Request.Interface = EAdvancedOnlineInterface::Identity;
+		Request.Priority = EAdvancedOnlineRequestPriority::High;
+		Request.DedupeKey = FString::Printf(TEXT("Logout:%d"), ControllerId);
+		Request.OnFinished = FOnAdvancedOnlineRequestFinished::CreateUObject(this, &ThisClass::OnRequestFinished);
+		Request.Start = [WeakThis, ControllerId](uint32 InRequestId)
+		{
+			IOnlineIdentityPtr IdentityInterface = FAdvancedOnlineRequestScheduler::Get().GetIdentityInterface();
+
+			if (!WeakThis.IsValid() || !IdentityInterface.IsValid())
+				return false;
+
+			WeakThis->RequestId = InRequestId;
+			WeakThis->DelegateHandle = IdentityInterface->AddOnLogoutCompleteDelegate_Handle(ControllerId, WeakThis->Delegate);
+			return IdentityInterface->Logout(ControllerId);
+		};
+
+		// OnRequestFinished will get called, nothing more to do now
+		FAdvancedOnlineRequestScheduler::Get().Submit(MoveTemp(Request));
 		return;
 	}
 
@@ -52,6 +73,11 @@ void ULogoutUserCallbackProxy::Activate()
 }
 
 void ULogoutUserCallbackProxy::OnCompleted(int LocalUserNum, bool bWasSuccessful)
+{
+	FAdvancedOnlineRequestScheduler::Get().Complete(RequestId, bWasSuccessful);
+}
+
+void ULogoutUserCallbackProxy::OnRequestFinished(EAdvancedOnlineRequestResult Result)
 {
 
 	if (PlayerControllerWeakPtr.IsValid())
@@ -60,7 +86,7 @@ void ULogoutUserCallbackProxy::OnCompleted(int LocalUserNum, bool bWasSuccessful
 
 		if (Player)
 		{
-			auto Identity = Online::GetIdentityInterface();
+			auto Identity = FAdvancedOnlineRequestScheduler::Get().GetIdentityInterface();
 
 			if (Identity.IsValid())
 			{
@@ -69,7 +95,7 @@ void ULogoutUserCallbackProxy::OnCompleted(int LocalUserNum, bool bWasSuccessful
 		}
 	}
 
-	if (bWasSuccessful)
+	if (Result == EAdvancedOnlineRequestResult::Success)
 	{
 		OnSuccess.Broadcast();
 	}
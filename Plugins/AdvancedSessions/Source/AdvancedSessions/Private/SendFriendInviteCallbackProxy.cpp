@@ -9,6 +9,7 @@ DEFINE_LOG_CATEGORY(AdvancedSendFriendInviteLog);
 USendFriendInviteCallbackProxy::USendFriendInviteCallbackProxy(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 	, OnSendInviteCompleteDelegate(FOnSendInviteComplete::CreateUObject(this, &ThisClass::OnSendInviteComplete))
+	, RequestId(0)
 {
 }
 
@@ -39,7 +40,7 @@ void USendFriendInviteCallbackProxy::Activate()
 		return;
 	}
 
-	IOnlineFriendsPtr Friends = Online::GetFriendsInterface();
+	IOnlineFriendsPtr Friends = FAdvancedOnlineRequestScheduler::Get().GetFriendsInterface();
 	if (Friends.IsValid())
 	{	
 		ULocalPlayer* Player = Cast<ULocalPlayer>(PlayerControllerWeakPtr->Player);
@@ -52,7 +53,27 @@ void USendFriendInviteCallbackProxy::Activate()
 			return;
 		}
 
-		Friends->SendInvite(Player->GetControllerId(), *cUniqueNetId.GetUniqueNetId(), EFriendsLists::ToString((EFriendsLists::Default)), OnSendInviteCompleteDelegate);
+		const int32 ControllerId = Player->GetControllerId();
+		TWeakObjectPtr<USendFriendInviteCallbackProxy> WeakThis(this);
+
+		FAdvancedOnlineRequest Request;
+		Request.Interface = EAdvancedOnlineInterface::Friends;
+		Request.Priority = EAdvancedOnlineRequestPriority::Normal;
+		Request.DedupeKey = FString::Printf(TEXT("SendInvite:%d:%s"), ControllerId, *cUniqueNetId.GetUniqueNetId()->ToString());
+		Request.OnFinished = FOnAdvancedOnlineRequestFinished::CreateUObject(this, &ThisClass::OnRequestFinished);
+		Request.Start = [WeakThis, ControllerId](uint32 InRequestId)
+		{
+			IOnlineFriendsPtr FriendsInterface = FAdvancedOnlineRequestScheduler::Get().GetFriendsInterface();
+
+			if (!WeakThis.IsValid() || !FriendsInterface.IsValid() || !WeakThis->cUniqueNetId.IsValid())
+				return false;
+
+			WeakThis->RequestId = InRequestId;
+			return FriendsInterface->SendInvite(ControllerId, *WeakThis->cUniqueNetId.GetUniqueNetId(), EFriendsLists::ToString((EFriendsLists::Default)), WeakThis->OnSendInviteCompleteDelegate);
+		};
+
+		// OnRequestFinished will get called, nothing more to do now
+		FAdvancedOnlineRequestScheduler::Get().Submit(MoveTemp(Request));
 		return;
 	}
 	// Fail immediately
@@ -61,13 +82,22 @@ void USendFriendInviteCallbackProxy::Activate()
 
 void USendFriendInviteCallbackProxy::OnSendInviteComplete(int32 LocalPlayerNum, bool bWasSuccessful, const FUniqueNetId &InvitedPlayer, const FString &ListName, const FString &ErrorString)
 {
-	if ( bWasSuccessful )
+	if (!bWasSuccessful)
+	{
+		UE_LOG(AdvancedSendFriendInviteLog, Warning, TEXT("SendFriendInvite Failed with error: %s"), *ErrorString);
+	}
+
+	FAdvancedOnlineRequestScheduler::Get().Complete(RequestId, bWasSuccessful);
+}
+
+void USendFriendInviteCallbackProxy::OnRequestFinished(EAdvancedOnlineRequestResult Result)
+{
+	if (Result == EAdvancedOnlineRequestResult::Success)
 	{ 
 		OnSuccess.Broadcast();
 	}
 	else
 	{
-		UE_LOG(AdvancedSendFriendInviteLog, Warning, TEXT("SendFriendInvite Failed with error: %s"), *ErrorString);
 		OnFailure.Broadcast();
 	}
 }
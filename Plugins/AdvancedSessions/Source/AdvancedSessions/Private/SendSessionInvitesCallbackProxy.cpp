@@ -0,0 +1,93 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+#include "SendSessionInvitesCallbackProxy.h"
+
+
+//////////////////////////////////////////////////////////////////////////
+// USendSessionInvitesCallbackProxy
+
+USendSessionInvitesCallbackProxy::USendSessionInvitesCallbackProxy(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+}
+
+USendSessionInvitesCallbackProxy* USendSessionInvitesCallbackProxy::SendSessionInvites(UObject* WorldContextObject, APlayerController *PlayerController, const TArray<FBPUniqueNetId> &Recipients)
+{
+	USendSessionInvitesCallbackProxy* Proxy = NewObject<USendSessionInvitesCallbackProxy>();
+	Proxy->PlayerControllerWeakPtr = PlayerController;
+	Proxy->Recipients = Recipients;
+	Proxy->WorldContextObject = WorldContextObject;
+	return Proxy;
+}
+
+void USendSessionInvitesCallbackProxy::Activate()
+{
+	if (!PlayerControllerWeakPtr.IsValid())
+	{
+		// Fail immediately
+		UE_LOG(AdvancedSessionInviteLog, Warning, TEXT("SendSessionInvites Failed received a bad playercontroller!"));
+		OnFailure.Broadcast(TArray<FBPSessionInviteResult>());
+		return;
+	}
+
+	ULocalPlayer* Player = Cast<ULocalPlayer>(PlayerControllerWeakPtr->Player);
+
+	if (!Player)
+	{
+		// Fail immediately
+		UE_LOG(AdvancedSessionInviteLog, Warning, TEXT("SendSessionInvites Failed couldn't cast to ULocalPlayer!"));
+		OnFailure.Broadcast(TArray<FBPSessionInviteResult>());
+		return;
+	}
+
+	IOnlineSessionPtr Sessions = Online::GetSessionInterface();
+
+	if (!Sessions.IsValid() || !Sessions->GetNamedSession(NAME_GameSession))
+	{
+		// Fail immediately
+		UE_LOG(AdvancedSessionInviteLog, Warning, TEXT("SendSessionInvites Had no game session to invite to!"));
+		OnFailure.Broadcast(TArray<FBPSessionInviteResult>());
+		return;
+	}
+
+	TArray<FUniqueNetIdHandle> Handles;
+	Handles.Reserve(Recipients.Num());
+	for (const FBPUniqueNetId& Recipient : Recipients)
+	{
+		Handles.Add(Recipient.GetHandle());
+	}
+
+	const int32 NumQueued = FSessionInviteDispatcher::Get().Enqueue(Player->GetControllerId(), NAME_GameSession, Handles,
+		FOnSessionInvitesDispatched::CreateUObject(this, &USendSessionInvitesCallbackProxy::OnInvitesDispatched));
+
+	if (NumQueued == 0)
+	{
+		UE_LOG(AdvancedSessionInviteLog, Warning, TEXT("SendSessionInvites Had no valid recipients!"));
+		OnFailure.Broadcast(TArray<FBPSessionInviteResult>());
+	}
+}
+
+void USendSessionInvitesCallbackProxy::OnInvitesDispatched(const TArray<FSessionInviteResult>& Results)
+{
+	TArray<FBPSessionInviteResult> BPResults;
+	BPResults.Reserve(Results.Num());
+
+	bool bAllSent = true;
+	for (const FSessionInviteResult& Result : Results)
+	{
+		FBPSessionInviteResult& BPResult = BPResults.AddDefaulted_GetRef();
+		BPResult.Recipient.SetUniqueNetId(Result.Recipient);
+		BPResult.bSent = Result.bSent;
+		BPResult.Attempts = Result.Attempts;
+
+		bAllSent &= Result.bSent;
+	}
+
+	if (bAllSent)
+	{
+		OnSuccess.Broadcast(BPResults);
+	}
+	else
+	{
+		OnFailure.Broadcast(BPResults);
+	}
+}
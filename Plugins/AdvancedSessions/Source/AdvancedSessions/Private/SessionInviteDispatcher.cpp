@@ -0,0 +1,248 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+#include "SessionInviteDispatcher.h"
+
+#include "HAL/IConsoleManager.h"
+#include "OnlineSubsystem.h"
+#include "OnlineSubsystemUtils.h"
+
+DEFINE_LOG_CATEGORY(AdvancedSessionInviteLog);
+
+static TAutoConsoleVariable<int32> CVarInviteChunkSize(
+	TEXT("AdvancedSessions.Invites.ChunkSize"),
+	25,
+	TEXT("Most recipients sent in a single SendSessionInviteToFriends call."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarInviteRatePerSecond(
+	TEXT("AdvancedSessions.Invites.RatePerSecond"),
+	20.f,
+	TEXT("Invites per second the token bucket refills at."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarInviteBurst(
+	TEXT("AdvancedSessions.Invites.Burst"),
+	50,
+	TEXT("Size of the token bucket, how many invites can go out at once after a quiet period."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarInviteMaxAttempts(
+	TEXT("AdvancedSessions.Invites.MaxAttempts"),
+	4,
+	TEXT("Attempts per chunk before its recipients are reported as failed."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarInviteRetryBaseDelay(
+	TEXT("AdvancedSessions.Invites.RetryBaseDelay"),
+	1.f,
+	TEXT("Seconds before the first retry of a failed chunk, doubles with every further attempt."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarInviteRetryMaxDelay(
+	TEXT("AdvancedSessions.Invites.RetryMaxDelay"),
+	30.f,
+	TEXT("Longest wait between retries of a failed chunk."),
+	ECVF_Default);
+
+FSessionInviteDispatcher& FSessionInviteDispatcher::Get()
+{
+	static FSessionInviteDispatcher Dispatcher;
+	return Dispatcher;
+}
+
+FSessionInviteDispatcher::FSessionInviteDispatcher()
+	: NextBatchId(0)
+	, Tokens(0.0)
+	, LastRefillTime(0.0)
+{
+	Tokens = FMath::Max(1, CVarInviteBurst.GetValueOnGameThread());
+	LastRefillTime = FPlatformTime::Seconds();
+}
+
+int32 FSessionInviteDispatcher::Enqueue(int32 LocalUserNum, FName SessionName, const TArray<FUniqueNetIdHandle>& Recipients, const FOnSessionInvitesDispatched& OnDispatched)
+{
+	FBatch Batch;
+	Batch.LocalUserNum = LocalUserNum;
+	Batch.SessionName = SessionName;
+	Batch.ChunksRemaining = 0;
+	Batch.OnDispatched = OnDispatched;
+	Batch.Results.Reserve(Recipients.Num());
+
+	TSet<FUniqueNetIdHandle> Seen;
+	Seen.Reserve(Recipients.Num());
+
+	for (const FUniqueNetIdHandle& Recipient : Recipients)
+	{
+		bool bAlreadySeen = false;
+		Seen.Add(Recipient, &bAlreadySeen);
+
+		if (Recipient.IsValid() && !bAlreadySeen)
+		{
+			Batch.Results.AddDefaulted_GetRef().Recipient = Recipient;
+		}
+	}
+
+	if (Batch.Results.Num() == 0)
+		return 0;
+
+	const int32 BatchId = NextBatchId++;
+	const int32 ChunkSize = FMath::Max(1, CVarInviteChunkSize.GetValueOnGameThread());
+
+	for (int32 First = 0; First < Batch.Results.Num(); First += ChunkSize)
+	{
+		FChunk& Chunk = Chunks.AddDefaulted_GetRef();
+		Chunk.BatchId = BatchId;
+		Chunk.Attempts = 0;
+		Chunk.NextAttemptTime = 0.0;
+
+		const int32 Last = FMath::Min(First + ChunkSize, Batch.Results.Num());
+		for (int32 i = First; i < Last; ++i)
+		{
+			Chunk.ResultIndices.Add(i);
+		}
+
+		Batch.ChunksRemaining++;
+	}
+
+	const int32 NumQueued = Batch.Results.Num();
+	UE_LOG(AdvancedSessionInviteLog, Verbose, TEXT("Queued %d session invites in %d chunks"), NumQueued, Batch.ChunksRemaining);
+
+	Batches.Add(BatchId, MoveTemp(Batch));
+
+	if (!TickerHandle.IsValid())
+	{
+		TickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FSessionInviteDispatcher::Tick));
+	}
+
+	return NumQueued;
+}
+
+int32 FSessionInviteDispatcher::GetNumPending() const
+{
+	int32 NumPending = 0;
+	for (const FChunk& Chunk : Chunks)
+	{
+		NumPending += Chunk.ResultIndices.Num();
+	}
+	return NumPending;
+}
+
+void FSessionInviteDispatcher::RefillTokens(double Now)
+{
+	const double Burst = FMath::Max(1, CVarInviteBurst.GetValueOnGameThread());
+	const double Rate = FMath::Max(0.01f, CVarInviteRatePerSecond.GetValueOnGameThread());
+
+	Tokens = FMath::Min(Burst, Tokens + (Now - LastRefillTime) * Rate);
+	LastRefillTime = Now;
+}
+
+bool FSessionInviteDispatcher::Tick(float DeltaTime)
+{
+	const double Now = FPlatformTime::Seconds();
+	RefillTokens(Now);
+
+	const int32 Burst = FMath::Max(1, CVarInviteBurst.GetValueOnGameThread());
+	const int32 MaxAttempts = FMath::Max(1, CVarInviteMaxAttempts.GetValueOnGameThread());
+
+	for (int32 i = 0; i < Chunks.Num(); )
+	{
+		FChunk& Chunk = Chunks[i];
+
+		// Waiting out a backoff, later chunks can still use the tokens
+		if (Chunk.NextAttemptTime > Now)
+		{
+			++i;
+			continue;
+		}
+
+		// A chunk bigger than the bucket only has to wait for a full bucket
+		const double Cost = FMath::Min(Chunk.ResultIndices.Num(), Burst);
+		if (Tokens < Cost)
+			break;
+
+		// The backend counts the call whether it works or not
+		Tokens -= Cost;
+		Chunk.Attempts++;
+
+		FBatch* Batch = Batches.Find(Chunk.BatchId);
+		bool bPermanentFailure = false;
+		const bool bSent = Batch && SendChunk(Chunk, *Batch, bPermanentFailure);
+
+		if (!bSent && Batch && !bPermanentFailure && Chunk.Attempts < MaxAttempts)
+		{
+			const float Delay = FMath::Min(CVarInviteRetryBaseDelay.GetValueOnGameThread() * FMath::Pow(2.f, (float)(Chunk.Attempts - 1)), CVarInviteRetryMaxDelay.GetValueOnGameThread());
+			Chunk.NextAttemptTime = Now + FMath::Max(0.f, Delay * FMath::FRandRange(0.8f, 1.2f));
+
+			UE_LOG(AdvancedSessionInviteLog, Warning, TEXT("Session invite chunk of %d failed (attempt %d), retrying in %.2fs"), Chunk.ResultIndices.Num(), Chunk.Attempts, Chunk.NextAttemptTime - Now);
+			++i;
+			continue;
+		}
+
+		// Finishing can run user code that queues more, so take the chunk out first
+		FChunk Done = MoveTemp(Chunk);
+		Chunks.RemoveAt(i);
+		FinishChunk(Done, bSent);
+	}
+
+	if (Chunks.Num() == 0)
+	{
+		TickerHandle.Reset();
+		return false;
+	}
+
+	return true;
+}
+
+bool FSessionInviteDispatcher::SendChunk(const FChunk& Chunk, FBatch& Batch, bool& bOutPermanentFailure)
+{
+	IOnlineSessionPtr SessionInterface = Online::GetSessionInterface();
+
+	if (!SessionInterface.IsValid())
+	{
+		UE_LOG(AdvancedSessionInviteLog, Warning, TEXT("SendSessionInvites Failed to get session interface!"));
+		return false;
+	}
+
+	// No point retrying invites to a session that isn't there
+	if (!SessionInterface->GetNamedSession(Batch.SessionName))
+	{
+		UE_LOG(AdvancedSessionInviteLog, Warning, TEXT("SendSessionInvites Failed, no session named %s!"), *Batch.SessionName.ToString());
+		bOutPermanentFailure = true;
+		return false;
+	}
+
+	TArray<TSharedRef<const FUniqueNetId>> List;
+	List.Reserve(Chunk.ResultIndices.Num());
+
+	for (int32 ResultIndex : Chunk.ResultIndices)
+	{
+		TSharedPtr<const FUniqueNetId> Recipient = Batch.Results[ResultIndex].Recipient.GetShared();
+		if (Recipient.IsValid())
+		{
+			List.Add(Recipient.ToSharedRef());
+		}
+	}
+
+	return SessionInterface->SendSessionInviteToFriends(Batch.LocalUserNum, Batch.SessionName, List);
+}
+
+void FSessionInviteDispatcher::FinishChunk(const FChunk& Chunk, bool bSent)
+{
+	FBatch* Batch = Batches.Find(Chunk.BatchId);
+	if (!Batch)
+		return;
+
+	for (int32 ResultIndex : Chunk.ResultIndices)
+	{
+		FSessionInviteResult& Result = Batch->Results[ResultIndex];
+		Result.bSent = bSent;
+		Result.Attempts = Chunk.Attempts;
+	}
+
+	if (--Batch->ChunksRemaining > 0)
+		return;
+
+	FBatch Finished = MoveTemp(*Batch);
+	Batches.Remove(Chunk.BatchId);
+
+	Finished.OnDispatched.ExecuteIfBound(Finished.Results);
+}
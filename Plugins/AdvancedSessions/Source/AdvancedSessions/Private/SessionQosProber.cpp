@@ -0,0 +1,434 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+#include "SessionQosProber.h"
+
+#include "Misc/QueuedThreadPool.h"
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+
+DEFINE_LOG_CATEGORY(AdvancedSessionQosLog);
+
+namespace SessionQos
+{
+	// Tag at the front of every probe so stray traffic on the port is ignored
+	static const uint32 ProbeMagic = 0x4E545153; // 'NTQS'
+	static const int32 ProbeSize = sizeof(uint32) * 3;
+
+	// Threads in the pool every prober shares
+	static const int32 PoolThreads = 4;
+}
+
+// One probe round against a single host, runs on a pool thread and deletes itself when done
+class FSessionQosProbeWork : public IQueuedWork
+{
+public:
+
+	FSessionQosProbeWork(const FString& InKey, const TSharedRef<FInternetAddr>& InAddress, int32 InNumPings, float InTimeoutSeconds, uint32 InNonce, const TSharedRef<FSessionQosProbeState, ESPMode::ThreadSafe>& InState)
+		: Key(InKey)
+		, Address(InAddress)
+		, NumPings(InNumPings)
+		, TimeoutSeconds(InTimeoutSeconds)
+		, Nonce(InNonce)
+		, Generation(InState->Generation.GetValue())
+		, State(InState)
+	{
+	}
+
+	virtual void DoThreadedWork() override
+	{
+		// Targets were cleared or the prober is gone while this waited in the pool's queue
+		if (State->Generation.GetValue() != Generation)
+		{
+			delete this;
+			return;
+		}
+
+		FSessionQosProbeResult Result;
+		Result.Key = Key;
+		Result.Generation = Generation;
+
+		ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+		FSocket* Socket = SocketSubsystem ? SocketSubsystem->CreateSocket(NAME_DGram, TEXT("SessionQosProbe"), true) : nullptr;
+
+		if (Socket)
+		{
+			Socket->SetNonBlocking(true);
+			TSharedRef<FInternetAddr> FromAddr = SocketSubsystem->CreateInternetAddr();
+
+			for (int32 Seq = 0; Seq < NumPings; ++Seq)
+			{
+				uint8 Packet[SessionQos::ProbeSize];
+				WritePacket(Packet, Seq);
+
+				int32 BytesSent = 0;
+				const double SendTime = FPlatformTime::Seconds();
+				if (!Socket->SendTo(Packet, SessionQos::ProbeSize, BytesSent, *Address) || BytesSent != SessionQos::ProbeSize)
+				{
+					continue;
+				}
+				Result.Sent++;
+
+				// Keep reading until our echo shows up or the timeout runs out, late echoes of earlier pings are dropped
+				const double Deadline = SendTime + TimeoutSeconds;
+				double Now = SendTime;
+				while (Now < Deadline)
+				{
+					if (!Socket->Wait(ESocketWaitConditions::WaitForRead, FTimespan::FromSeconds(Deadline - Now)))
+						break;
+
+					uint8 Reply[SessionQos::ProbeSize];
+					int32 BytesRead = 0;
+					Now = FPlatformTime::Seconds();
+
+					if (Socket->RecvFrom(Reply, SessionQos::ProbeSize, BytesRead, *FromAddr) && BytesRead == SessionQos::ProbeSize && IsReplyFor(Reply, Seq))
+					{
+						Result.Received++;
+						Result.RttSamplesMs.Add((float)((Now - SendTime) * 1000.0));
+						break;
+					}
+				}
+			}
+
+			Socket->Close();
+			SocketSubsystem->DestroySocket(Socket);
+		}
+		else
+		{
+			// Count the whole round as lost so a broken host doesn't float to the top
+			Result.Sent = NumPings;
+		}
+
+		State->Results.Enqueue(MoveTemp(Result));
+		delete this;
+	}
+
+	virtual void Abandon() override
+	{
+		delete this;
+	}
+
+private:
+
+	void WritePacket(uint8* Packet, int32 Seq) const
+	{
+		const uint32 Fields[3] = { SessionQos::ProbeMagic, Nonce, (uint32)Seq };
+		FMemory::Memcpy(Packet, Fields, SessionQos::ProbeSize);
+	}
+
+	bool IsReplyFor(const uint8* Reply, int32 Seq) const
+	{
+		uint32 Fields[3];
+		FMemory::Memcpy(Fields, Reply, SessionQos::ProbeSize);
+		return Fields[0] == SessionQos::ProbeMagic && Fields[1] == Nonce && Fields[2] == (uint32)Seq;
+	}
+
+	FString Key;
+	TSharedRef<FInternetAddr> Address;
+	int32 NumPings;
+	float TimeoutSeconds;
+	uint32 Nonce;
+	int32 Generation;
+	TSharedRef<FSessionQosProbeState, ESPMode::ThreadSafe> State;
+};
+
+FQueuedThreadPool* FSessionQosProber::Pool = nullptr;
+
+FQueuedThreadPool* FSessionQosProber::GetPool()
+{
+	if (!Pool && FPlatformProcess::SupportsMultithreading())
+	{
+		Pool = FQueuedThreadPool::Allocate();
+		if (!Pool->Create(SessionQos::PoolThreads, 32 * 1024, TPri_BelowNormal))
+		{
+			UE_LOG(AdvancedSessionQosLog, Warning, TEXT("Failed to create the session QoS probe pool"));
+			delete Pool;
+			Pool = nullptr;
+		}
+	}
+
+	return Pool;
+}
+
+void FSessionQosProber::ShutdownPool()
+{
+	if (Pool)
+	{
+		Pool->Destroy();
+		delete Pool;
+		Pool = nullptr;
+	}
+}
+
+FSessionQosProber::FSessionQosProber(const FSessionQosSettings& InSettings)
+	: Settings(InSettings)
+	, State(MakeShared<FSessionQosProbeState, ESPMode::ThreadSafe>())
+	, NumInFlight(0)
+	, NextNonce(FMath::Rand())
+	, bRunning(false)
+{
+	Settings.MaxConcurrentProbes = FMath::Max(1, Settings.MaxConcurrentProbes);
+	Settings.PingsPerRound = FMath::Max(1, Settings.PingsPerRound);
+	Settings.SmoothingFactor = FMath::Clamp(Settings.SmoothingFactor, 0.01f, 1.f);
+}
+
+FSessionQosProber::~FSessionQosProber()
+{
+	Stop();
+
+	// Our rounds still queued in the shared pool skip probing, ones mid round finish into the state nobody reads
+	State->Generation.Increment();
+}
+
+void FSessionQosProber::AddTarget(const FString& Key, const TSharedRef<FInternetAddr>& Address)
+{
+	if (FQosTarget* Existing = Targets.Find(Key))
+	{
+		if (!(*Existing->Address == *Address))
+		{
+			Existing->Address = Address;
+			Existing->Stats = FBPSessionQosStats();
+		}
+		return;
+	}
+
+	Targets.Add(Key, FQosTarget(Address));
+}
+
+bool FSessionQosProber::AddSearchResult(const FBlueprintSessionResult& SearchResult, int32 ProbePort)
+{
+	if (!SearchResult.OnlineResult.IsValid())
+		return false;
+
+	IOnlineSessionPtr Sessions = Online::GetSessionInterface();
+	ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+
+	if (!Sessions.IsValid() || !SocketSubsystem)
+	{
+		UE_LOG(AdvancedSessionQosLog, Warning, TEXT("AddSearchResult Failed to get the session interface or socket subsystem!"));
+		return false;
+	}
+
+	FString ConnectString;
+	if (!Sessions->GetResolvedConnectString(SearchResult.OnlineResult, NAME_GamePort, ConnectString))
+		return false;
+
+	FString Host = ConnectString;
+	FString PortString;
+	ConnectString.Split(TEXT(":"), &Host, &PortString, ESearchCase::IgnoreCase, ESearchDir::FromEnd);
+
+	bool bIsValid = false;
+	TSharedRef<FInternetAddr> Address = SocketSubsystem->CreateInternetAddr();
+	Address->SetIp(*Host, bIsValid);
+
+	if (!bIsValid)
+	{
+		UE_LOG(AdvancedSessionQosLog, Warning, TEXT("AddSearchResult could not resolve host from %s"), *ConnectString);
+		return false;
+	}
+
+	Address->SetPort(ProbePort > 0 ? ProbePort : FCString::Atoi(*PortString));
+	AddTarget(SearchResult.OnlineResult.GetSessionIdStr(), Address);
+	return true;
+}
+
+void FSessionQosProber::RemoveTarget(const FString& Key)
+{
+	const FQosTarget* Target = Targets.Find(Key);
+	if (!Target)
+		return;
+
+	// Its round still comes back but finds no target, so it stops counting now
+	if (Target->bInFlight)
+	{
+		--NumInFlight;
+	}
+
+	Targets.Remove(Key);
+}
+
+void FSessionQosProber::ClearTargets()
+{
+	Targets.Empty();
+	NumInFlight = 0;
+	State->Generation.Increment();
+}
+
+void FSessionQosProber::Start()
+{
+	if (bRunning)
+		return;
+
+	if (!FPlatformProcess::SupportsMultithreading())
+	{
+		UE_LOG(AdvancedSessionQosLog, Warning, TEXT("Session QoS probing needs multithreading, not starting"));
+		return;
+	}
+
+	if (!GetPool())
+		return;
+
+	bRunning = true;
+}
+
+void FSessionQosProber::Stop()
+{
+	bRunning = false;
+}
+
+bool FSessionQosProber::GetStats(const FString& Key, FBPSessionQosStats& OutStats) const
+{
+	if (const FQosTarget* Target = Targets.Find(Key))
+	{
+		OutStats = Target->Stats;
+		return true;
+	}
+
+	return false;
+}
+
+bool FSessionQosProber::HasProbedAllTargets() const
+{
+	for (const TPair<FString, FQosTarget>& Pair : Targets)
+	{
+		if (Pair.Value.Stats.ProbesSent == 0)
+			return false;
+	}
+
+	return true;
+}
+
+void FSessionQosProber::RankResults(TArray<FBlueprintSessionResult>& SearchResults) const
+{
+	// Score once up front rather than doing map lookups inside the sort predicate
+	TArray<TPair<float, int32>> Scores;
+	Scores.Reserve(SearchResults.Num());
+
+	for (int32 i = 0; i < SearchResults.Num(); ++i)
+	{
+		FOnlineSessionSearchResult& Result = SearchResults[i].OnlineResult;
+		float Score = (float)Result.PingInMs;
+
+		if (const FQosTarget* Target = Targets.Find(Result.GetSessionIdStr()))
+		{
+			if (Target->Stats.HasSamples())
+			{
+				Result.PingInMs = FMath::RoundToInt(Target->Stats.SmoothedRttMs);
+				Score = Target->Stats.GetScore(Settings.LossPenaltyMs);
+			}
+			else if (Target->Stats.ProbesSent > 0)
+			{
+				// Probed but never answered, rank below everything that did
+				Score = MAX_flt;
+			}
+		}
+
+		Scores.Emplace(Score, i);
+	}
+
+	Scores.StableSort([](const TPair<float, int32>& A, const TPair<float, int32>& B)
+	{
+		return A.Key < B.Key;
+	});
+
+	TArray<FBlueprintSessionResult> Ranked;
+	Ranked.Reserve(SearchResults.Num());
+	for (const TPair<float, int32>& Score : Scores)
+	{
+		Ranked.Add(MoveTemp(SearchResults[Score.Value]));
+	}
+
+	SearchResults = MoveTemp(Ranked);
+}
+
+bool FSessionQosProber::Tick(float DeltaTime)
+{
+	bool bUpdated = false;
+
+	FSessionQosProbeResult Result;
+	while (State->Results.Dequeue(Result))
+	{
+		// From targets that were cleared since
+		if (Result.Generation != State->Generation.GetValue())
+			continue;
+
+		ApplyResult(Result);
+		bUpdated = true;
+	}
+
+	if (bRunning)
+	{
+		DispatchRounds(FPlatformTime::Seconds());
+	}
+
+	if (bUpdated)
+	{
+		OnQosUpdated.Broadcast();
+	}
+
+	return true;
+}
+
+void FSessionQosProber::ApplyResult(const FSessionQosProbeResult& Result)
+{
+	FQosTarget* Target = Targets.Find(Result.Key);
+
+	// Target was removed while the round was in flight
+	if (!Target)
+		return;
+
+	if (Target->bInFlight)
+	{
+		Target->bInFlight = false;
+		--NumInFlight;
+	}
+
+	if (Result.Sent <= 0)
+		return;
+
+	FBPSessionQosStats& Stats = Target->Stats;
+	const float Alpha = Settings.SmoothingFactor;
+
+	for (float Sample : Result.RttSamplesMs)
+	{
+		if (Stats.SmoothedRttMs < 0.f)
+		{
+			Stats.SmoothedRttMs = Sample;
+			Stats.RttDeviationMs = Sample * 0.5f;
+		}
+		else
+		{
+			Stats.RttDeviationMs = (1.f - Alpha) * Stats.RttDeviationMs + Alpha * FMath::Abs(Sample - Stats.SmoothedRttMs);
+			Stats.SmoothedRttMs = (1.f - Alpha) * Stats.SmoothedRttMs + Alpha * Sample;
+		}
+	}
+
+	const float RoundLoss = 1.f - ((float)Result.Received / (float)Result.Sent);
+	Stats.LossRatio = Stats.ProbesSent == 0 ? RoundLoss : (1.f - Alpha) * Stats.LossRatio + Alpha * RoundLoss;
+
+	Stats.ProbesSent += Result.Sent;
+	Stats.ProbesReceived += Result.Received;
+}
+
+void FSessionQosProber::DispatchRounds(double Now)
+{
+	FQueuedThreadPool* ProbePool = GetPool();
+	if (!ProbePool)
+		return;
+
+	for (TPair<FString, FQosTarget>& Pair : Targets)
+	{
+		if (NumInFlight >= Settings.MaxConcurrentProbes)
+			break;
+
+		FQosTarget& Target = Pair.Value;
+
+		if (Target.bInFlight || (Target.LastRoundTime > 0.0 && Now - Target.LastRoundTime < Settings.RoundIntervalSeconds))
+			continue;
+
+		Target.bInFlight = true;
+		Target.LastRoundTime = Now;
+		++NumInFlight;
+
+		// Rounds from every prober share the pool's threads, anything past that waits in its queue
+		ProbePool->AddQueuedWork(new FSessionQosProbeWork(Pair.Key, Target.Address, Settings.PingsPerRound, Settings.PingTimeoutSeconds, NextNonce++, State));
+	}
+}
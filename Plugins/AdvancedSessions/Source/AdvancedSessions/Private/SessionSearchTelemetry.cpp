@@ -0,0 +1,126 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+#include "SessionSearchTelemetry.h"
+
+#include "HAL/IConsoleManager.h"
+
+DEFINE_LOG_CATEGORY(AdvancedSessionSearchTelemetryLog);
+
+static TAutoConsoleVariable<int32> CVarSearchTelemetry(
+	TEXT("AdvancedSessions.SearchTelemetry"),
+	1,
+	TEXT("Collect session search telemetry (counts, latency and result size histograms).\n")
+	TEXT("0: off, 1: on"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarSearchTelemetrySampleRate(
+	TEXT("AdvancedSessions.SearchTelemetry.SampleRate"),
+	10,
+	TEXT("Write a summary log line for one in every N session searches, 0 disables the log lines but keeps the counters."),
+	ECVF_Default);
+
+const int32 FSessionSearchTelemetry::LatencyBucketMs[SEARCH_TELEMETRY_LATENCY_BUCKETS - 1] = { 50, 100, 250, 500, 1000, 2000, 5000 };
+const int32 FSessionSearchTelemetry::ResultCountBucket[SEARCH_TELEMETRY_RESULT_BUCKETS - 1] = { 0, 4, 16, 64, 256, 1024 };
+
+namespace SearchTelemetry
+{
+	static FSessionSearchTelemetrySnapshot Counters;
+
+	template<int32 NumBounds>
+	static int32 GetBucket(const int32 (&Bounds)[NumBounds], int64 Value)
+	{
+		for (int32 i = 0; i < NumBounds; ++i)
+		{
+			if (Value <= Bounds[i])
+				return i;
+		}
+		return NumBounds;
+	}
+}
+
+bool FSessionSearchTelemetry::IsEnabled()
+{
+	return CVarSearchTelemetry.GetValueOnGameThread() != 0;
+}
+
+void FSessionSearchTelemetry::RecordSearch(bool bSuccess, double LatencySeconds, const TArray<FOnlineSessionSearchResult>& Results)
+{
+	if (!IsEnabled())
+		return;
+
+	FSessionSearchTelemetrySnapshot& Counters = SearchTelemetry::Counters;
+	const int32 NumResults = Results.Num();
+
+	Counters.NumSearches++;
+	Counters.NumFailed += bSuccess ? 0 : 1;
+	Counters.TotalResults += NumResults;
+	Counters.TotalLatencySeconds += LatencySeconds;
+	Counters.MaxLatencySeconds = FMath::Max(Counters.MaxLatencySeconds, LatencySeconds);
+
+	Counters.LatencyHistogram[SearchTelemetry::GetBucket(LatencyBucketMs, (int64)(LatencySeconds * 1000.0))]++;
+	Counters.ResultCountHistogram[SearchTelemetry::GetBucket(ResultCountBucket, NumResults)]++;
+
+	const int32 SampleRate = CVarSearchTelemetrySampleRate.GetValueOnGameThread();
+	if (SampleRate > 0 && (Counters.NumSearches % SampleRate) == 1 % SampleRate)
+	{
+		int32 MinPing = MAX_int32;
+		int32 MaxPing = 0;
+		for (const FOnlineSessionSearchResult& Result : Results)
+		{
+			MinPing = FMath::Min(MinPing, Result.PingInMs);
+			MaxPing = FMath::Max(MaxPing, Result.PingInMs);
+		}
+
+		UE_LOG(AdvancedSessionSearchTelemetryLog, Log, TEXT("Session search #%d %s: %d results in %.1fms, ping %d-%d"),
+			Counters.NumSearches, bSuccess ? TEXT("succeeded") : TEXT("failed"), NumResults, LatencySeconds * 1000.0, NumResults > 0 ? MinPing : 0, MaxPing);
+	}
+}
+
+void FSessionSearchTelemetry::GetSnapshot(FSessionSearchTelemetrySnapshot& OutSnapshot)
+{
+	OutSnapshot = SearchTelemetry::Counters;
+}
+
+void FSessionSearchTelemetry::Reset()
+{
+	SearchTelemetry::Counters = FSessionSearchTelemetrySnapshot();
+}
+
+void FSessionSearchTelemetry::Dump(FOutputDevice& Ar)
+{
+	const FSessionSearchTelemetrySnapshot& Counters = SearchTelemetry::Counters;
+
+	Ar.Logf(TEXT("Session searches: %d (%d failed), %lld results, avg latency %.1fms, max latency %.1fms"),
+		Counters.NumSearches,
+		Counters.NumFailed,
+		Counters.TotalResults,
+		Counters.NumSearches > 0 ? (Counters.TotalLatencySeconds * 1000.0) / Counters.NumSearches : 0.0,
+		Counters.MaxLatencySeconds * 1000.0);
+
+	Ar.Logf(TEXT("Latency histogram:"));
+	for (int32 i = 0; i < SEARCH_TELEMETRY_LATENCY_BUCKETS; ++i)
+	{
+		if (i < SEARCH_TELEMETRY_LATENCY_BUCKETS - 1)
+			Ar.Logf(TEXT("  <= %5dms: %d"), LatencyBucketMs[i], Counters.LatencyHistogram[i]);
+		else
+			Ar.Logf(TEXT("  >  %5dms: %d"), LatencyBucketMs[i - 1], Counters.LatencyHistogram[i]);
+	}
+
+	Ar.Logf(TEXT("Result count histogram:"));
+	for (int32 i = 0; i < SEARCH_TELEMETRY_RESULT_BUCKETS; ++i)
+	{
+		if (i < SEARCH_TELEMETRY_RESULT_BUCKETS - 1)
+			Ar.Logf(TEXT("  <= %5d: %d"), ResultCountBucket[i], Counters.ResultCountHistogram[i]);
+		else
+			Ar.Logf(TEXT("  >  %5d: %d"), ResultCountBucket[i - 1], Counters.ResultCountHistogram[i]);
+	}
+}
+
+static FAutoConsoleCommandWithOutputDevice DumpSearchTelemetryCommand(
+	TEXT("AdvancedSessions.DumpSearchTelemetry"),
+	TEXT("Prints the collected session search telemetry"),
+	FConsoleCommandWithOutputDeviceDelegate::CreateStatic(&FSessionSearchTelemetry::Dump));
+
+static FAutoConsoleCommand ResetSearchTelemetryCommand(
+	TEXT("AdvancedSessions.ResetSearchTelemetry"),
+	TEXT("Clears the collected session search telemetry"),
+	FConsoleCommandDelegate::CreateStatic(&FSessionSearchTelemetry::Reset));
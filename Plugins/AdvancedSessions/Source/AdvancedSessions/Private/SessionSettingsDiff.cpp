@@ -0,0 +1,274 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+#include "SessionSettingsDiff.h"
+
+#include "HAL/IConsoleManager.h"
+
+DEFINE_LOG_CATEGORY(AdvancedSessionUpdateLog);
+
+static TAutoConsoleVariable<float> CVarUpdateSessionCoalesceWindow(
+	TEXT("AdvancedSessions.UpdateSessionCoalesceWindow"),
+	0.f,
+	TEXT("Seconds to collect UpdateSession requests before sending them as one update.\n")
+	TEXT("0 sends straight away, requests made while an update is in flight are still merged."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarUpdateSessionTimeout(
+	TEXT("AdvancedSessions.UpdateSessionTimeout"),
+	30.f,
+	TEXT("Seconds to wait for an UpdateSession to complete before failing its requests and sending the next batch.\n")
+	TEXT("0 waits forever."),
+	ECVF_Default);
+
+void FSessionSettingsUpdate::Merge(const FSessionSettingsUpdate& Newer)
+{
+	NumPublicConnections = Newer.NumPublicConnections;
+	NumPrivateConnections = Newer.NumPrivateConnections;
+	bUseLAN = Newer.bUseLAN;
+	bAllowInvites = Newer.bAllowInvites;
+	bAllowJoinInProgress = Newer.bAllowJoinInProgress;
+	bIsDedicated = Newer.bIsDedicated;
+
+	// If any of the merged requests wanted the online data refreshed then the batch does
+	bRefreshOnlineData |= Newer.bRefreshOnlineData;
+
+	for (const FSessionPropertyKeyPair& Property : Newer.ExtraSettings.Properties)
+	{
+		ExtraSettings.AddOrModify(Property.Key, Property.Data);
+	}
+}
+
+FSessionSettingsDiff FSessionSettingsDiff::Compute(const FOnlineSessionSettings& Current, const FSessionSettingsUpdate& Requested)
+{
+	FSessionSettingsDiff Diff;
+
+	Diff.ChangedFields |= Current.NumPublicConnections != Requested.NumPublicConnections ? PublicConnections : 0;
+	Diff.ChangedFields |= Current.NumPrivateConnections != Requested.NumPrivateConnections ? PrivateConnections : 0;
+	Diff.ChangedFields |= Current.bIsLANMatch != Requested.bUseLAN ? LANMatch : 0;
+	Diff.ChangedFields |= Current.bAllowInvites != Requested.bAllowInvites ? AllowInvites : 0;
+	Diff.ChangedFields |= Current.bAllowJoinInProgress != Requested.bAllowJoinInProgress ? AllowJoinInProgress : 0;
+	Diff.ChangedFields |= Current.bIsDedicated != Requested.bIsDedicated ? Dedicated : 0;
+
+	// Core fields are all part of the advertised session
+	Diff.bNeedsOnlineRefresh = Diff.ChangedFields != 0;
+
+	for (const FSessionPropertyKeyPair& Property : Requested.ExtraSettings.Properties)
+	{
+		const FOnlineSessionSetting* Existing = Current.Settings.Find(Property.Key);
+
+		if (!Existing)
+		{
+			Diff.ChangedKeys.Add(Property.Key);
+			Diff.bNeedsOnlineRefresh = true;
+		}
+		else if (!(Existing->Data == Property.Data))
+		{
+			Diff.ChangedKeys.Add(Property.Key);
+			Diff.bNeedsOnlineRefresh |= Existing->AdvertisementType != EOnlineDataAdvertisementType::DontAdvertise;
+		}
+	}
+
+	return Diff;
+}
+
+void FSessionSettingsDiff::Apply(FOnlineSessionSettings& Current, const FSessionSettingsUpdate& Requested) const
+{
+	if (ChangedFields & PublicConnections)
+		Current.NumPublicConnections = Requested.NumPublicConnections;
+	if (ChangedFields & PrivateConnections)
+		Current.NumPrivateConnections = Requested.NumPrivateConnections;
+	if (ChangedFields & LANMatch)
+		Current.bIsLANMatch = Requested.bUseLAN;
+	if (ChangedFields & AllowInvites)
+		Current.bAllowInvites = Requested.bAllowInvites;
+	if (ChangedFields & AllowJoinInProgress)
+		Current.bAllowJoinInProgress = Requested.bAllowJoinInProgress;
+	if (ChangedFields & Dedicated)
+		Current.bIsDedicated = Requested.bIsDedicated;
+
+	for (const FName& Key : ChangedKeys)
+	{
+		const FVariantData* Data = Requested.ExtraSettings.Find(Key);
+		check(Data);
+
+		if (FOnlineSessionSetting* Existing = Current.Settings.Find(Key))
+		{
+			Existing->Data = *Data;
+		}
+		else
+		{
+			FOnlineSessionSetting ExtraSetting;
+			ExtraSetting.Data = *Data;
+			ExtraSetting.AdvertisementType = EOnlineDataAdvertisementType::ViaOnlineService;
+			Current.Settings.Add(Key, ExtraSetting);
+		}
+	}
+}
+
+FSessionUpdateCoalescer& FSessionUpdateCoalescer::Get()
+{
+	static FSessionUpdateCoalescer Coalescer;
+	return Coalescer;
+}
+
+FSessionUpdateCoalescer::FSessionUpdateCoalescer()
+	: bHasPending(false)
+	, bWindowElapsed(false)
+	, bInFlight(false)
+{
+}
+
+void FSessionUpdateCoalescer::Submit(const FSessionSettingsUpdate& Update, const FOnSessionUpdateFlushed& OnFlushed)
+{
+	PendingWaiters.Add(OnFlushed);
+
+	if (bHasPending)
+	{
+		Pending.Merge(Update);
+		UE_LOG(AdvancedSessionUpdateLog, Verbose, TEXT("Merged session update into pending batch (%d requests)"), PendingWaiters.Num());
+		return;
+	}
+
+	Pending = Update;
+	bHasPending = true;
+	bWindowElapsed = false;
+
+	const float Window = CVarUpdateSessionCoalesceWindow.GetValueOnGameThread();
+	if (Window > 0.f)
+	{
+		WindowTickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FSessionUpdateCoalescer::OnWindowElapsed), Window);
+		return;
+	}
+
+	bWindowElapsed = true;
+	if (!bInFlight)
+	{
+		Flush();
+	}
+}
+
+bool FSessionUpdateCoalescer::OnWindowElapsed(float DeltaTime)
+{
+	WindowTickerHandle.Reset();
+	bWindowElapsed = true;
+
+	// If an update is still in flight this batch goes out when it completes
+	if (!bInFlight)
+	{
+		Flush();
+	}
+
+	// One shot
+	return false;
+}
+
+void FSessionUpdateCoalescer::Flush()
+{
+	if (!bHasPending)
+		return;
+
+	FSessionSettingsUpdate Update = MoveTemp(Pending);
+	TArray<FOnSessionUpdateFlushed> Waiters = MoveTemp(PendingWaiters);
+	Pending = FSessionSettingsUpdate();
+	PendingWaiters.Reset();
+	bHasPending = false;
+	bWindowElapsed = false;
+
+	IOnlineSessionPtr Sessions = Online::GetSessionInterface();
+	FOnlineSessionSettings* Settings = Sessions.IsValid() ? Sessions->GetSessionSettings(NAME_GameSession) : nullptr;
+
+	if (!Settings)
+	{
+		UE_LOG(AdvancedSessionUpdateLog, Warning, TEXT("UpdateSession Failed to get the game session settings!"));
+		NotifyWaiters(Waiters, false);
+		return;
+	}
+
+	const FSessionSettingsDiff Diff = FSessionSettingsDiff::Compute(*Settings, Update);
+
+	if (Diff.IsEmpty())
+	{
+		UE_LOG(AdvancedSessionUpdateLog, Verbose, TEXT("Skipping UpdateSession, nothing changed (%d requests)"), Waiters.Num());
+		NotifyWaiters(Waiters, true);
+		return;
+	}
+
+	Diff.Apply(*Settings, Update);
+
+	InFlightWaiters = MoveTemp(Waiters);
+	bInFlight = true;
+
+	UpdateCompleteDelegateHandle = Sessions->AddOnUpdateSessionCompleteDelegate_Handle(FOnUpdateSessionCompleteDelegate::CreateRaw(this, &FSessionUpdateCoalescer::OnUpdateSessionComplete));
+
+	// Some subsystems never fire the delegate, don't let that hold every later update back
+	const float Timeout = CVarUpdateSessionTimeout.GetValueOnGameThread();
+	if (Timeout > 0.f)
+	{
+		TimeoutTickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FSessionUpdateCoalescer::OnUpdateTimedOut), Timeout);
+	}
+
+	UE_LOG(AdvancedSessionUpdateLog, Verbose, TEXT("UpdateSession with %d changed fields and %d changed keys (%d requests)"), FMath::CountBits(Diff.ChangedFields), Diff.ChangedKeys.Num(), InFlightWaiters.Num());
+
+	// Non advertised changes don't need a round trip to the backend
+	if (!Sessions->UpdateSession(NAME_GameSession, *Settings, Update.bRefreshOnlineData && Diff.bNeedsOnlineRefresh))
+	{
+		// Some subsystems fail synchronously without firing the delegate
+		if (bInFlight)
+		{
+			OnUpdateSessionComplete(NAME_GameSession, false);
+		}
+	}
+}
+
+void FSessionUpdateCoalescer::OnUpdateSessionComplete(FName SessionName, bool bWasSuccessful)
+{
+	if (SessionName != NAME_GameSession)
+		return;
+
+	IOnlineSessionPtr Sessions = Online::GetSessionInterface();
+	if (Sessions.IsValid())
+	{
+		Sessions->ClearOnUpdateSessionCompleteDelegate_Handle(UpdateCompleteDelegateHandle);
+	}
+
+	if (TimeoutTickerHandle.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(TimeoutTickerHandle);
+		TimeoutTickerHandle.Reset();
+	}
+
+	bInFlight = false;
+
+	TArray<FOnSessionUpdateFlushed> Waiters = MoveTemp(InFlightWaiters);
+	InFlightWaiters.Reset();
+	NotifyWaiters(Waiters, bWasSuccessful);
+
+	// A batch that built up while we were waiting goes out now if its window is done
+	if (bHasPending && bWindowElapsed)
+	{
+		Flush();
+	}
+}
+
+bool FSessionUpdateCoalescer::OnUpdateTimedOut(float DeltaTime)
+{
+	TimeoutTickerHandle.Reset();
+
+	if (bInFlight)
+	{
+		UE_LOG(AdvancedSessionUpdateLog, Warning, TEXT("UpdateSession didn't complete in time, failing %d requests"), InFlightWaiters.Num());
+
+		// Clears the delegate so a late answer is ignored, and sends anything that queued up behind it
+		OnUpdateSessionComplete(NAME_GameSession, false);
+	}
+
+	// One shot
+	return false;
+}
+
+void FSessionUpdateCoalescer::NotifyWaiters(TArray<FOnSessionUpdateFlushed>& Waiters, bool bWasSuccessful)
+{
+	for (FOnSessionUpdateFlushed& Waiter : Waiters)
+	{
+		Waiter.ExecuteIfBound(bWasSuccessful);
+	}
+}
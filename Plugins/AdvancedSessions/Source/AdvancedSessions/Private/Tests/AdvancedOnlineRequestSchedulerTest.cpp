@@ -0,0 +1,200 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+#include "AdvancedFakeOnlineInterfaces.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace AdvancedOnlineRequestSchedulerTest
+{
+	// Sets a scheduler cvar for the length of a test
+	struct FScopedCVar
+	{
+		FScopedCVar(const TCHAR* Name, int32 Value)
+			: CVar(IConsoleManager::Get().FindConsoleVariable(Name))
+			, OldValue(0)
+		{
+			if (CVar)
+			{
+				OldValue = CVar->GetInt();
+				CVar->Set(Value, ECVF_SetByCode);
+			}
+		}
+
+		~FScopedCVar()
+		{
+			if (CVar)
+			{
+				CVar->Set(OldValue, ECVF_SetByCode);
+			}
+		}
+
+		IConsoleVariable* CVar;
+		int32 OldValue;
+	};
+
+	// A friends list read through whatever friends interface the scheduler hands out, Label goes in StartOrder when it starts
+	static uint32 SubmitRead(const FString& Label, EAdvancedOnlineRequestPriority Priority, const FString& DedupeKey, float Timeout,
+		TSharedRef<TArray<FString>> StartOrder, TSharedRef<TArray<EAdvancedOnlineRequestResult>> Results)
+	{
+		FAdvancedOnlineRequest Request;
+		Request.Interface = EAdvancedOnlineInterface::Friends;
+		Request.Priority = Priority;
+		Request.DedupeKey = DedupeKey;
+		Request.Timeout = Timeout;
+		Request.OnFinished = FOnAdvancedOnlineRequestFinished::CreateLambda([Results](EAdvancedOnlineRequestResult Result)
+		{
+			Results->Add(Result);
+		});
+		Request.Start = [Label, StartOrder](uint32 RequestId)
+		{
+			IOnlineFriendsPtr Friends = FAdvancedOnlineRequestScheduler::Get().GetFriendsInterface();
+			if (!Friends.IsValid())
+				return false;
+
+			StartOrder->Add(Label);
+			return Friends->ReadFriendsList(0, TEXT("default"), FOnReadFriendsListComplete::CreateLambda([RequestId](int32 LocalUserNum, bool bWasSuccessful, const FString& ListName, const FString& ErrorStr)
+			{
+				FAdvancedOnlineRequestScheduler::Get().Complete(RequestId, bWasSuccessful);
+			}));
+		};
+
+		return FAdvancedOnlineRequestScheduler::Get().Submit(MoveTemp(Request));
+	}
+
+	static FAdvancedFakeOnlineScript NeverAnswers()
+	{
+		FAdvancedFakeOnlineScript Script;
+		Script.AnswerDelay = -1.f;
+		return Script;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAdvancedOnlineRequestSchedulerQueueTest, "AdvancedSessions.RequestScheduler.Queue",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FAdvancedOnlineRequestSchedulerQueueTest::RunTest(const FString& Parameters)
+{
+	using namespace AdvancedOnlineRequestSchedulerTest;
+
+	FAdvancedOnlineRequestScheduler& Scheduler = FAdvancedOnlineRequestScheduler::Get();
+	Scheduler.CancelAll();
+
+	FAdvancedFakeOnlineInterfaces Fakes;
+	Fakes.Install();
+	Fakes.SetScript(TEXT("ReadFriendsList"), NeverAnswers());
+
+	TestTrue(TEXT("Scheduler hands out the fake friends interface"), Scheduler.GetFriendsInterface() == Fakes.GetFriendsInterface());
+
+	// Priority: with one slot, whatever waits runs highest priority first and then in submit order
+	{
+		FScopedCVar Cap(TEXT("AdvancedSessions.RequestScheduler.MaxConcurrent.Friends"), 1);
+		TSharedRef<TArray<FString>> StartOrder = MakeShared<TArray<FString>>();
+		TSharedRef<TArray<EAdvancedOnlineRequestResult>> Results = MakeShared<TArray<EAdvancedOnlineRequestResult>>();
+
+		SubmitRead(TEXT("First"), EAdvancedOnlineRequestPriority::Normal, FString(), 0.f, StartOrder, Results);
+		SubmitRead(TEXT("Low"), EAdvancedOnlineRequestPriority::Low, FString(), 0.f, StartOrder, Results);
+		SubmitRead(TEXT("Normal"), EAdvancedOnlineRequestPriority::Normal, FString(), 0.f, StartOrder, Results);
+		SubmitRead(TEXT("High"), EAdvancedOnlineRequestPriority::High, FString(), 0.f, StartOrder, Results);
+
+		// Each answer frees the slot and starts the next one straight away
+		for (int32 i = 0; i < 4; ++i)
+		{
+			Fakes.AnswerAllPending(true);
+		}
+
+		const TArray<FString> Expected = { TEXT("First"), TEXT("High"), TEXT("Normal"), TEXT("Low") };
+		TestEqual(TEXT("Start order follows priority"), *StartOrder, Expected);
+		TestEqual(TEXT("Every request finished"), Results->Num(), 4);
+	}
+
+	// Caps: never more running on an interface than its cap, the rest wait their turn
+	{
+		FScopedCVar Cap(TEXT("AdvancedSessions.RequestScheduler.MaxConcurrent.Friends"), 2);
+		TSharedRef<TArray<FString>> StartOrder = MakeShared<TArray<FString>>();
+		TSharedRef<TArray<EAdvancedOnlineRequestResult>> Results = MakeShared<TArray<EAdvancedOnlineRequestResult>>();
+		Fakes.ResetCalls();
+
+		for (int32 i = 0; i < 5; ++i)
+		{
+			SubmitRead(FString::Printf(TEXT("Capped%d"), i), EAdvancedOnlineRequestPriority::Normal, FString(), 0.f, StartOrder, Results);
+		}
+
+		TestEqual(TEXT("Calls running at the cap"), Fakes.GetNumPending(EAdvancedOnlineInterface::Friends), 2);
+		TestEqual(TEXT("The rest queued"), Scheduler.GetNumQueued(), 3);
+
+		for (int32 i = 0; i < 5 && Results->Num() < 5; ++i)
+		{
+			Fakes.AnswerAllPending(true);
+		}
+
+		TestEqual(TEXT("Every capped request finished"), Results->Num(), 5);
+		TestEqual(TEXT("Never more calls at once than the cap"), Fakes.GetMaxPending(EAdvancedOnlineInterface::Friends), 2);
+	}
+
+	// Dedupe: submitters with the same key share one call and all hear its answer
+	{
+		TSharedRef<TArray<FString>> StartOrder = MakeShared<TArray<FString>>();
+		TSharedRef<TArray<EAdvancedOnlineRequestResult>> Results = MakeShared<TArray<EAdvancedOnlineRequestResult>>();
+		Fakes.ResetCalls();
+
+		SubmitRead(TEXT("Shared"), EAdvancedOnlineRequestPriority::Normal, TEXT("ReadFriendsList:0"), 0.f, StartOrder, Results);
+		SubmitRead(TEXT("Shared"), EAdvancedOnlineRequestPriority::Normal, TEXT("ReadFriendsList:0"), 0.f, StartOrder, Results);
+		SubmitRead(TEXT("Shared"), EAdvancedOnlineRequestPriority::High, TEXT("ReadFriendsList:0"), 0.f, StartOrder, Results);
+
+		TestEqual(TEXT("One call for every submitter"), Fakes.GetNumCalls(TEXT("ReadFriendsList")), 1);
+
+		Fakes.AnswerAllPending(true);
+
+		TestEqual(TEXT("Every submitter heard back"), Results->Num(), 3);
+		TestTrue(TEXT("Every submitter succeeded"), !Results->Contains(EAdvancedOnlineRequestResult::Failure));
+	}
+
+	Scheduler.CancelAll();
+	Fakes.Uninstall();
+
+	TestFalse(TEXT("Uninstall goes back to the online subsystem"), Scheduler.GetFriendsInterface() == Fakes.GetFriendsInterface());
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAdvancedOnlineRequestSchedulerDeadlineTest, "AdvancedSessions.RequestScheduler.Deadline",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FAdvancedOnlineRequestSchedulerDeadlineTest::RunTest(const FString& Parameters)
+{
+	using namespace AdvancedOnlineRequestSchedulerTest;
+
+	FAdvancedOnlineRequestScheduler::Get().CancelAll();
+
+	// Shared with the latent command, the test function returns before the deadline passes
+	TSharedRef<FAdvancedFakeOnlineInterfaces> Fakes = MakeShared<FAdvancedFakeOnlineInterfaces>();
+	Fakes->Install();
+	Fakes->SetScript(TEXT("ReadFriendsList"), NeverAnswers());
+
+	TSharedRef<TArray<FString>> StartOrder = MakeShared<TArray<FString>>();
+	TSharedRef<TArray<EAdvancedOnlineRequestResult>> Results = MakeShared<TArray<EAdvancedOnlineRequestResult>>();
+	SubmitRead(TEXT("Deadline"), EAdvancedOnlineRequestPriority::Normal, FString(), 0.1f, StartOrder, Results);
+
+	const double GiveUpTime = FPlatformTime::Seconds() + 5.0;
+
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, Fakes, Results, GiveUpTime]()
+	{
+		if (Results->Num() == 0 && FPlatformTime::Seconds() < GiveUpTime)
+			return false;
+
+		TestEqual(TEXT("Unanswered request finished once"), Results->Num(), 1);
+		TestTrue(TEXT("Unanswered request timed out"), Results->Num() == 1 && (*Results)[0] == EAdvancedOnlineRequestResult::TimedOut);
+		TestEqual(TEXT("Timed out request freed its slot"), FAdvancedOnlineRequestScheduler::Get().GetNumRunning(EAdvancedOnlineInterface::Friends), 0);
+
+		// The backend answering after the deadline changes nothing
+		Fakes->AnswerAllPending(true);
+		TestEqual(TEXT("Late answer ignored"), Results->Num(), 1);
+
+		Fakes->Uninstall();
+		return true;
+	}));
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,241 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+#include "UniqueNetIdHandle.h"
+
+#include "Misc/Crc.h"
+#include "Misc/ScopeLock.h"
+#include "OnlineSubsystem.h"
+#include "Interfaces/OnlineIdentityInterface.h"
+
+DEFINE_LOG_CATEGORY(AdvancedUniqueNetIdLog);
+
+namespace UniqueNetIdHandle
+{
+	// Slots live in fixed chunks that never move, so a handle can be resolved without the lock
+	static const uint32 ChunkSize = 1024;
+	static const uint32 MaxChunks = 4096;
+
+	// Byte copy of an id, only used when its subsystem can't recreate it
+	class FInternedUniqueNetId : public FUniqueNetId
+	{
+	public:
+
+		FInternedUniqueNetId(const FUniqueNetId& Src)
+			: Bytes(Src.GetBytes(), Src.GetSize())
+			, Type(Src.GetType())
+			, String(Src.ToString())
+		{
+		}
+
+		virtual FName GetType() const override { return Type; }
+		virtual const uint8* GetBytes() const override { return Bytes.GetData(); }
+		virtual int32 GetSize() const override { return Bytes.Num(); }
+		virtual bool IsValid() const override { return Bytes.Num() > 0; }
+		virtual FString ToString() const override { return String; }
+		virtual FString ToDebugString() const override { return String; }
+
+	private:
+
+		TArray<uint8> Bytes;
+		FName Type;
+		FString String;
+	};
+
+	struct FTable
+	{
+		FCriticalSection Lock;
+
+		TSharedPtr<const FUniqueNetId>* Chunks[MaxChunks];
+
+		// 0 is the invalid handle
+		uint32 Num;
+
+		// Content hash to the first index with it, further ones are chained through NextInChain
+		TMap<uint32, uint32> FirstByHash;
+		TArray<uint32> NextInChain;
+
+		FTable()
+			: Num(1)
+		{
+			FMemory::Memzero(Chunks, sizeof(Chunks));
+			NextInChain.Add(0);
+		}
+
+		~FTable()
+		{
+			for (uint32 i = 0; i < MaxChunks && Chunks[i]; ++i)
+			{
+				delete[] Chunks[i];
+			}
+		}
+
+		TSharedPtr<const FUniqueNetId>& Slot(uint32 Index) const
+		{
+			return Chunks[Index / ChunkSize][Index % ChunkSize];
+		}
+	};
+
+	static FTable& GetTable()
+	{
+		static FTable Table;
+		return Table;
+	}
+
+	static uint32 HashId(const FUniqueNetId& UserId)
+	{
+		return HashCombine(FCrc::MemCrc32(UserId.GetBytes(), UserId.GetSize()), GetTypeHash(UserId.GetType()));
+	}
+
+	// Compares content rather than going through operator==, the stored copy may not be the same class as the query
+	static bool SameId(const FUniqueNetId& A, const FUniqueNetId& B)
+	{
+		return A.GetType() == B.GetType()
+			&& A.GetSize() == B.GetSize()
+			&& FMemory::Memcmp(A.GetBytes(), B.GetBytes(), A.GetSize()) == 0;
+	}
+
+	// Caller holds the lock
+	static uint32 FindLocked(const FTable& Table, const FUniqueNetId& UserId, uint32 Hash)
+	{
+		const uint32* First = Table.FirstByHash.Find(Hash);
+		for (uint32 Index = First ? *First : 0; Index != 0; Index = Table.NextInChain[Index])
+		{
+			if (SameId(*Table.Slot(Index), UserId))
+				return Index;
+		}
+
+		return 0;
+	}
+
+	// Caller holds the lock
+	static uint32 AddLocked(FTable& Table, const TSharedRef<const FUniqueNetId>& Owned, uint32 Hash)
+	{
+		const uint32 Index = Table.Num;
+		const uint32 Chunk = Index / ChunkSize;
+
+		if (Chunk >= MaxChunks)
+		{
+			UE_LOG(AdvancedUniqueNetIdLog, Error, TEXT("Unique net id table is full, can't intern %s"), *Owned->ToDebugString());
+			return 0;
+		}
+
+		if (!Table.Chunks[Chunk])
+		{
+			Table.Chunks[Chunk] = new TSharedPtr<const FUniqueNetId>[ChunkSize];
+		}
+
+		Table.Slot(Index) = Owned;
+		Table.NextInChain.Add(0);
+
+		if (uint32* First = Table.FirstByHash.Find(Hash))
+		{
+			Table.NextInChain[Index] = *First;
+			*First = Index;
+		}
+		else
+		{
+			Table.FirstByHash.Add(Hash, Index);
+		}
+
+		// Publish the slot before the index can escape to another thread
+		FPlatformMisc::MemoryBarrier();
+		Table.Num = Index + 1;
+		return Index;
+	}
+
+	// The table has to own the id it stores, raw ids are usually delegate parameters that die with the call
+	static TSharedRef<const FUniqueNetId> MakeOwnedCopy(const FUniqueNetId& UserId)
+	{
+		// Prefer the subsystem's own type so the copy can be handed back to that subsystem's interfaces
+		const FName Type = UserId.GetType();
+		if (Type != NAME_None && IOnlineSubsystem::DoesInstanceExist(Type))
+		{
+			IOnlineSubsystem* Subsystem = IOnlineSubsystem::Get(Type);
+			IOnlineIdentityPtr IdentityInterface = Subsystem ? Subsystem->GetIdentityInterface() : nullptr;
+
+			if (IdentityInterface.IsValid())
+			{
+				TArray<uint8> Bytes(UserId.GetBytes(), UserId.GetSize());
+				TSharedPtr<const FUniqueNetId> Created = IdentityInterface->CreateUniquePlayerId(Bytes.GetData(), Bytes.Num());
+
+				if (Created.IsValid() && SameId(*Created, UserId))
+				{
+					return Created.ToSharedRef();
+				}
+			}
+		}
+
+		return MakeShared<FInternedUniqueNetId>(UserId);
+	}
+}
+
+FUniqueNetIdHandle FUniqueNetIdHandle::Intern(const FUniqueNetId& UserId)
+{
+	if (!UserId.IsValid())
+		return FUniqueNetIdHandle();
+
+	UniqueNetIdHandle::FTable& Table = UniqueNetIdHandle::GetTable();
+	const uint32 Hash = UniqueNetIdHandle::HashId(UserId);
+
+	{
+		FScopeLock ScopeLock(&Table.Lock);
+		if (const uint32 Index = UniqueNetIdHandle::FindLocked(Table, UserId, Hash))
+			return FUniqueNetIdHandle(Index, UserId.GetType());
+	}
+
+	// Copy outside the lock, the identity interface is not ours to hold it across
+	TSharedRef<const FUniqueNetId> Owned = UniqueNetIdHandle::MakeOwnedCopy(UserId);
+
+	FScopeLock ScopeLock(&Table.Lock);
+
+	// Someone else may have added it while we were copying
+	uint32 Index = UniqueNetIdHandle::FindLocked(Table, UserId, Hash);
+	if (!Index)
+	{
+		Index = UniqueNetIdHandle::AddLocked(Table, Owned, Hash);
+	}
+
+	return Index ? FUniqueNetIdHandle(Index, UserId.GetType()) : FUniqueNetIdHandle();
+}
+
+FUniqueNetIdHandle FUniqueNetIdHandle::Intern(const TSharedPtr<const FUniqueNetId>& UserId)
+{
+	if (!UserId.IsValid() || !UserId->IsValid())
+		return FUniqueNetIdHandle();
+
+	UniqueNetIdHandle::FTable& Table = UniqueNetIdHandle::GetTable();
+	const uint32 Hash = UniqueNetIdHandle::HashId(*UserId);
+
+	FScopeLock ScopeLock(&Table.Lock);
+
+	// Already owned by a shared pointer, no copy needed
+	uint32 Index = UniqueNetIdHandle::FindLocked(Table, *UserId, Hash);
+	if (!Index)
+	{
+		Index = UniqueNetIdHandle::AddLocked(Table, UserId.ToSharedRef(), Hash);
+	}
+
+	return Index ? FUniqueNetIdHandle(Index, UserId->GetType()) : FUniqueNetIdHandle();
+}
+
+FUniqueNetIdHandle FUniqueNetIdHandle::Find(const FUniqueNetId& UserId)
+{
+	if (!UserId.IsValid())
+		return FUniqueNetIdHandle();
+
+	UniqueNetIdHandle::FTable& Table = UniqueNetIdHandle::GetTable();
+	const uint32 Hash = UniqueNetIdHandle::HashId(UserId);
+
+	FScopeLock ScopeLock(&Table.Lock);
+	const uint32 Index = UniqueNetIdHandle::FindLocked(Table, UserId, Hash);
+	return Index ? FUniqueNetIdHandle(Index, UserId.GetType()) : FUniqueNetIdHandle();
+}
+
+const FUniqueNetId* FUniqueNetIdHandle::Get() const
+{
+	return Index ? UniqueNetIdHandle::GetTable().Slot(Index).Get() : nullptr;
+}
+
+TSharedPtr<const FUniqueNetId> FUniqueNetIdHandle::GetShared() const
+{
+	return Index ? UniqueNetIdHandle::GetTable().Slot(Index) : nullptr;
+}
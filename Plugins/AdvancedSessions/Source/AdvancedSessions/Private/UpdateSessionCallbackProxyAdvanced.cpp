@@ -1,5 +1,6 @@
 // Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
 #include "UpdateSessionCallbackProxyAdvanced.h"
+#include "SessionSettingsDiff.h"
 
 
 //////////////////////////////////////////////////////////////////////////
@@ -7,7 +8,6 @@
 
 UUpdateSessionCallbackProxyAdvanced::UUpdateSessionCallbackProxyAdvanced(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
-	, OnUpdateSessionCompleteDelegate(FOnUpdateSessionCompleteDelegate::CreateUObject(this, &ThisClass::OnUpdateCompleted))
 	, NumPublicConnections(1)
 {
 }	
@@ -41,51 +41,18 @@ void UUpdateSessionCallbackProxyAdvanced::Activate()
 			return;
 		}
 
-		// This gets the actual session itself
-		//FNamedOnlineSession * curSession = Sessions->GetNamedSession(NAME_GameSession);
-		FOnlineSessionSettings* Settings = Sessions->GetSessionSettings(NAME_GameSession);
+		FSessionSettingsUpdate Update;
+		Update.NumPublicConnections = NumPublicConnections;
+		Update.NumPrivateConnections = NumPrivateConnections;
+		Update.bUseLAN = bUseLAN;
+		Update.bAllowInvites = bAllowInvites;
+		Update.bAllowJoinInProgress = bAllowJoinInProgress;
+		Update.bIsDedicated = bDedicatedServer;
+		Update.bRefreshOnlineData = bRefreshOnlineData;
+		Update.ExtraSettings.Build(ExtraSettings);
 
-		if (!Settings)
-		{
-			// Fail immediately
-			OnFailure.Broadcast();
-			return;
-		}
-
-		OnUpdateSessionCompleteDelegateHandle = Sessions->AddOnUpdateSessionCompleteDelegate_Handle(OnUpdateSessionCompleteDelegate);
-
-	//	FOnlineSessionSettings Settings;
-		//Settings->BuildUniqueId = GetBuildUniqueId();
-		Settings->NumPublicConnections = NumPublicConnections;
-		Settings->NumPrivateConnections = NumPrivateConnections;
-		//Settings->bShouldAdvertise = true;
-		Settings->bAllowJoinInProgress = bAllowJoinInProgress;
-		Settings->bIsLANMatch = bUseLAN;
-		//Settings->bUsesPresence = true;
-		//Settings->bAllowJoinViaPresence = true;
-		Settings->bAllowInvites = bAllowInvites;
-		Settings->bAllowJoinInProgress = bAllowJoinInProgress;
-		Settings->bIsDedicated = bDedicatedServer;
-
-		FOnlineSessionSetting * fSetting = NULL;
-		FOnlineSessionSetting ExtraSetting;
-		for (int i = 0; i < ExtraSettings.Num(); i++)
-		{
-			fSetting = Settings->Settings.Find(ExtraSettings[i].Key);
-
-			if (fSetting)
-			{
-				fSetting->Data = ExtraSettings[i].Data;
-			}
-			else
-			{
-				ExtraSetting.Data = ExtraSettings[i].Data;
-				ExtraSetting.AdvertisementType = EOnlineDataAdvertisementType::ViaOnlineService;
-				Settings->Settings.Add(ExtraSettings[i].Key, ExtraSetting);
-			}
-		}
-
-		Sessions->UpdateSession(NAME_GameSession, *Settings, bRefreshOnlineData);
+		// Only the settings that actually changed get written, and rapid updates are merged into one call
+		FSessionUpdateCoalescer::Get().Submit(Update, FOnSessionUpdateFlushed::CreateUObject(this, &ThisClass::OnUpdateCompleted));
 
 		// OnUpdateCompleted will get called, nothing more to do now
 		return;
@@ -99,23 +66,13 @@ void UUpdateSessionCallbackProxyAdvanced::Activate()
 	GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Red, TEXT("Sessions not supported"));
 }
 
-void UUpdateSessionCallbackProxyAdvanced::OnUpdateCompleted(FName SessionName, bool bWasSuccessful)
+void UUpdateSessionCallbackProxyAdvanced::OnUpdateCompleted(bool bWasSuccessful)
 {
-	IOnlineSessionPtr Sessions = Online::GetSessionInterface();
-	if (Sessions.IsValid())
+	if (bWasSuccessful)
 	{
-		Sessions->ClearOnUpdateSessionCompleteDelegate_Handle(OnUpdateSessionCompleteDelegateHandle);
-			
-		if (bWasSuccessful)
-		{
-			OnSuccess.Broadcast();
-			return;
-		}
+		OnSuccess.Broadcast();
+		return;
 	}
 
-	if (!bWasSuccessful)
-	{
-		OnFailure.Broadcast();
-		GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Red, TEXT("WAS NOT SUCCESSFUL"));
-	}
-}
\ No newline at end of file
+	OnFailure.Broadcast();
+}
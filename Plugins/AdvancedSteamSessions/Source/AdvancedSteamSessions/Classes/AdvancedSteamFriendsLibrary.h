@@ -304,6 +304,40 @@ public:
 
 };
 
+// A friends avatar as a region of a shared atlas texture
+USTRUCT(BlueprintType, Category = "Online|AdvancedFriends|SteamAPI")
+struct FBPSteamAvatarAtlasSlot
+{
+	GENERATED_USTRUCT_BODY()
+
+public:
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Online|AdvancedFriends|SteamAPI")
+		UTexture2D* Atlas;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Online|AdvancedFriends|SteamAPI")
+		FVector2D UVMin;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Online|AdvancedFriends|SteamAPI")
+		FVector2D UVMax;
+
+	// Which slot this was and who owned it, checked by IsSteamAvatarAtlasSlotCurrent
+	UPROPERTY()
+		int32 PageIndex;
+	UPROPERTY()
+		int32 SlotIndex;
+	UPROPERTY()
+		int32 Generation;
+
+	FBPSteamAvatarAtlasSlot()
+		: Atlas(nullptr)
+		, UVMin(FVector2D::ZeroVector)
+		, UVMax(FVector2D::ZeroVector)
+		, PageIndex(INDEX_NONE)
+		, SlotIndex(INDEX_NONE)
+		, Generation(0)
+	{
+	}
+};
+
 UCLASS()
 class UAdvancedSteamFriendsLibrary : public UBlueprintFunctionLibrary
 {
@@ -312,10 +346,19 @@ public:
 	
 	//********* Friend List Functions *************//
 
-	// Get a texture of a valid friends avatar, STEAM ONLY, Returns invalid texture if the subsystem hasn't loaded that size of avatar yet
+	// Get a texture of a valid friends avatar, STEAM ONLY, Returns invalid texture if the subsystem hasn't loaded that size of avatar yet, GetSteamFriendAvatarAsync waits for it instead
 	UFUNCTION(BlueprintCallable, Category = "Online|AdvancedFriends|SteamAPI", meta = (ExpandEnumAsExecs = "Result"))
 	static UTexture2D * GetSteamFriendAvatar(const FBPUniqueNetId UniqueNetId, EBlueprintAsyncResultSwitch &Result, SteamAvatarSize AvatarSize = SteamAvatarSize::SteamAvatar_Medium);
 
+	// Get a friends avatar packed into a shared atlas texture so lists of avatars draw together, STEAM ONLY, Small and Medium only
+	// Slots can be given to another avatar once the atlas is full, check IsSteamAvatarAtlasSlotCurrent before drawing a kept slot. Draw it with UUI_UserWidget_Base::MakeAtlasBrush
+	UFUNCTION(BlueprintCallable, Category = "Online|AdvancedFriends|SteamAPI", meta = (ExpandEnumAsExecs = "Result"))
+	static FBPSteamAvatarAtlasSlot GetSteamFriendAvatarAtlasSlot(const FBPUniqueNetId UniqueNetId, EBlueprintAsyncResultSwitch &Result, SteamAvatarSize AvatarSize = SteamAvatarSize::SteamAvatar_Small);
+
+	// False once the slot's region of the atlas has gone to another avatar, look the avatar up again if so
+	UFUNCTION(BlueprintPure, Category = "Online|AdvancedFriends|SteamAPI")
+	static bool IsSteamAvatarAtlasSlotCurrent(const FBPSteamAvatarAtlasSlot& AtlasSlot);
+
 	// Preloads the avatar and name of a steam friend, return whether it is already available or not, STEAM ONLY, Takes time to actually load everything after this is called.
 	UFUNCTION(BlueprintCallable, Category = "Online|AdvancedFriends|SteamAPI")
 	static bool RequestSteamFriendInfo(const FBPUniqueNetId UniqueNetId, bool bRequireNameOnly = false);
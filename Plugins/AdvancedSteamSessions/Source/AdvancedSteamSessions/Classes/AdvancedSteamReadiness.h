@@ -0,0 +1,29 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(AdvancedSteamReadinessLog, Log, All);
+
+DECLARE_STATS_GROUP(TEXT("AdvancedSteamSessions"), STATGROUP_AdvancedSteamSessions, STATCAT_Advanced);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("SteamAPI_Init Calls"), STAT_SteamAPIInitCalls, STATGROUP_AdvancedSteamSessions, ADVANCEDSTEAMSESSIONS_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("SteamAPI_Init Calls Avoided"), STAT_SteamAPIInitCallsAvoided, STATGROUP_AdvancedSteamSessions, ADVANCEDSTEAMSESSIONS_API);
+
+/**
+ * Whether the steam API can be used, decided once instead of calling SteamAPI_Init at the top of every function.
+ * The module initializes it on startup (or after engine init if the steam subsystem isn't loaded yet), after that
+ * IsSteamReady is an atomic read. A failed init is only retried every AdvancedSteamSessions.SteamInitRetryInterval
+ * seconds. Safe from any thread.
+ */
+namespace AdvancedSteam
+{
+	// Cheap check to guard steam calls with
+	ADVANCEDSTEAMSESSIONS_API bool IsSteamReady();
+
+	// Calls SteamAPI_Init if it hasn't succeeded yet, the only place that does
+	ADVANCEDSTEAMSESSIONS_API bool EnsureSteamAPI();
+
+	// Back to not knowing, the next check initializes again
+	ADVANCEDSTEAMSESSIONS_API void ResetSteamAPI();
+}
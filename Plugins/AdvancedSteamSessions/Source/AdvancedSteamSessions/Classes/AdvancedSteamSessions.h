@@ -9,4 +9,8 @@ public:
 	/** IModuleInterface implementation */
 	void StartupModule();
 	void ShutdownModule();
+
+private:
+
+	FDelegateHandle PostEngineInitHandle;
 };
\ No newline at end of file
@@ -211,6 +211,7 @@ public:
 	FBPSteamWorkshopItemDetails()
 	{
 		ResultOfRequest = FBPSteamResult::k_EResultOK;
+		PublishedFileId = FBPSteamWorkshopID(0);
 		FileType = FBPWorkshopFileType::k_EWorkshopFileTypeMax;
 		CreatorAppID = 0;
 		ConsumerAppID = 0;
@@ -226,6 +227,7 @@ public:
 	FBPSteamWorkshopItemDetails(SteamUGCDetails_t &hUGCDetails)
 	{
 		ResultOfRequest = (FBPSteamResult)hUGCDetails.m_eResult;
+		PublishedFileId = FBPSteamWorkshopID(hUGCDetails.m_nPublishedFileId);
 		FileType = (FBPWorkshopFileType)hUGCDetails.m_eFileType;
 		CreatorAppID = (int32)hUGCDetails.m_nCreatorAppID;
 		ConsumerAppID = (int32)hUGCDetails.m_nConsumerAppID;
@@ -240,11 +242,13 @@ public:
 		bTagsTruncated = hUGCDetails.m_bTagsTruncated;
 
 		CreatorSteamID = FString::Printf(TEXT("%llu"), hUGCDetails.m_ulSteamIDOwner);
+		TimeUpdated = FDateTime::FromUnixTimestamp(hUGCDetails.m_rtimeUpdated);
 	}
 
 	FBPSteamWorkshopItemDetails(const SteamUGCDetails_t &hUGCDetails)
 	{
 		ResultOfRequest = (FBPSteamResult)hUGCDetails.m_eResult;
+		PublishedFileId = FBPSteamWorkshopID(hUGCDetails.m_nPublishedFileId);
 		FileType = (FBPWorkshopFileType)hUGCDetails.m_eFileType;
 		CreatorAppID = (int32)hUGCDetails.m_nCreatorAppID;
 		ConsumerAppID = (int32)hUGCDetails.m_nConsumerAppID;
@@ -259,6 +263,7 @@ public:
 		bTagsTruncated = hUGCDetails.m_bTagsTruncated;
 
 		CreatorSteamID = FString::Printf(TEXT("%llu"), hUGCDetails.m_ulSteamIDOwner);
+		TimeUpdated = FDateTime::FromUnixTimestamp(hUGCDetails.m_rtimeUpdated);
 	}
 #endif
 
@@ -266,6 +271,10 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Online|AdvancedSteamWorkshop")
 		FBPSteamResult ResultOfRequest;
 
+	// Item these details are for
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Online|AdvancedSteamWorkshop")
+		FBPSteamWorkshopID PublishedFileId;
+
 	// Type of file
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Online|AdvancedSteamWorkshop")
 		FBPWorkshopFileType FileType;
@@ -314,10 +323,12 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Online|AdvancedSteamWorkshop")
 	FString CreatorSteamID;
 
+	// When the item was last updated, details older than this are stale
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Online|AdvancedSteamWorkshop")
+	FDateTime TimeUpdated;
+
 	/*
-	PublishedFileId_t m_nPublishedFileId;
 	uint32 m_rtimeCreated;											// time when the published file was created
-	uint32 m_rtimeUpdated;											// time when the published file was last updated
 	uint32 m_rtimeAddedToUserList;									// time when the user added the published file to their list (not always applicable)
 	ERemoteStoragePublishedFileVisibility m_eVisibility;			// visibility
 	char m_rgchTags[k_cchTagListMax];								// comma separated list of all tags associated with this file
@@ -332,6 +343,48 @@ public:
 
 };
 
+// What mounting subscribed workshop content did
+USTRUCT(BlueprintType)
+struct FBPSteamWorkshopMountReport
+{
+	GENERATED_USTRUCT_BODY()
+
+public:
+
+	FBPSteamWorkshopMountReport()
+	{
+		NumSubscribed = 0;
+		NumInstalled = 0;
+		NumPaksMounted = 0;
+		NumPaksFailed = 0;
+		Seconds = 0.f;
+	}
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Online|AdvancedSteamWorkshop")
+	int32 NumSubscribed;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Online|AdvancedSteamWorkshop")
+	int32 NumInstalled;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Online|AdvancedSteamWorkshop")
+	int32 NumPaksMounted;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Online|AdvancedSteamWorkshop")
+	int32 NumPaksFailed;
+
+	// Wall time from enumerating the items to the last pak being mounted
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Online|AdvancedSteamWorkshop")
+	float Seconds;
+
+	// Subscribed but not installed or still downloading, nothing was mounted for these
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Online|AdvancedSteamWorkshop")
+	TArray<FBPSteamWorkshopID> NotInstalledItems;
+
+	// Installed items with at least one pak that failed to mount
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Online|AdvancedSteamWorkshop")
+	TArray<FBPSteamWorkshopID> FailedItems;
+};
+
 UCLASS()
 class UAdvancedSteamWorkshopLibrary : public UBlueprintFunctionLibrary
 {
@@ -347,4 +400,10 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Online|AdvancedSteamWorkshop")
 	static void GetNumSubscribedWorkshopItems(int32 & NumberOfItems);
 
+	// Returns details from the on disk cache without asking steam, one per id in the same order. Ids with nothing cached
+	// come back with ResultOfRequest k_EResultFail, those and ids with stale details go in StaleIDs, pass those to
+	// GetWorkshopItemDetailsBatch to bring them up to date
+	UFUNCTION(BlueprintCallable, Category = "Online|AdvancedSteamWorkshop")
+	static TArray<FBPSteamWorkshopItemDetails> GetCachedWorkshopItemDetails(const TArray<FBPSteamWorkshopID>& WorkShopIDs, TArray<FBPSteamWorkshopID>& StaleIDs);
+
 };	
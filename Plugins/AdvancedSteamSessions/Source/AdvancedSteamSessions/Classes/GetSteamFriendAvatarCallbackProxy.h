@@ -0,0 +1,39 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BlueprintDataDefinitions.h"
+#include "AdvancedSteamFriendsLibrary.h"
+#include "GetSteamFriendAvatarCallbackProxy.generated.h"
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FBlueprintSteamAvatarDelegate, UTexture2D*, Avatar);
+
+UCLASS(MinimalAPI)
+class UGetSteamFriendAvatarCallbackProxy : public UOnlineBlueprintCallProxyBase
+{
+	GENERATED_UCLASS_BODY()
+
+	// Called when the avatar is ready
+	UPROPERTY(BlueprintAssignable)
+	FBlueprintSteamAvatarDelegate OnSuccess;
+
+	// Called when the player has no avatar or it couldn't be loaded
+	UPROPERTY(BlueprintAssignable)
+	FBlueprintSteamAvatarDelegate OnFailure;
+
+	// Gets a texture of a friends avatar, waiting for steam to load it if it has to, STEAM ONLY. No polling needed
+	UFUNCTION(BlueprintCallable, meta=(BlueprintInternalUseOnly = "true", WorldContext="WorldContextObject"), Category = "Online|AdvancedFriends|SteamAPI")
+	static UGetSteamFriendAvatarCallbackProxy* GetSteamFriendAvatarAsync(UObject* WorldContextObject, const FBPUniqueNetId UniqueNetId, SteamAvatarSize AvatarSize = SteamAvatarSize::SteamAvatar_Medium);
+
+	// UOnlineBlueprintCallProxyBase interface
+	virtual void Activate() override;
+	// End of UOnlineBlueprintCallProxyBase interface
+
+private:
+
+	void OnAvatarReady(UTexture2D* Avatar);
+
+	FBPUniqueNetId UniqueNetId;
+	SteamAvatarSize AvatarSize;
+	UObject* WorldContextObject;
+};
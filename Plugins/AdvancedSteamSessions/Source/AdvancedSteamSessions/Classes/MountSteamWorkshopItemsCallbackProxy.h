@@ -0,0 +1,45 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AdvancedSteamWorkshopLibrary.h"
+#include "BlueprintDataDefinitions.h"
+#include "SteamWorkshopMountPipeline.h"
+#include "MountSteamWorkshopItemsCallbackProxy.generated.h"
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FBlueprintWorkshopMountProgressDelegate, int32, ItemsDone, int32, ItemsTotal);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FBlueprintWorkshopMountDelegate, const FBPSteamWorkshopMountReport&, Report);
+
+UCLASS(MinimalAPI)
+class UMountSteamWorkshopItemsCallbackProxy : public UOnlineBlueprintCallProxyBase
+{
+	GENERATED_UCLASS_BODY()
+
+	// Called as installed items finish mounting
+	UPROPERTY(BlueprintAssignable)
+	FBlueprintWorkshopMountProgressDelegate OnProgress;
+
+	// Called when every installed item has been mounted
+	UPROPERTY(BlueprintAssignable)
+	FBlueprintWorkshopMountDelegate OnSuccess;
+
+	// Called when steam isn't available or a pak failed to mount, the report lists the failed items
+	UPROPERTY(BlueprintAssignable)
+	FBlueprintWorkshopMountDelegate OnFailure;
+
+	// Mounts the paks of every installed subscribed workshop item in id order and registers their content, STEAM ONLY
+	UFUNCTION(BlueprintCallable, meta=(BlueprintInternalUseOnly = "true", WorldContext="WorldContextObject"), Category = "Online|AdvancedSteamWorkshop")
+	static UMountSteamWorkshopItemsCallbackProxy* MountSubscribedWorkshopItems(UObject* WorldContextObject);
+
+	// UOnlineBlueprintCallProxyBase interface
+	virtual void Activate() override;
+	// End of UOnlineBlueprintCallProxyBase interface
+
+private:
+
+	void OnMountProgress(int32 ItemsDone, int32 ItemsTotal);
+	void OnMountComplete(const FBPSteamWorkshopMountReport& Report);
+
+	TUniquePtr<FSteamWorkshopMountPipeline> Pipeline;
+	UObject* WorldContextObject;
+};
@@ -0,0 +1,104 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+#include "CoreMinimal.h"
+#include "UObject/GCObject.h"
+#include "SteamAvatarCache.h"
+
+class UTexture2D;
+
+// Where an avatar lives in an atlas page
+struct FSteamAvatarAtlasSlot
+{
+	UTexture2D* Atlas;
+	FVector2D UVMin;
+	FVector2D UVMax;
+
+	// Identifies the slot's owner at lookup time, see FSteamAvatarAtlas::IsSlotCurrent
+	int32 PageIndex;
+	int32 SlotIndex;
+	uint32 Generation;
+
+	FSteamAvatarAtlasSlot()
+		: Atlas(nullptr)
+		, UVMin(FVector2D::ZeroVector)
+		, UVMax(FVector2D::ZeroVector)
+		, PageIndex(INDEX_NONE)
+		, SlotIndex(INDEX_NONE)
+		, Generation(0)
+	{
+	}
+};
+
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnSteamAvatarAtlasSlotEvicted, uint64 /*SteamId*/, uint8 /*AvatarSize*/);
+
+/**
+ * Packs small and medium avatars into shared atlas pages, so a list of avatars draws from a handful of textures instead
+ * of one texture per friend. Each page holds a single avatar size in a grid of fixed slots, images are copied in with
+ * UpdateTextureRegions. When every page for a size is full and AdvancedSteamSessions.AvatarAtlas.MaxPages is reached the
+ * least recently looked up avatar gives up its slot. Every slot carries a generation that changes when it gets a new owner,
+ * so anything holding on to UVs checks IsSlotCurrent (or listens to OnSlotEvicted) and looks the avatar up again rather
+ * than draw somebody else's face. Large avatars don't fit the grid, use the avatar cache for those. Game thread only.
+ */
+class ADVANCEDSTEAMSESSIONS_API FSteamAvatarAtlas : public FGCObject
+{
+public:
+
+	static FSteamAvatarAtlas& Get();
+	static void Shutdown();
+
+	// Finds or packs the image, false if it can't go in an atlas
+	bool FindOrAdd(uint64 SteamId, uint8 AvatarSize, int32 ImageHandle, FSteamAvatarAtlasSlot& OutSlot);
+
+	// False once the slot has been given to another avatar, or the atlas was emptied
+	bool IsSlotCurrent(const FSteamAvatarAtlasSlot& Slot) const;
+
+	void Empty();
+
+	// An avatar lost its slot to make room for another one
+	FOnSteamAvatarAtlasSlotEvicted OnSlotEvicted;
+
+	// FGCObject
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+	virtual FString GetReferencerName() const override { return TEXT("FSteamAvatarAtlas"); }
+
+private:
+
+	FSteamAvatarAtlas();
+
+	struct FAtlasPage
+	{
+		UTexture2D* Texture;
+		uint8 AvatarSize;
+		int32 SlotSize;
+		int32 SlotsPerRow;
+		TArray<int32> FreeSlots;
+
+		// Bumped whenever a slot changes owner
+		TArray<uint32> SlotGenerations;
+	};
+
+	struct FAtlasEntry
+	{
+		int32 PageIndex;
+		int32 SlotIndex;
+		int32 ImageHandle;
+		uint64 LastUsed;
+	};
+
+	// Slot edge length in pixels for an avatar size, 0 if it doesn't go in the atlas
+	static int32 GetSlotSize(uint8 AvatarSize);
+
+	// Claims a free slot, adding a page or evicting if there isn't one
+	bool AllocateSlot(uint8 AvatarSize, int32& OutPageIndex, int32& OutSlotIndex);
+	int32 AddPage(uint8 AvatarSize);
+
+	bool Upload(const FAtlasEntry& Entry, int32 ImageHandle, ISteamAvatarImageSource& Source);
+	void FillSlot(const FAtlasEntry& Entry, FSteamAvatarAtlasSlot& OutSlot) const;
+
+	TArray<FAtlasPage> Pages;
+	TMap<FSteamAvatarKey, FAtlasEntry> Entries;
+	uint64 UseCounter;
+
+	static FSteamAvatarAtlas* Instance;
+};
@@ -0,0 +1,122 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+#include "CoreMinimal.h"
+#include "UObject/GCObject.h"
+#include "SteamAvatarImageSource.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(AdvancedSteamAvatarLog, Log, All);
+
+class UTexture2D;
+
+struct FSteamAvatarKey
+{
+	uint64 SteamId;
+	uint8 AvatarSize;
+
+	FSteamAvatarKey(uint64 InSteamId, uint8 InAvatarSize)
+		: SteamId(InSteamId)
+		, AvatarSize(InAvatarSize)
+	{
+	}
+
+	bool operator==(const FSteamAvatarKey& Other) const
+	{
+		return SteamId == Other.SteamId && AvatarSize == Other.AvatarSize;
+	}
+
+	friend uint32 GetTypeHash(const FSteamAvatarKey& Key)
+	{
+		return HashCombine(GetTypeHash(Key.SteamId), Key.AvatarSize);
+	}
+};
+
+// RGBA staging buffers by size, buffers come back from the render thread and worker threads so it is thread safe
+class ADVANCEDSTEAMSESSIONS_API FSteamAvatarStagingPool
+{
+public:
+
+	~FSteamAvatarStagingPool();
+
+	uint8* Acquire(uint32 Size);
+	void Release(uint8* Buffer, uint32 Size);
+
+private:
+
+	FCriticalSection Lock;
+	TMap<uint32, TArray<uint8*>> FreeBuffers;
+};
+
+/**
+ * Avatar textures by steam id and avatar size, so asking for the same avatar again costs a map lookup instead of a new
+ * texture. The steam image handle is checked on every hit, when a player changes their avatar the new image is uploaded
+ * into the texture they already have (UpdateTextureRegions from a pooled staging buffer) rather than making a new one.
+ * Least recently used avatars are dropped once AdvancedSteamSessions.AvatarCache.BudgetMB is exceeded. Dropped textures
+ * are never handed out again for someone else, widgets may still be showing them. Game thread only.
+ */
+class ADVANCEDSTEAMSESSIONS_API FSteamAvatarCache : public FGCObject
+{
+public:
+
+	static FSteamAvatarCache& Get();
+
+	// Called on module shutdown, the cache has to go before the garbage collector does
+	static void Shutdown();
+
+	// Texture for the steam image, uploading it only if it isn't already cached. Null if steam has no image data for it
+	UTexture2D* FindOrCreate(uint64 SteamId, uint8 AvatarSize, int32 ImageHandle);
+
+	// Cached texture if it is still of this image, null otherwise
+	UTexture2D* Find(const FSteamAvatarKey& Key, int32 ImageHandle);
+
+	// Caches an image already read into a staging buffer from GetStagingPool, the cache takes the buffer
+	UTexture2D* AddImage(const FSteamAvatarKey& Key, int32 ImageHandle, uint32 Width, uint32 Height, uint8* Staging);
+
+	void Remove(uint64 SteamId, uint8 AvatarSize);
+	void Empty();
+
+	int64 GetUsedBytes() const { return UsedBytes; }
+
+	// Null goes back to steam. Cached avatars are dropped, their image handles meant nothing to the new source
+	void SetImageSource(const TSharedPtr<ISteamAvatarImageSource, ESPMode::ThreadSafe>& NewSource);
+	TSharedPtr<ISteamAvatarImageSource, ESPMode::ThreadSafe> GetImageSource();
+
+	TSharedRef<FSteamAvatarStagingPool, ESPMode::ThreadSafe> GetStagingPool() const { return StagingBuffers; }
+
+	// FGCObject
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+	virtual FString GetReferencerName() const override { return TEXT("FSteamAvatarCache"); }
+
+private:
+
+	FSteamAvatarCache();
+
+	struct FAvatarEntry
+	{
+		UTexture2D* Texture;
+		int32 ImageHandle;
+		uint32 Width;
+		uint32 Height;
+		uint64 LastUsed;
+	};
+
+	// Creates a transient texture, Fill writes the image into its locked mip
+	UTexture2D* CreateTexture(uint32 Width, uint32 Height, TFunctionRef<bool(uint8*)> Fill);
+
+	// Uploads a new image of the same size into the entry's texture, takes the staging buffer
+	UTexture2D* UpdateEntry(FAvatarEntry& Entry, int32 ImageHandle, uint8* Staging);
+
+	UTexture2D* AddEntry(const FSteamAvatarKey& Key, int32 ImageHandle, uint32 Width, uint32 Height, UTexture2D* Texture);
+	void EvictToBudget(uint64 BytesNeeded);
+
+	TMap<FSteamAvatarKey, FAvatarEntry> Entries;
+	int64 UsedBytes;
+	uint64 UseCounter;
+
+	TSharedPtr<ISteamAvatarImageSource, ESPMode::ThreadSafe> ImageSource;
+
+	// Shared with the render thread cleanup callbacks and the avatar loader, which can outlive the cache
+	TSharedRef<FSteamAvatarStagingPool, ESPMode::ThreadSafe> StagingBuffers;
+
+	static FSteamAvatarCache* Instance;
+};
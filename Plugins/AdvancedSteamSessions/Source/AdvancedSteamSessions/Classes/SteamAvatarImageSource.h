@@ -0,0 +1,34 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+#include "CoreMinimal.h"
+
+// Steam finished downloading a player's avatar, can fire on the online thread
+DECLARE_DELEGATE_OneParam(FOnSteamAvatarImageLoaded, uint64 /*SteamId*/);
+
+/**
+ * The parts of the steam image API the avatar cache and loader use, so a local stand-in can replace steam.
+ * Avatar sizes are the SteamAvatarSize values.
+ */
+class ADVANCEDSTEAMSESSIONS_API ISteamAvatarImageSource
+{
+public:
+
+	virtual ~ISteamAvatarImageSource() {}
+
+	// Image handle, -1 while the image is still downloading and 0 if the player has no avatar
+	virtual int32 GetAvatarImage(uint64 SteamId, uint8 AvatarSize) = 0;
+
+	// Asks for the player's avatar to be downloaded, OnAvatarImageLoaded fires when it arrives
+	virtual void RequestAvatar(uint64 SteamId) = 0;
+
+	virtual bool GetImageSize(int32 ImageHandle, uint32& OutWidth, uint32& OutHeight) = 0;
+
+	// Called from worker threads, BufferSize is Width * Height * 4
+	virtual bool GetImageRGBA(int32 ImageHandle, uint8* Buffer, uint32 BufferSize) = 0;
+
+	FOnSteamAvatarImageLoaded OnAvatarImageLoaded;
+
+	// The real thing, null where steam isn't available
+	static TSharedPtr<ISteamAvatarImageSource, ESPMode::ThreadSafe> CreateSteamworksSource();
+};
@@ -0,0 +1,101 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "Containers/Ticker.h"
+#include "SteamAvatarCache.h"
+
+class UTexture2D;
+
+// Null if the player has no avatar or it couldn't be loaded
+DECLARE_DELEGATE_OneParam(FOnSteamAvatarReady, UTexture2D* /*Avatar*/);
+
+/**
+ * Loads avatars without the caller polling GetSteamFriendAvatar.
+ * Avatars steam doesn't have yet are requested and picked up when the image source reports them loaded, the RGBA copy
+ * runs on a worker thread into pooled staging buffers, and the decoded images are turned into textures on the game
+ * thread at most AdvancedSteamSessions.AvatarLoader.UploadsPerFrame per frame. Requests for the same avatar share one
+ * load, and anything already in FSteamAvatarCache comes back straight away. Uses the cache's image source, so a local
+ * stand-in set there drives this too. Game thread only.
+ */
+class ADVANCEDSTEAMSESSIONS_API FSteamAvatarLoader
+{
+public:
+
+	static FSteamAvatarLoader& Get();
+	static void Shutdown();
+
+	// OnReady may run before this returns if the avatar is cached or the player has none
+	void RequestAvatar(uint64 SteamId, uint8 AvatarSize, const FOnSteamAvatarReady& OnReady);
+
+	int32 GetNumPending() const { return Requests.Num(); }
+
+private:
+
+	FSteamAvatarLoader();
+	~FSteamAvatarLoader();
+
+	enum class ERequestState : uint8
+	{
+		WaitingForSteam,
+		Decoding
+	};
+
+	struct FRequest
+	{
+		ERequestState State;
+		double StartTime;
+		TArray<FOnSteamAvatarReady, TInlineAllocator<1>> Callbacks;
+	};
+
+	struct FDecodedImage
+	{
+		FSteamAvatarKey Key;
+		int32 ImageHandle;
+		uint32 Width;
+		uint32 Height;
+
+		// From the cache's staging pool, null if decoding failed
+		uint8* Staging;
+
+		FDecodedImage()
+			: Key(0, 0)
+			, ImageHandle(0)
+			, Width(0)
+			, Height(0)
+			, Staging(nullptr)
+		{
+		}
+	};
+
+	// Filled from worker threads and the image source's callback, both can still finish after the loader is gone
+	struct FInbox
+	{
+		~FInbox();
+
+		TQueue<FDecodedImage, EQueueMode::Mpsc> Decoded;
+		TQueue<uint64, EQueueMode::Mpsc> Loaded;
+	};
+
+	void BindSource(const TSharedPtr<ISteamAvatarImageSource, ESPMode::ThreadSafe>& Source);
+
+	// Decodes if the image is there, fails the request if the player has none. False if still waiting on steam
+	bool TryStartDecode(const FSteamAvatarKey& Key, FRequest& Request, ISteamAvatarImageSource& Source);
+
+	void Finish(const FSteamAvatarKey& Key, UTexture2D* Avatar);
+
+	void EnsureTicker();
+	bool Tick(float DeltaTime);
+
+	TMap<FSteamAvatarKey, FRequest> Requests;
+
+	// Decoded and waiting for this frame's upload budget
+	TArray<FDecodedImage> UploadQueue;
+
+	TSharedRef<FInbox, ESPMode::ThreadSafe> Inbox;
+	TWeakPtr<ISteamAvatarImageSource, ESPMode::ThreadSafe> BoundSource;
+	FDelegateHandle TickerHandle;
+
+	static FSteamAvatarLoader* Instance;
+};
@@ -0,0 +1,62 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "AdvancedSteamFriendsLibrary.h"
+
+/**
+ * The local user's steam groups, kept between calls so GetSteamGroups is a copy instead of a walk over every clan.
+ * Each group's net id is made once, and its name and tag are read when it first shows up and again every
+ * AdvancedSteamSessions.GroupDirectory.NameRefreshInterval. Activity counts for all groups are refreshed together with
+ * one DownloadClanActivityCounts request every AdvancedSteamSessions.GroupDirectory.RefreshInterval, for as long as
+ * the directory keeps being asked for. Game thread only.
+ */
+class ADVANCEDSTEAMSESSIONS_API FSteamGroupDirectory
+{
+public:
+
+	static FSteamGroupDirectory& Get();
+	static void Shutdown();
+
+	// Builds the directory on first use, after that returns what the last refresh saw
+	void GetGroups(TArray<FBPSteamGroupInfo>& OutGroups);
+
+	// Next tick re-reads the group list and activity counts instead of waiting for the interval
+	void MarkDirty();
+
+private:
+
+	FSteamGroupDirectory();
+	~FSteamGroupDirectory();
+
+	struct FGroupEntry
+	{
+		FBPSteamGroupInfo Info;
+		double NamesReadTime;
+	};
+
+	// Adds and removes groups to match steam, local calls only
+	void UpdateMembership();
+	void RequestActivityCounts();
+
+	bool Tick(float DeltaTime);
+
+#if PLATFORM_WINDOWS || PLATFORM_MAC || PLATFORM_LINUX
+	void OnDownloadClanActivityCounts(DownloadClanActivityCountsResult_t *pResult, bool bIOFailure);
+	CCallResult<FSteamGroupDirectory, DownloadClanActivityCountsResult_t> m_callResultDownloadClanActivityCounts;
+#endif
+
+	// In the order steam lists them
+	TArray<uint64> GroupOrder;
+	TMap<uint64, FGroupEntry> Groups;
+
+	double LastRefreshTime;
+	double LastAccessTime;
+	bool bHasMembership;
+	bool bCountsInFlight;
+
+	FDelegateHandle TickerHandle;
+
+	static FSteamGroupDirectory* Instance;
+};
@@ -0,0 +1,65 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+#include "CoreMinimal.h"
+#include "SteamRequestGroupOfficersCallbackProxy.h"
+
+DECLARE_DELEGATE_TwoParams(FOnSteamGroupOfficersReady, bool /*bWasSuccessful*/, const TArray<FBPSteamGroupOfficer>& /*OfficerList*/);
+
+/**
+ * Officer lists by steam group id. Asking for a group that already has a request out joins that request instead of
+ * sending another, and a successful list is reused for AdvancedSteamSessions.GroupOfficers.CacheLifetime seconds, so a
+ * burst of widgets refreshing the same group costs one RequestClanOfficerList. Failures aren't cached. Game thread only.
+ */
+class ADVANCEDSTEAMSESSIONS_API FSteamGroupOfficerCache
+{
+public:
+
+	static FSteamGroupOfficerCache& Get();
+	static void Shutdown();
+
+	// OnReady runs before this returns if the list is cached or steam isn't available
+	void RequestOfficers(uint64 GroupId, const FOnSteamGroupOfficersReady& OnReady);
+
+	void Invalidate(uint64 GroupId);
+	void Empty();
+
+private:
+
+	FSteamGroupOfficerCache();
+
+	struct FCachedList
+	{
+		TArray<FBPSteamGroupOfficer> Officers;
+		double Time;
+	};
+
+	// One per group with a request out, the call result needs a stable object to call back into
+	class FPendingRequest
+	{
+	public:
+
+		FPendingRequest(FSteamGroupOfficerCache& InOwner, uint64 InGroupId);
+
+		bool Send();
+
+		uint64 GroupId;
+		TArray<FOnSteamGroupOfficersReady, TInlineAllocator<2>> Callbacks;
+
+	private:
+
+		FSteamGroupOfficerCache& Owner;
+
+#if PLATFORM_WINDOWS || PLATFORM_MAC || PLATFORM_LINUX
+		void OnRequestGroupOfficerDetails(ClanOfficerListResponse_t *pResult, bool bIOFailure);
+		CCallResult<FPendingRequest, ClanOfficerListResponse_t> m_callResultGroupOfficerRequestDetails;
+#endif
+	};
+
+	void Finish(uint64 GroupId, bool bWasSuccessful, const TArray<FBPSteamGroupOfficer>& Officers);
+
+	TMap<uint64, FCachedList> Cache;
+	TMap<uint64, TUniquePtr<FPendingRequest>> Pending;
+
+	static FSteamGroupOfficerCache* Instance;
+};
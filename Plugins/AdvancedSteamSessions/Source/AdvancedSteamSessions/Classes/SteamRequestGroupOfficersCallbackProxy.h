@@ -87,11 +87,8 @@ class USteamRequestGroupOfficersCallbackProxy : public UOnlineBlueprintCallProxy
 
 private:
 
-#if PLATFORM_WINDOWS || PLATFORM_MAC || PLATFORM_LINUX
-	void OnRequestGroupOfficerDetails( ClanOfficerListResponse_t *pResult, bool bIOFailure);
-	CCallResult<USteamRequestGroupOfficersCallbackProxy, ClanOfficerListResponse_t> m_callResultGroupOfficerRequestDetails;
-
-#endif
+	// Requests go through FSteamGroupOfficerCache so callers asking for the same group share one
+	void OnOfficersReady(bool bWasSuccessful, const TArray<FBPSteamGroupOfficer>& OfficerList);
 
 private:
 
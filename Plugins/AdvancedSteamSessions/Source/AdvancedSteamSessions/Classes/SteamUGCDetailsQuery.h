@@ -0,0 +1,53 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+#include "CoreMinimal.h"
+#include "AdvancedSteamWorkshopLibrary.h"
+#include "SteamUGCSource.h"
+
+// Details line up with the ids the query was made with, bWasSuccessful is false if no page came back
+DECLARE_DELEGATE_TwoParams(FOnSteamUGCDetailsQueryComplete, bool /*bWasSuccessful*/, const TArray<FBPSteamWorkshopItemDetails>& /*Details*/);
+
+/**
+ * Fetches details for many workshop items with one UGC details request per page of ids instead of one request per
+ * item. Pages are sent one after another through the UGC source, steam unless SetSource was given a stand-in. An item
+ * nothing came back for keeps its PublishedFileId with ResultOfRequest set to k_EResultFail, so the output always
+ * matches the input one to one. Game thread only, destroying the query drops the page in flight.
+ */
+class ADVANCEDSTEAMSESSIONS_API FSteamUGCDetailsQuery
+{
+public:
+
+	FSteamUGCDetailsQuery(const TArray<uint64>& InPublishedFileIds, const FOnSteamUGCDetailsQueryComplete& InOnComplete);
+	~FSteamUGCDetailsQuery();
+
+	// False if there is no UGC source, OnComplete isn't called then
+	bool Start();
+
+	bool IsRunning() const { return bRunning; }
+
+	// Swaps where later queries get their details from, null goes back to steam
+	static void SetSource(const TSharedPtr<ISteamUGCSource, ESPMode::ThreadSafe>& NewSource);
+	static TSharedPtr<ISteamUGCSource, ESPMode::ThreadSafe> GetSource();
+
+private:
+
+	// Sends the page starting at NextIndex, finishes the query once every page is done
+	void SendNextPage();
+	void Finish();
+
+	void OnPageLoaded(bool bWasSuccessful, const TArray<FBPSteamWorkshopItemDetails>& PageDetails);
+
+	TArray<uint64> PublishedFileIds;
+	TArray<FBPSteamWorkshopItemDetails> Details;
+	FOnSteamUGCDetailsQueryComplete OnComplete;
+
+	// Held for the whole query so the page in flight can always be cancelled
+	TSharedPtr<ISteamUGCSource, ESPMode::ThreadSafe> Source;
+	uint32 PendingRequestId;
+
+	int32 NextIndex;
+	int32 PageCount;
+	bool bAnyPageSucceeded;
+	bool bRunning;
+};
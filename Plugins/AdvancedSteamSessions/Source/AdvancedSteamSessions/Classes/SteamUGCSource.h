@@ -0,0 +1,31 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+#include "CoreMinimal.h"
+#include "AdvancedSteamWorkshopLibrary.h"
+
+// One details request finished, Details holds whatever items came back in no particular order
+DECLARE_DELEGATE_TwoParams(FOnSteamUGCDetailsPageLoaded, bool /*bWasSuccessful*/, const TArray<FBPSteamWorkshopItemDetails>& /*Details*/);
+
+/**
+ * The parts of the steam UGC API the details query uses, so a local stand-in can replace steam.
+ * Game thread only, OnLoaded fires from the source's own callback and never from inside RequestDetailsPage.
+ */
+class ADVANCEDSTEAMSESSIONS_API ISteamUGCSource
+{
+public:
+
+	virtual ~ISteamUGCSource() {}
+
+	// Most ids one details request can take
+	virtual int32 GetMaxItemsPerRequest() const = 0;
+
+	// Sends one details request and releases it once read, 0 if nothing was sent and OnLoaded won't fire
+	virtual uint32 RequestDetailsPage(const TArray<uint64>& PublishedFileIds, const FOnSteamUGCDetailsPageLoaded& OnLoaded) = 0;
+
+	// OnLoaded won't fire for the request after this
+	virtual void CancelRequest(uint32 RequestId) = 0;
+
+	// The real thing, null where steam isn't available
+	static TSharedPtr<ISteamUGCSource, ESPMode::ThreadSafe> CreateSteamworksSource();
+};
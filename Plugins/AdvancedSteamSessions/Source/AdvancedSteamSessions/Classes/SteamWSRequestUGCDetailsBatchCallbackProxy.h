@@ -0,0 +1,41 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AdvancedSteamWorkshopLibrary.h"
+#include "BlueprintDataDefinitions.h"
+#include "SteamUGCDetailsQuery.h"
+#include "SteamWSRequestUGCDetailsBatchCallbackProxy.generated.h"
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FBlueprintWorkshopDetailsArrayDelegate, const TArray<FBPSteamWorkshopItemDetails>&, WorkShopDetails);
+
+UCLASS(MinimalAPI)
+class USteamWSRequestUGCDetailsBatchCallbackProxy : public UOnlineBlueprintCallProxyBase
+{
+	GENERATED_UCLASS_BODY()
+
+	// Called when at least one page of details came back, items without details have ResultOfRequest set to a failure
+	UPROPERTY(BlueprintAssignable)
+	FBlueprintWorkshopDetailsArrayDelegate OnSuccess;
+
+	// Called when no details could be fetched at all
+	UPROPERTY(BlueprintAssignable)
+	FBlueprintWorkshopDetailsArrayDelegate OnFailure;
+
+	// Gets details for many workshop items at once, 50 per steam request, results are in the same order as the ids
+	UFUNCTION(BlueprintCallable, meta=(BlueprintInternalUseOnly = "true", WorldContext="WorldContextObject"), Category = "Online|AdvancedSteamWorkshop")
+	static USteamWSRequestUGCDetailsBatchCallbackProxy* GetWorkshopItemDetailsBatch(UObject* WorldContextObject, const TArray<FBPSteamWorkshopID>& WorkShopIDs);
+
+	// UOnlineBlueprintCallProxyBase interface
+	virtual void Activate() override;
+	// End of UOnlineBlueprintCallProxyBase interface
+
+private:
+
+	// Internal callback when the query completes, calls out to the public success/failure callbacks
+	void OnQueryComplete(bool bWasSuccessful, const TArray<FBPSteamWorkshopItemDetails>& Details);
+
+	TArray<FBPSteamWorkshopID> WorkShopIDs;
+	TUniquePtr<FSteamUGCDetailsQuery> Query;
+	UObject* WorldContextObject;
+};
@@ -0,0 +1,98 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "AdvancedSteamWorkshopLibrary.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * Workshop item details kept on disk between sessions, so a mod browser can draw from the last session's details before
+ * steam has answered anything. The file is a sorted index of (PublishedFileId, TimeUpdated, FetchedAt, offset, size)
+ * followed by the serialized details and is memory mapped, lookups binary search the index and only deserialize the
+ * entry asked for. New details are held in memory and the file is rewritten a little after the last Store, and on
+ * shutdown. An entry is stale when it is older than AdvancedSteamSessions.WorkshopCache.MaxAge or the installed
+ * content is newer than the details describe, stale entries are still returned so they can be shown while they are
+ * fetched again. Game thread only.
+ */
+class ADVANCEDSTEAMSESSIONS_API FSteamWorkshopDetailsCache
+{
+public:
+
+	static FSteamWorkshopDetailsCache& Get();
+
+	// Writes anything pending and closes the file
+	static void Shutdown();
+
+	// False if nothing is cached for the item, bOutStale says whether it should be fetched again
+	bool Find(uint64 PublishedFileId, FBPSteamWorkshopItemDetails& OutDetails, bool& bOutStale);
+
+	// Details that didn't come back from steam are ignored
+	void Store(const TArray<FBPSteamWorkshopItemDetails>& Details);
+	void Store(const FBPSteamWorkshopItemDetails& Details);
+
+	// Writes pending details to disk now
+	void Flush();
+
+	int32 GetNumPending() const { return Pending.Num(); }
+
+private:
+
+	FSteamWorkshopDetailsCache();
+	~FSteamWorkshopDetailsCache();
+
+	// On disk, little endian, followed by NumEntries FIndexEntry sorted by PublishedFileId and then the payloads
+	struct FFileHeader
+	{
+		uint32 Magic;
+		uint32 Version;
+		uint32 NumEntries;
+		uint32 Reserved;
+	};
+
+	struct FIndexEntry
+	{
+		uint64 PublishedFileId;
+		uint32 TimeUpdated;
+		uint32 FetchedAt;
+		uint32 Offset;
+		uint32 Size;
+	};
+
+	struct FPendingEntry
+	{
+		FBPSteamWorkshopItemDetails Details;
+		uint32 FetchedAt;
+	};
+
+	static FString GetCacheFilename();
+
+	void OpenFile();
+	void CloseFile();
+
+	// Entry in the mapped index, null if not there
+	const FIndexEntry* FindIndexEntry(uint64 PublishedFileId) const;
+	bool ReadEntry(const FIndexEntry& Entry, FBPSteamWorkshopItemDetails& OutDetails) const;
+
+	bool IsStale(uint64 PublishedFileId, uint32 TimeUpdated, uint32 FetchedAt) const;
+
+	bool FlushTick(float DeltaTime);
+
+	TMap<uint64, FPendingEntry> Pending;
+
+	// Points into the mapped region, or FallbackData if the platform can't map files
+	const uint8* FileData;
+	int64 FileSize;
+	const FIndexEntry* Index;
+	uint32 NumEntries;
+
+	IMappedFileHandle* MappedHandle;
+	IMappedFileRegion* MappedRegion;
+	TArray<uint8> FallbackData;
+
+	FDelegateHandle FlushTickerHandle;
+
+	static FSteamWorkshopDetailsCache* Instance;
+};
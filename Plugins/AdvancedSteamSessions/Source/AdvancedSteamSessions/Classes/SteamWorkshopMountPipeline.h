@@ -0,0 +1,74 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "Containers/Ticker.h"
+#include "AdvancedSteamWorkshopLibrary.h"
+
+DECLARE_DELEGATE_TwoParams(FOnSteamWorkshopMountProgress, int32 /*ItemsDone*/, int32 /*ItemsTotal*/);
+DECLARE_DELEGATE_OneParam(FOnSteamWorkshopMountComplete, const FBPSteamWorkshopMountReport& /*Report*/);
+
+/**
+ * Mounts the content of every subscribed workshop item.
+ * The slow part, checking each item's install state and finding the paks in its folder, runs in parallel on the
+ * thread pool. Mounting happens on the game thread in a fixed order, sorted by item id, and each item gets its own
+ * pak order (AdvancedSteamSessions.WorkshopMount.PakOrder plus its place in that order) so which item wins a file
+ * both ship doesn't depend on which scan finished first. Every content folder a mounted pak brings is registered as
+ * a mount point and scanned into the asset registry once everything is mounted. Paks already mounted by an earlier
+ * run are skipped.
+ */
+class ADVANCEDSTEAMSESSIONS_API FSteamWorkshopMountPipeline
+{
+public:
+
+	FSteamWorkshopMountPipeline(const FOnSteamWorkshopMountProgress& InOnProgress, const FOnSteamWorkshopMountComplete& InOnComplete);
+	~FSteamWorkshopMountPipeline();
+
+	// False if steam or the pak file system isn't available, OnComplete isn't called then
+	bool Start();
+
+	bool IsRunning() const { return TickerHandle.IsValid(); }
+
+private:
+
+	struct FItemScan
+	{
+		int32 ItemIndex;
+		bool bInstalled;
+		TArray<FString> PakFiles;
+	};
+
+	// Filled from thread pool threads, scans can still finish after the pipeline is gone
+	struct FInbox
+	{
+		TQueue<FItemScan, EQueueMode::Mpsc> Scans;
+	};
+
+	// Runs on a thread pool thread
+	static FItemScan ScanItem(int32 ItemIndex, uint64 PublishedFileId);
+
+	// Game thread, adds the content folders the item's paks brought to NewContentFolders
+	void MountItem(int32 ItemIndex, const FItemScan& Scan);
+
+	// Game thread, registers and scans the content folders mounted this run
+	void RegisterContent();
+
+	bool Tick(float DeltaTime);
+
+	FOnSteamWorkshopMountProgress OnProgress;
+	FOnSteamWorkshopMountComplete OnComplete;
+
+	TSharedRef<FInbox, ESPMode::ThreadSafe> Inbox;
+
+	// Sorted, ItemIndex points in here and decides both mount order and pak order
+	TArray<uint64> ItemIds;
+	TArray<TOptional<FItemScan>> Scans;
+	TSet<FString> NewContentFolders;
+
+	FBPSteamWorkshopMountReport Report;
+	int32 NumItemsDone;
+	int32 BasePakOrder;
+	double StartTime;
+	FDelegateHandle TickerHandle;
+};
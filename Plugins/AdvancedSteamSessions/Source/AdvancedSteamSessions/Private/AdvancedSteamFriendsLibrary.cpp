@@ -1,6 +1,10 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 #include "AdvancedSteamFriendsLibrary.h"
 #include "OnlineSubSystemHeader.h"
+#include "AdvancedSteamReadiness.h"
+#include "SteamAvatarCache.h"
+#include "SteamAvatarAtlas.h"
+#include "SteamGroupDirectory.h"
 
 //General Log
 DEFINE_LOG_CATEGORY(AdvancedSteamFriendsLog);
@@ -11,15 +15,15 @@ DEFINE_LOG_CATEGORY(AdvancedSteamFriendsLog);
 {
 
 #if PLATFORM_WINDOWS || PLATFORM_MAC || PLATFORM_LINUX
-	if (!UniqueNetId.IsValid() || !UniqueNetId.UniqueNetId->IsValid() || UniqueNetId.UniqueNetId->GetType() != STEAM_SUBSYSTEM)
+	if (!UniqueNetId.IsValid() || !UniqueNetId.GetUniqueNetId()->IsValid() || UniqueNetId.GetUniqueNetId()->GetType() != STEAM_SUBSYSTEM)
 	{
 		UE_LOG(AdvancedSteamFriendsLog, Warning, TEXT("IsAFriend Had a bad UniqueNetId!"));
 		return 0;
 	}
 
-	if (SteamAPI_Init())
+	if (AdvancedSteam::IsSteamReady())
 	{
-		uint64 id = *((uint64*)UniqueNetId.UniqueNetId->GetBytes());
+		uint64 id = *((uint64*)UniqueNetId.GetUniqueNetId()->GetBytes());
 
 
 		// clan (group) iteration and access functions
@@ -61,27 +65,10 @@ void UAdvancedSteamFriendsLibrary::GetSteamGroups(TArray<FBPSteamGroupInfo> & St
 	
 #if PLATFORM_WINDOWS || PLATFORM_MAC || PLATFORM_LINUX
 
-	if (SteamAPI_Init())
+	if (AdvancedSteam::IsSteamReady())
 	{
-		int numClans = SteamFriends()->GetClanCount();
-
-		for (int i = 0; i < numClans; i++)
-		{
-			CSteamID SteamGroupID = SteamFriends()->GetClanByIndex(i);
-
-			if(!SteamGroupID.IsValid())
-				continue;
-
-			FBPSteamGroupInfo GroupInfo;
-
-			TSharedPtr<const FUniqueNetId> ValueID(new const FUniqueNetIdSteam2(SteamGroupID));
-			GroupInfo.GroupID.SetUniqueNetId(ValueID);
-			SteamFriends()->GetClanActivityCounts(SteamGroupID, &GroupInfo.numOnline, &GroupInfo.numInGame, &GroupInfo.numChatting);
-			GroupInfo.GroupName = FString(UTF8_TO_TCHAR(SteamFriends()->GetClanName(SteamGroupID)));
-			GroupInfo.GroupTag = FString(UTF8_TO_TCHAR(SteamFriends()->GetClanTag(SteamGroupID)));
-
-			SteamGroups.Add(GroupInfo);
-		}
+		// Refreshed in the background while it keeps getting called
+		FSteamGroupDirectory::Get().GetGroups(SteamGroups);
 	}
 #endif
 
@@ -91,16 +78,16 @@ void UAdvancedSteamFriendsLibrary::GetSteamFriendGamePlayed(const FBPUniqueNetId
 {
 
 #if PLATFORM_WINDOWS || PLATFORM_MAC || PLATFORM_LINUX
-	if (!UniqueNetId.IsValid() || !UniqueNetId.UniqueNetId->IsValid() || UniqueNetId.UniqueNetId->GetType() != STEAM_SUBSYSTEM)
+	if (!UniqueNetId.IsValid() || !UniqueNetId.GetUniqueNetId()->IsValid() || UniqueNetId.GetUniqueNetId()->GetType() != STEAM_SUBSYSTEM)
 	{
 		UE_LOG(AdvancedSteamFriendsLog, Warning, TEXT("GetSteamFriendGamePlayed Had a bad UniqueNetId!"));
 		Result = EBlueprintResultSwitch::OnFailure;
 		return;
 	}
 
-	if (SteamAPI_Init())
+	if (AdvancedSteam::IsSteamReady())
 	{
-		uint64 id = *((uint64*)UniqueNetId.UniqueNetId->GetBytes());
+		uint64 id = *((uint64*)UniqueNetId.GetUniqueNetId()->GetBytes());
 
 		FriendGameInfo_t GameInfo;
 		bool bIsInGame = SteamFriends()->GetFriendGamePlayed(id, &GameInfo);
@@ -133,15 +120,15 @@ int32 UAdvancedSteamFriendsLibrary::GetFriendSteamLevel(const FBPUniqueNetId Uni
 {
 
 #if PLATFORM_WINDOWS || PLATFORM_MAC || PLATFORM_LINUX
-	if (!UniqueNetId.IsValid() || !UniqueNetId.UniqueNetId->IsValid() || UniqueNetId.UniqueNetId->GetType() != STEAM_SUBSYSTEM)
+	if (!UniqueNetId.IsValid() || !UniqueNetId.GetUniqueNetId()->IsValid() || UniqueNetId.GetUniqueNetId()->GetType() != STEAM_SUBSYSTEM)
 	{
 		UE_LOG(AdvancedSteamFriendsLog, Warning, TEXT("IsAFriend Had a bad UniqueNetId!"));
 		return 0;
 	}
 
-	if (SteamAPI_Init())
+	if (AdvancedSteam::IsSteamReady())
 	{
-		uint64 id = *((uint64*)UniqueNetId.UniqueNetId->GetBytes());
+		uint64 id = *((uint64*)UniqueNetId.GetUniqueNetId()->GetBytes());
 
 		return SteamFriends()->GetFriendSteamLevel(id);
 	}
@@ -154,15 +141,15 @@ FString UAdvancedSteamFriendsLibrary::GetSteamPersonaName(const FBPUniqueNetId U
 {
 
 #if PLATFORM_WINDOWS || PLATFORM_MAC || PLATFORM_LINUX
-	if (!UniqueNetId.IsValid() || !UniqueNetId.UniqueNetId->IsValid() || UniqueNetId.UniqueNetId->GetType() != STEAM_SUBSYSTEM)
+	if (!UniqueNetId.IsValid() || !UniqueNetId.GetUniqueNetId()->IsValid() || UniqueNetId.GetUniqueNetId()->GetType() != STEAM_SUBSYSTEM)
 	{
 		UE_LOG(AdvancedSteamFriendsLog, Warning, TEXT("GetSteamPersonaName Had a bad UniqueNetId!"));
 		return FString(TEXT(""));
 	}
 
-	if (SteamAPI_Init())
+	if (AdvancedSteam::IsSteamReady())
 	{
-		uint64 id = *((uint64*)UniqueNetId.UniqueNetId->GetBytes());
+		uint64 id = *((uint64*)UniqueNetId.GetUniqueNetId()->GetBytes());
 		const char* PersonaName = SteamFriends()->GetFriendPersonaName(id);
 		return FString(UTF8_TO_TCHAR(PersonaName));
 	}
@@ -182,7 +169,7 @@ FBPUniqueNetId UAdvancedSteamFriendsLibrary::CreateSteamIDFromString(const FStri
 		return netId;
 	}
 
-	if (SteamAPI_Init())
+	if (AdvancedSteam::IsSteamReady())
 	{
 		// Already does the conversion
 		TSharedPtr<const FUniqueNetId> ValueID(new const FUniqueNetIdSteam2(SteamID64));
@@ -201,7 +188,7 @@ FBPUniqueNetId UAdvancedSteamFriendsLibrary::GetLocalSteamIDFromSteam()
 	FBPUniqueNetId netId;
 
 #if PLATFORM_WINDOWS || PLATFORM_MAC || PLATFORM_LINUX
-	if (SteamAPI_Init())
+	if (AdvancedSteam::IsSteamReady())
 	{
 		TSharedPtr<const FUniqueNetId> SteamID(new const FUniqueNetIdSteam2(SteamUser()->GetSteamID()));
 		netId.SetUniqueNetId(SteamID);
@@ -211,18 +198,78 @@ FBPUniqueNetId UAdvancedSteamFriendsLibrary::GetLocalSteamIDFromSteam()
 	return netId;
 }
 
+FBPSteamAvatarAtlasSlot UAdvancedSteamFriendsLibrary::GetSteamFriendAvatarAtlasSlot(const FBPUniqueNetId UniqueNetId, EBlueprintAsyncResultSwitch &Result, SteamAvatarSize AvatarSize)
+{
+	FBPSteamAvatarAtlasSlot AtlasSlot;
+
+#if PLATFORM_WINDOWS || PLATFORM_MAC || PLATFORM_LINUX
+	if (!UniqueNetId.IsValid() || !UniqueNetId.GetUniqueNetId()->IsValid() || UniqueNetId.GetUniqueNetId()->GetType() != STEAM_SUBSYSTEM)
+	{
+		UE_LOG(AdvancedSteamFriendsLog, Warning, TEXT("GetSteamFriendAvatarAtlasSlot Had a bad UniqueNetId!"));
+		Result = EBlueprintAsyncResultSwitch::OnFailure;
+		return AtlasSlot;
+	}
+
+	TSharedPtr<ISteamAvatarImageSource, ESPMode::ThreadSafe> Source = FSteamAvatarCache::Get().GetImageSource();
+
+	if (Source.IsValid())
+	{
+		uint64 id = *((uint64*)UniqueNetId.GetUniqueNetId()->GetBytes());
+		const int32 Picture = Source->GetAvatarImage(id, (uint8)AvatarSize);
+
+		if (Picture == -1)
+		{
+			Result = EBlueprintAsyncResultSwitch::AsyncLoading;
+			return AtlasSlot;
+		}
+
+		FSteamAvatarAtlasSlot Slot;
+		if (FSteamAvatarAtlas::Get().FindOrAdd(id, (uint8)AvatarSize, Picture, Slot))
+		{
+			AtlasSlot.Atlas = Slot.Atlas;
+			AtlasSlot.UVMin = Slot.UVMin;
+			AtlasSlot.UVMax = Slot.UVMax;
+			AtlasSlot.PageIndex = Slot.PageIndex;
+			AtlasSlot.SlotIndex = Slot.SlotIndex;
+			AtlasSlot.Generation = (int32)Slot.Generation;
+
+			Result = EBlueprintAsyncResultSwitch::OnSuccess;
+			return AtlasSlot;
+		}
+
+		Result = EBlueprintAsyncResultSwitch::OnFailure;
+		return AtlasSlot;
+	}
+#endif
+
+	UE_LOG(AdvancedSteamFriendsLog, Warning, TEXT("STEAM Couldn't be verified as initialized"));
+	Result = EBlueprintAsyncResultSwitch::OnFailure;
+	return AtlasSlot;
+}
+
+bool UAdvancedSteamFriendsLibrary::IsSteamAvatarAtlasSlotCurrent(const FBPSteamAvatarAtlasSlot& AtlasSlot)
+{
+	FSteamAvatarAtlasSlot Slot;
+	Slot.Atlas = AtlasSlot.Atlas;
+	Slot.PageIndex = AtlasSlot.PageIndex;
+	Slot.SlotIndex = AtlasSlot.SlotIndex;
+	Slot.Generation = (uint32)AtlasSlot.Generation;
+
+	return FSteamAvatarAtlas::Get().IsSlotCurrent(Slot);
+}
+
 bool UAdvancedSteamFriendsLibrary::RequestSteamFriendInfo(const FBPUniqueNetId UniqueNetId, bool bRequireNameOnly)
 {
 #if PLATFORM_WINDOWS || PLATFORM_MAC || PLATFORM_LINUX
-	if (!UniqueNetId.IsValid() || !UniqueNetId.UniqueNetId->IsValid() || UniqueNetId.UniqueNetId->GetType() != STEAM_SUBSYSTEM)
+	if (!UniqueNetId.IsValid() || !UniqueNetId.GetUniqueNetId()->IsValid() || UniqueNetId.GetUniqueNetId()->GetType() != STEAM_SUBSYSTEM)
 	{
 		UE_LOG(AdvancedSteamFriendsLog, Warning, TEXT("RequestSteamFriendInfo Had a bad UniqueNetId!"));
 		return false;
 	}
 
-	if (SteamAPI_Init())
+	if (AdvancedSteam::IsSteamReady())
 	{
-		uint64 id = *((uint64*)UniqueNetId.UniqueNetId->GetBytes());
+		uint64 id = *((uint64*)UniqueNetId.GetUniqueNetId()->GetBytes());
 
 		return !SteamFriends()->RequestUserInformation(id, bRequireNameOnly);
 	}
@@ -236,15 +283,15 @@ bool UAdvancedSteamFriendsLibrary::RequestSteamFriendInfo(const FBPUniqueNetId U
 bool UAdvancedSteamFriendsLibrary::OpenSteamUserOverlay(const FBPUniqueNetId UniqueNetId, ESteamUserOverlayType DialogType)
 {
 #if PLATFORM_WINDOWS || PLATFORM_MAC || PLATFORM_LINUX
-	if (!UniqueNetId.IsValid() || !UniqueNetId.UniqueNetId->IsValid() || UniqueNetId.UniqueNetId->GetType() != STEAM_SUBSYSTEM)
+	if (!UniqueNetId.IsValid() || !UniqueNetId.GetUniqueNetId()->IsValid() || UniqueNetId.GetUniqueNetId()->GetType() != STEAM_SUBSYSTEM)
 	{
 		UE_LOG(AdvancedSteamFriendsLog, Warning, TEXT("OpenSteamUserOverlay Had a bad UniqueNetId!"));
 		return false;
 	}
 
-	if (SteamAPI_Init())
+	if (AdvancedSteam::IsSteamReady())
 	{
-		uint64 id = *((uint64*)UniqueNetId.UniqueNetId->GetBytes());
+		uint64 id = *((uint64*)UniqueNetId.GetUniqueNetId()->GetBytes());
 		FString DialogName = EnumToString("ESteamUserOverlayType", (uint8)DialogType);
 		SteamFriends()->ActivateGameOverlayToUser(TCHAR_TO_ANSI(*DialogName), id);
 		return true;
@@ -258,23 +305,20 @@ bool UAdvancedSteamFriendsLibrary::OpenSteamUserOverlay(const FBPUniqueNetId Uni
 UTexture2D * UAdvancedSteamFriendsLibrary::GetSteamFriendAvatar(const FBPUniqueNetId UniqueNetId, EBlueprintAsyncResultSwitch &Result, SteamAvatarSize AvatarSize)
 {
 #if PLATFORM_WINDOWS || PLATFORM_MAC || PLATFORM_LINUX
-	if (!UniqueNetId.IsValid() || !UniqueNetId.UniqueNetId->IsValid() || UniqueNetId.UniqueNetId->GetType() != STEAM_SUBSYSTEM)
+	if (!UniqueNetId.IsValid() || !UniqueNetId.GetUniqueNetId()->IsValid() || UniqueNetId.GetUniqueNetId()->GetType() != STEAM_SUBSYSTEM)
 	{
 		UE_LOG(AdvancedSteamFriendsLog, Warning, TEXT("GetSteamFriendAvatar Had a bad UniqueNetId!"));
 		Result = EBlueprintAsyncResultSwitch::OnFailure;
 		return nullptr;
 	}
 
-	uint32 Width = 0;
-	uint32 Height = 0;
-
-	if (SteamAPI_Init())
+	if (AdvancedSteam::IsSteamReady())
 	{
 		//Getting the PictureID from the SteamAPI and getting the Size with the ID
 		//virtual bool RequestUserInformation( CSteamID steamIDUser, bool bRequireNameOnly ) = 0;
 
 		
-		uint64 id = *((uint64*)UniqueNetId.UniqueNetId->GetBytes());
+		uint64 id = *((uint64*)UniqueNetId.GetUniqueNetId()->GetBytes());
 		int Picture = 0;
 		
 		switch(AvatarSize)
@@ -291,56 +335,14 @@ UTexture2D * UAdvancedSteamFriendsLibrary::GetSteamFriendAvatar(const FBPUniqueN
 			return NULL;
 		}
 
-		SteamUtils()->GetImageSize(Picture, &Width, &Height);
-
-		// STOLEN FROM ANSWERHUB :p, then fixed because answerhub wasn't releasing the memory O.o
-		// Also fixed image pixel format and switched to a memcpy instead of manual iteration.
-		// At some point I should probably reply to that answerhub post with these fixes to prevent people killing their games.....
+		// Cached per friend and size, only uploaded again if their avatar changed
+		UTexture2D* Avatar = FSteamAvatarCache::Get().FindOrCreate(id, (uint8)AvatarSize, Picture);
 
-		if (Width > 0 && Height > 0)
+		if (Avatar)
 		{
-			//Creating the buffer "oAvatarRGBA" and then filling it with the RGBA Stream from the Steam Avatar
-			uint8 *oAvatarRGBA = new uint8[Width * Height * 4];
-
-
-			//Filling the buffer with the RGBA Stream from the Steam Avatar and creating a UTextur2D to parse the RGBA Steam in
-			SteamUtils()->GetImageRGBA(Picture, (uint8*)oAvatarRGBA, 4 * Height * Width * sizeof(char));
-
-
-			// Removed as I changed the image bit code to be RGB, I think the original author was unaware that there were different pixel formats
-			/*
-			//Swap R and B channels because for some reason the games whack
-			for (uint32 i = 0; i < (Width * Height * 4); i += 4)
-			{
-				uint8 Temp = oAvatarRGBA[i + 0];
-				oAvatarRGBA[i + 0] = oAvatarRGBA[i + 2];
-				oAvatarRGBA[i + 2] = Temp;
-			}*/
-
-			UTexture2D* Avatar = UTexture2D::CreateTransient(Width, Height, PF_R8G8B8A8);
-			// Switched to a Memcpy instead of byte by byte transer
-			uint8* MipData = (uint8*)Avatar->PlatformData->Mips[0].BulkData.Lock(LOCK_READ_WRITE);
-			FMemory::Memcpy(MipData, (void*)oAvatarRGBA, Height * Width * 4);
-			Avatar->PlatformData->Mips[0].BulkData.Unlock();
-
-			// Original implementation was missing this!!
-			// the hell man......
-			delete[] oAvatarRGBA;
-
-			//Setting some Parameters for the Texture and finally returning it
-			Avatar->PlatformData->NumSlices = 1;
-			Avatar->NeverStream = true;
-			//Avatar->CompressionSettings = TC_EditorIcon;
-
-			Avatar->UpdateResource();
-
 			Result = EBlueprintAsyncResultSwitch::OnSuccess;
 			return Avatar;
 		}
-		else
-		{
-			UE_LOG(AdvancedSteamFriendsLog, Warning, TEXT("Bad Height / Width with steam avatar!"));
-		}
 
 		Result = EBlueprintAsyncResultSwitch::OnFailure;
 		return nullptr;
@@ -0,0 +1,82 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+#include "AdvancedSteamReadiness.h"
+#include "AdvancedSteamFriendsLibrary.h"
+
+#include "HAL/IConsoleManager.h"
+#include "Misc/ScopeLock.h"
+
+DEFINE_LOG_CATEGORY(AdvancedSteamReadinessLog);
+
+DEFINE_STAT(STAT_SteamAPIInitCalls);
+DEFINE_STAT(STAT_SteamAPIInitCallsAvoided);
+
+static TAutoConsoleVariable<float> CVarSteamInitRetryInterval(
+	TEXT("AdvancedSteamSessions.SteamInitRetryInterval"),
+	5.f,
+	TEXT("Seconds between attempts to initialize the steam API after one failed."),
+	ECVF_Default);
+
+namespace AdvancedSteam
+{
+	enum class ESteamState : int32
+	{
+		Unknown,
+		Ready,
+		Failed
+	};
+
+	static TAtomic<int32> SteamState((int32)ESteamState::Unknown);
+	static double LastInitAttemptTime = 0.0;
+	static FCriticalSection InitLock;
+
+	bool IsSteamReady()
+	{
+		const ESteamState State = (ESteamState)SteamState.Load(EMemoryOrder::Relaxed);
+
+		if (State == ESteamState::Ready)
+		{
+			INC_DWORD_STAT(STAT_SteamAPIInitCallsAvoided);
+			return true;
+		}
+
+		if (State == ESteamState::Failed)
+		{
+			// Unlocked read, worst case two threads both find it time to retry and the lock sorts it out
+			if (FPlatformTime::Seconds() - LastInitAttemptTime < CVarSteamInitRetryInterval.GetValueOnAnyThread())
+				return false;
+		}
+
+		return EnsureSteamAPI();
+	}
+
+	bool EnsureSteamAPI()
+	{
+		FScopeLock ScopeLock(&InitLock);
+
+		if ((ESteamState)SteamState.Load() == ESteamState::Ready)
+			return true;
+
+		LastInitAttemptTime = FPlatformTime::Seconds();
+		bool bReady = false;
+
+#if PLATFORM_WINDOWS || PLATFORM_MAC || PLATFORM_LINUX
+		INC_DWORD_STAT(STAT_SteamAPIInitCalls);
+		bReady = SteamAPI_Init();
+#endif
+
+		SteamState = (int32)(bReady ? ESteamState::Ready : ESteamState::Failed);
+
+		if (!bReady)
+		{
+			UE_LOG(AdvancedSteamReadinessLog, Verbose, TEXT("SteamAPI_Init failed, retrying in %.1f seconds"), CVarSteamInitRetryInterval.GetValueOnAnyThread());
+		}
+
+		return bReady;
+	}
+
+	void ResetSteamAPI()
+	{
+		FScopeLock ScopeLock(&InitLock);
+		SteamState = (int32)ESteamState::Unknown;
+	}
+}
@@ -1,12 +1,43 @@
 //#include "StandAlonePrivatePCH.h"
 #include "AdvancedSteamSessions.h"
+#include "SteamAvatarCache.h"
+#include "SteamAvatarLoader.h"
+#include "SteamAvatarAtlas.h"
+#include "SteamWorkshopDetailsCache.h"
+#include "SteamUGCDetailsQuery.h"
+#include "SteamGroupDirectory.h"
+#include "SteamGroupOfficerCache.h"
+#include "AdvancedSteamReadiness.h"
+#include "Misc/CoreDelegates.h"
 
 void AdvancedSteamSessions::StartupModule()
 {
+	// The steam subsystem usually loads after us, in that case initialize once the engine is up
+	if (FModuleManager::Get().IsModuleLoaded("OnlineSubsystemSteam"))
+	{
+		AdvancedSteam::EnsureSteamAPI();
+	}
+	else
+	{
+		PostEngineInitHandle = FCoreDelegates::OnPostEngineInit.AddLambda([]()
+		{
+			AdvancedSteam::EnsureSteamAPI();
+		});
+	}
 }
  
 void AdvancedSteamSessions::ShutdownModule()
 {
+	FSteamAvatarLoader::Shutdown();
+	FSteamAvatarAtlas::Shutdown();
+	FSteamAvatarCache::Shutdown();
+	FSteamWorkshopDetailsCache::Shutdown();
+	FSteamGroupDirectory::Shutdown();
+	FSteamGroupOfficerCache::Shutdown();
+	FSteamUGCDetailsQuery::SetSource(nullptr);
+
+	FCoreDelegates::OnPostEngineInit.Remove(PostEngineInitHandle);
+	AdvancedSteam::ResetSteamAPI();
 }
  
 IMPLEMENT_MODULE(AdvancedSteamSessions, AdvancedSteamSessions)
\ No newline at end of file
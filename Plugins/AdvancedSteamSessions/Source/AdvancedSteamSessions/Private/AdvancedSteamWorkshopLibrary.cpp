@@ -1,6 +1,8 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 #include "AdvancedSteamWorkshopLibrary.h"
 #include "OnlineSubSystemHeader.h"
+#include "AdvancedSteamReadiness.h"
+#include "SteamWorkshopDetailsCache.h"
 //General Log
 DEFINE_LOG_CATEGORY(AdvancedSteamWorkshopLog);
 
@@ -10,7 +12,7 @@ void UAdvancedSteamWorkshopLibrary::GetNumSubscribedWorkshopItems(int32 & Number
 	NumberOfItems = 0;
 #if PLATFORM_WINDOWS || PLATFORM_MAC || PLATFORM_LINUX
 
-	if (SteamAPI_Init())
+	if (AdvancedSteam::IsSteamReady())
 	{
 		NumberOfItems = SteamUGC()->GetNumSubscribedItems();
 		return;
@@ -33,7 +35,7 @@ TArray<FBPSteamWorkshopID> UAdvancedSteamWorkshopLibrary::GetSubscribedWorkshopI
 
 #if PLATFORM_WINDOWS || PLATFORM_MAC || PLATFORM_LINUX
 
-	if (SteamAPI_Init())
+	if (AdvancedSteam::IsSteamReady())
 	{
 		uint32 NumItems = SteamUGC()->GetNumSubscribedItems();
 		
@@ -67,3 +69,36 @@ TArray<FBPSteamWorkshopID> UAdvancedSteamWorkshopLibrary::GetSubscribedWorkshopI
 	UE_LOG(AdvancedSteamWorkshopLog, Warning, TEXT("Error in GetSubscribedWorkshopItemCount : Called on an incompatible platform"));
 	return outArray;
 }
+
+TArray<FBPSteamWorkshopItemDetails> UAdvancedSteamWorkshopLibrary::GetCachedWorkshopItemDetails(const TArray<FBPSteamWorkshopID>& WorkShopIDs, TArray<FBPSteamWorkshopID>& StaleIDs)
+{
+	TArray<FBPSteamWorkshopItemDetails> outArray;
+	outArray.Reserve(WorkShopIDs.Num());
+	StaleIDs.Reset();
+
+	FSteamWorkshopDetailsCache& Cache = FSteamWorkshopDetailsCache::Get();
+
+	for (const FBPSteamWorkshopID& WorkShopID : WorkShopIDs)
+	{
+		FBPSteamWorkshopItemDetails Details;
+		bool bStale = false;
+
+		// A miss keeps its place as a failed entry, the same as a batch request that got nothing back for it
+		if (!Cache.Find(WorkShopID.SteamWorkshopID, Details, bStale))
+		{
+			Details = FBPSteamWorkshopItemDetails();
+			Details.PublishedFileId = WorkShopID;
+			Details.ResultOfRequest = FBPSteamResult::k_EResultFail;
+			bStale = true;
+		}
+
+		outArray.Add(Details);
+
+		if (bStale)
+		{
+			StaleIDs.Add(WorkShopID);
+		}
+	}
+
+	return outArray;
+}
@@ -0,0 +1,53 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#include "GetSteamFriendAvatarCallbackProxy.h"
+#include "SteamAvatarLoader.h"
+
+//////////////////////////////////////////////////////////////////////////
+// UGetSteamFriendAvatarCallbackProxy
+
+UGetSteamFriendAvatarCallbackProxy::UGetSteamFriendAvatarCallbackProxy(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+	, AvatarSize(SteamAvatarSize::SteamAvatar_Medium)
+	, WorldContextObject(nullptr)
+{
+}
+
+UGetSteamFriendAvatarCallbackProxy* UGetSteamFriendAvatarCallbackProxy::GetSteamFriendAvatarAsync(UObject* WorldContextObject, const FBPUniqueNetId UniqueNetId, SteamAvatarSize AvatarSize)
+{
+	UGetSteamFriendAvatarCallbackProxy* Proxy = NewObject<UGetSteamFriendAvatarCallbackProxy>();
+
+	Proxy->UniqueNetId = UniqueNetId;
+	Proxy->AvatarSize = AvatarSize;
+	Proxy->WorldContextObject = WorldContextObject;
+	return Proxy;
+}
+
+void UGetSteamFriendAvatarCallbackProxy::Activate()
+{
+#if PLATFORM_WINDOWS || PLATFORM_MAC || PLATFORM_LINUX
+	if (UniqueNetId.IsValid() && UniqueNetId.GetUniqueNetId()->IsValid() && UniqueNetId.GetUniqueNetId()->GetType() == STEAM_SUBSYSTEM)
+	{
+		uint64 id = *((uint64*)UniqueNetId.GetUniqueNetId()->GetBytes());
+
+		FSteamAvatarLoader::Get().RequestAvatar(id, (uint8)AvatarSize, FOnSteamAvatarReady::CreateUObject(this, &UGetSteamFriendAvatarCallbackProxy::OnAvatarReady));
+		return;
+	}
+
+	UE_LOG(AdvancedSteamFriendsLog, Warning, TEXT("GetSteamFriendAvatarAsync Had a bad UniqueNetId!"));
+#endif
+
+	OnFailure.Broadcast(nullptr);
+}
+
+void UGetSteamFriendAvatarCallbackProxy::OnAvatarReady(UTexture2D* Avatar)
+{
+	if (Avatar)
+	{
+		OnSuccess.Broadcast(Avatar);
+	}
+	else
+	{
+		OnFailure.Broadcast(nullptr);
+	}
+}
@@ -0,0 +1,52 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#include "MountSteamWorkshopItemsCallbackProxy.h"
+
+//////////////////////////////////////////////////////////////////////////
+// UMountSteamWorkshopItemsCallbackProxy
+
+UMountSteamWorkshopItemsCallbackProxy::UMountSteamWorkshopItemsCallbackProxy(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+}
+
+UMountSteamWorkshopItemsCallbackProxy* UMountSteamWorkshopItemsCallbackProxy::MountSubscribedWorkshopItems(UObject* WorldContextObject)
+{
+	UMountSteamWorkshopItemsCallbackProxy* Proxy = NewObject<UMountSteamWorkshopItemsCallbackProxy>();
+
+	Proxy->WorldContextObject = WorldContextObject;
+	return Proxy;
+}
+
+void UMountSteamWorkshopItemsCallbackProxy::Activate()
+{
+	Pipeline = MakeUnique<FSteamWorkshopMountPipeline>(
+		FOnSteamWorkshopMountProgress::CreateUObject(this, &UMountSteamWorkshopItemsCallbackProxy::OnMountProgress),
+		FOnSteamWorkshopMountComplete::CreateUObject(this, &UMountSteamWorkshopItemsCallbackProxy::OnMountComplete));
+
+	if (!Pipeline->Start())
+	{
+		Pipeline.Reset();
+		OnFailure.Broadcast(FBPSteamWorkshopMountReport());
+	}
+}
+
+void UMountSteamWorkshopItemsCallbackProxy::OnMountProgress(int32 ItemsDone, int32 ItemsTotal)
+{
+	OnProgress.Broadcast(ItemsDone, ItemsTotal);
+}
+
+void UMountSteamWorkshopItemsCallbackProxy::OnMountComplete(const FBPSteamWorkshopMountReport& Report)
+{
+	// Report is a copy owned by the caller, safe to let go of the pipeline first
+	Pipeline.Reset();
+
+	if (Report.NumPaksFailed == 0)
+	{
+		OnSuccess.Broadcast(Report);
+	}
+	else
+	{
+		OnFailure.Broadcast(Report);
+	}
+}
@@ -0,0 +1,273 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+#include "SteamAvatarAtlas.h"
+
+#include "Engine/Texture2D.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<int32> CVarAvatarAtlasPageSize(
+	TEXT("AdvancedSteamSessions.AvatarAtlas.PageSize"),
+	1024,
+	TEXT("Width and height of an avatar atlas page in pixels, only read when a page is created."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarAvatarAtlasMaxPages(
+	TEXT("AdvancedSteamSessions.AvatarAtlas.MaxPages"),
+	2,
+	TEXT("Most atlas pages per avatar size before slots are reused, least recently looked up first."),
+	ECVF_Default);
+
+FSteamAvatarAtlas* FSteamAvatarAtlas::Instance = nullptr;
+
+FSteamAvatarAtlas& FSteamAvatarAtlas::Get()
+{
+	if (!Instance)
+	{
+		Instance = new FSteamAvatarAtlas();
+	}
+	return *Instance;
+}
+
+void FSteamAvatarAtlas::Shutdown()
+{
+	delete Instance;
+	Instance = nullptr;
+}
+
+FSteamAvatarAtlas::FSteamAvatarAtlas()
+	: UseCounter(0)
+{
+}
+
+int32 FSteamAvatarAtlas::GetSlotSize(uint8 AvatarSize)
+{
+	// SteamAvatarSize values, steam's small and medium avatars are always these sizes
+	switch (AvatarSize)
+	{
+	case 1: return 32;
+	case 2: return 64;
+	default: return 0;
+	}
+}
+
+bool FSteamAvatarAtlas::FindOrAdd(uint64 SteamId, uint8 AvatarSize, int32 ImageHandle, FSteamAvatarAtlasSlot& OutSlot)
+{
+	const int32 SlotSize = GetSlotSize(AvatarSize);
+	if (SlotSize == 0 || ImageHandle <= 0)
+		return false;
+
+	const FSteamAvatarKey Key(SteamId, AvatarSize);
+
+	FAtlasEntry* Entry = Entries.Find(Key);
+	if (Entry && Entry->ImageHandle == ImageHandle)
+	{
+		Entry->LastUsed = ++UseCounter;
+		FillSlot(*Entry, OutSlot);
+		return true;
+	}
+
+	TSharedPtr<ISteamAvatarImageSource, ESPMode::ThreadSafe> Source = FSteamAvatarCache::Get().GetImageSource();
+
+	uint32 Width = 0;
+	uint32 Height = 0;
+
+	if (!Source.IsValid() || !Source->GetImageSize(ImageHandle, Width, Height) || Width != (uint32)SlotSize || Height != (uint32)SlotSize)
+		return false;
+
+	// A changed avatar goes into the slot it already has
+	if (!Entry)
+	{
+		int32 PageIndex = INDEX_NONE;
+		int32 SlotIndex = INDEX_NONE;
+
+		if (!AllocateSlot(AvatarSize, PageIndex, SlotIndex))
+			return false;
+
+		Entry = &Entries.Add(Key);
+		Entry->PageIndex = PageIndex;
+		Entry->SlotIndex = SlotIndex;
+	}
+
+	if (!Upload(*Entry, ImageHandle, *Source))
+	{
+		FAtlasPage& Page = Pages[Entry->PageIndex];
+		Page.FreeSlots.Add(Entry->SlotIndex);
+		++Page.SlotGenerations[Entry->SlotIndex];
+		Entries.Remove(Key);
+		return false;
+	}
+
+	Entry->ImageHandle = ImageHandle;
+	Entry->LastUsed = ++UseCounter;
+
+	FillSlot(*Entry, OutSlot);
+	return true;
+}
+
+bool FSteamAvatarAtlas::AllocateSlot(uint8 AvatarSize, int32& OutPageIndex, int32& OutSlotIndex)
+{
+	int32 NumPages = 0;
+
+	for (int32 PageIndex = 0; PageIndex < Pages.Num(); ++PageIndex)
+	{
+		FAtlasPage& Page = Pages[PageIndex];
+		if (Page.AvatarSize != AvatarSize)
+			continue;
+
+		++NumPages;
+
+		if (Page.FreeSlots.Num() > 0)
+		{
+			OutPageIndex = PageIndex;
+			OutSlotIndex = Page.FreeSlots.Pop(false);
+			return true;
+		}
+	}
+
+	if (NumPages < FMath::Max(1, CVarAvatarAtlasMaxPages.GetValueOnGameThread()))
+	{
+		const int32 PageIndex = AddPage(AvatarSize);
+		if (PageIndex == INDEX_NONE)
+			return false;
+
+		OutPageIndex = PageIndex;
+		OutSlotIndex = Pages[PageIndex].FreeSlots.Pop(false);
+		return true;
+	}
+
+	// Full, take the slot of whoever was looked up longest ago
+	const FSteamAvatarKey* Oldest = nullptr;
+	uint64 OldestUse = MAX_uint64;
+
+	for (const TPair<FSteamAvatarKey, FAtlasEntry>& Pair : Entries)
+	{
+		if (Pair.Key.AvatarSize == AvatarSize && Pair.Value.LastUsed < OldestUse)
+		{
+			OldestUse = Pair.Value.LastUsed;
+			Oldest = &Pair.Key;
+		}
+	}
+
+	if (!Oldest)
+		return false;
+
+	const FSteamAvatarKey EvictedKey = *Oldest;
+	FAtlasEntry Evicted;
+	Entries.RemoveAndCopyValue(EvictedKey, Evicted);
+
+	// Anyone still holding the old UVs sees a different generation from here on
+	++Pages[Evicted.PageIndex].SlotGenerations[Evicted.SlotIndex];
+
+	OutPageIndex = Evicted.PageIndex;
+	OutSlotIndex = Evicted.SlotIndex;
+
+	OnSlotEvicted.Broadcast(EvictedKey.SteamId, EvictedKey.AvatarSize);
+	return true;
+}
+
+bool FSteamAvatarAtlas::IsSlotCurrent(const FSteamAvatarAtlasSlot& Slot) const
+{
+	if (!Pages.IsValidIndex(Slot.PageIndex))
+		return false;
+
+	const FAtlasPage& Page = Pages[Slot.PageIndex];
+	return Page.Texture == Slot.Atlas && Page.SlotGenerations.IsValidIndex(Slot.SlotIndex) && Page.SlotGenerations[Slot.SlotIndex] == Slot.Generation;
+}
+
+int32 FSteamAvatarAtlas::AddPage(uint8 AvatarSize)
+{
+	const int32 SlotSize = GetSlotSize(AvatarSize);
+	const int32 PageSize = FMath::Max(SlotSize, (int32)FMath::RoundUpToPowerOfTwo((uint32)FMath::Max(1, CVarAvatarAtlasPageSize.GetValueOnGameThread())));
+
+	UTexture2D* Texture = UTexture2D::CreateTransient(PageSize, PageSize, PF_R8G8B8A8);
+	if (!Texture)
+		return INDEX_NONE;
+
+	// Empty slots are transparent
+	void* MipData = Texture->PlatformData->Mips[0].BulkData.Lock(LOCK_READ_WRITE);
+	FMemory::Memzero(MipData, PageSize * PageSize * 4);
+	Texture->PlatformData->Mips[0].BulkData.Unlock();
+
+	Texture->PlatformData->NumSlices = 1;
+	Texture->NeverStream = true;
+	Texture->UpdateResource();
+
+	FAtlasPage& Page = Pages.AddDefaulted_GetRef();
+	Page.Texture = Texture;
+	Page.AvatarSize = AvatarSize;
+	Page.SlotSize = SlotSize;
+	Page.SlotsPerRow = PageSize / SlotSize;
+
+	// Popped from the back, so fill from the top left
+	const int32 NumSlots = Page.SlotsPerRow * Page.SlotsPerRow;
+	Page.FreeSlots.Reserve(NumSlots);
+	Page.SlotGenerations.Init(1, NumSlots);
+	for (int32 SlotIndex = NumSlots - 1; SlotIndex >= 0; --SlotIndex)
+	{
+		Page.FreeSlots.Add(SlotIndex);
+	}
+
+	UE_LOG(AdvancedSteamAvatarLog, Verbose, TEXT("Added avatar atlas page %d for avatar size %d (%d slots)"), Pages.Num() - 1, AvatarSize, NumSlots);
+	return Pages.Num() - 1;
+}
+
+bool FSteamAvatarAtlas::Upload(const FAtlasEntry& Entry, int32 ImageHandle, ISteamAvatarImageSource& Source)
+{
+	const FAtlasPage& Page = Pages[Entry.PageIndex];
+	if (!Page.Texture || !Page.Texture->Resource)
+		return false;
+
+	const uint32 Size = Page.SlotSize * Page.SlotSize * 4;
+	TSharedRef<FSteamAvatarStagingPool, ESPMode::ThreadSafe> Pool = FSteamAvatarCache::Get().GetStagingPool();
+	uint8* Staging = Pool->Acquire(Size);
+
+	if (!Source.GetImageRGBA(ImageHandle, Staging, Size))
+	{
+		Pool->Release(Staging, Size);
+		return false;
+	}
+
+	const int32 DestX = (Entry.SlotIndex % Page.SlotsPerRow) * Page.SlotSize;
+	const int32 DestY = (Entry.SlotIndex / Page.SlotsPerRow) * Page.SlotSize;
+	FUpdateTextureRegion2D* Region = new FUpdateTextureRegion2D(DestX, DestY, 0, 0, Page.SlotSize, Page.SlotSize);
+
+	// The render thread hands the buffer back once it has been copied
+	Page.Texture->UpdateTextureRegions(0, 1, Region, Page.SlotSize * 4, 4, Staging, [Pool, Size](uint8* SrcData, const FUpdateTextureRegion2D* Regions)
+	{
+		Pool->Release(SrcData, Size);
+		delete Regions;
+	});
+
+	return true;
+}
+
+void FSteamAvatarAtlas::FillSlot(const FAtlasEntry& Entry, FSteamAvatarAtlasSlot& OutSlot) const
+{
+	const FAtlasPage& Page = Pages[Entry.PageIndex];
+	const float PageSize = (float)(Page.SlotsPerRow * Page.SlotSize);
+
+	const float X = (float)((Entry.SlotIndex % Page.SlotsPerRow) * Page.SlotSize);
+	const float Y = (float)((Entry.SlotIndex / Page.SlotsPerRow) * Page.SlotSize);
+
+	// Half a texel in from the edges so filtering doesn't pick up the neighbouring avatar
+	OutSlot.Atlas = Page.Texture;
+	OutSlot.UVMin = FVector2D((X + 0.5f) / PageSize, (Y + 0.5f) / PageSize);
+	OutSlot.UVMax = FVector2D((X + Page.SlotSize - 0.5f) / PageSize, (Y + Page.SlotSize - 0.5f) / PageSize);
+
+	OutSlot.PageIndex = Entry.PageIndex;
+	OutSlot.SlotIndex = Entry.SlotIndex;
+	OutSlot.Generation = Page.SlotGenerations[Entry.SlotIndex];
+}
+
+void FSteamAvatarAtlas::Empty()
+{
+	Entries.Empty();
+	Pages.Empty();
+}
+
+void FSteamAvatarAtlas::AddReferencedObjects(FReferenceCollector& Collector)
+{
+	for (FAtlasPage& Page : Pages)
+	{
+		Collector.AddReferencedObject(Page.Texture);
+	}
+}
@@ -0,0 +1,291 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+#include "SteamAvatarCache.h"
+
+#include "Engine/Texture2D.h"
+#include "HAL/IConsoleManager.h"
+
+DEFINE_LOG_CATEGORY(AdvancedSteamAvatarLog);
+
+static TAutoConsoleVariable<float> CVarAvatarCacheBudgetMB(
+	TEXT("AdvancedSteamSessions.AvatarCache.BudgetMB"),
+	32.f,
+	TEXT("Megabytes of avatar textures kept cached before the least recently used ones are dropped."),
+	ECVF_Default);
+
+// Spare staging buffers kept per image size, a frame's worth of uploads rarely needs more
+static const int32 MaxFreeStagingBuffers = 8;
+
+FSteamAvatarCache* FSteamAvatarCache::Instance = nullptr;
+
+FSteamAvatarStagingPool::~FSteamAvatarStagingPool()
+{
+	for (TPair<uint32, TArray<uint8*>>& Pair : FreeBuffers)
+	{
+		for (uint8* Buffer : Pair.Value)
+		{
+			FMemory::Free(Buffer);
+		}
+	}
+}
+
+uint8* FSteamAvatarStagingPool::Acquire(uint32 Size)
+{
+	{
+		FScopeLock ScopeLock(&Lock);
+
+		TArray<uint8*>* Free = FreeBuffers.Find(Size);
+		if (Free && Free->Num() > 0)
+		{
+			return Free->Pop(false);
+		}
+	}
+
+	return (uint8*)FMemory::Malloc(Size);
+}
+
+void FSteamAvatarStagingPool::Release(uint8* Buffer, uint32 Size)
+{
+	{
+		FScopeLock ScopeLock(&Lock);
+
+		TArray<uint8*>& Free = FreeBuffers.FindOrAdd(Size);
+		if (Free.Num() < MaxFreeStagingBuffers)
+		{
+			Free.Add(Buffer);
+			return;
+		}
+	}
+
+	FMemory::Free(Buffer);
+}
+
+FSteamAvatarCache& FSteamAvatarCache::Get()
+{
+	if (!Instance)
+	{
+		Instance = new FSteamAvatarCache();
+	}
+	return *Instance;
+}
+
+void FSteamAvatarCache::Shutdown()
+{
+	delete Instance;
+	Instance = nullptr;
+}
+
+FSteamAvatarCache::FSteamAvatarCache()
+	: UsedBytes(0)
+	, UseCounter(0)
+	, StagingBuffers(MakeShared<FSteamAvatarStagingPool, ESPMode::ThreadSafe>())
+{
+}
+
+void FSteamAvatarCache::SetImageSource(const TSharedPtr<ISteamAvatarImageSource, ESPMode::ThreadSafe>& NewSource)
+{
+	ImageSource = NewSource;
+	Empty();
+}
+
+TSharedPtr<ISteamAvatarImageSource, ESPMode::ThreadSafe> FSteamAvatarCache::GetImageSource()
+{
+	if (!ImageSource.IsValid())
+	{
+		ImageSource = ISteamAvatarImageSource::CreateSteamworksSource();
+	}
+	return ImageSource;
+}
+
+UTexture2D* FSteamAvatarCache::Find(const FSteamAvatarKey& Key, int32 ImageHandle)
+{
+	FAvatarEntry* Entry = Entries.Find(Key);
+
+	if (Entry && Entry->Texture && Entry->ImageHandle == ImageHandle)
+	{
+		Entry->LastUsed = ++UseCounter;
+		return Entry->Texture;
+	}
+
+	return nullptr;
+}
+
+UTexture2D* FSteamAvatarCache::FindOrCreate(uint64 SteamId, uint8 AvatarSize, int32 ImageHandle)
+{
+	const FSteamAvatarKey Key(SteamId, AvatarSize);
+
+	if (UTexture2D* Cached = Find(Key, ImageHandle))
+		return Cached;
+
+	TSharedPtr<ISteamAvatarImageSource, ESPMode::ThreadSafe> Source = GetImageSource();
+
+	uint32 Width = 0;
+	uint32 Height = 0;
+
+	if (!Source.IsValid() || !Source->GetImageSize(ImageHandle, Width, Height) || Width == 0 || Height == 0)
+	{
+		UE_LOG(AdvancedSteamAvatarLog, Warning, TEXT("Bad Height / Width with steam avatar!"));
+		return nullptr;
+	}
+
+	const uint32 Size = Width * Height * 4;
+
+	// They changed their avatar, put the new one into the texture they already have if it fits
+	FAvatarEntry* Entry = Entries.Find(Key);
+	if (Entry && Entry->Texture && Entry->Width == Width && Entry->Height == Height)
+	{
+		uint8* Staging = StagingBuffers->Acquire(Size);
+
+		if (!Source->GetImageRGBA(ImageHandle, Staging, Size))
+		{
+			StagingBuffers->Release(Staging, Size);
+			return nullptr;
+		}
+
+		return UpdateEntry(*Entry, ImageHandle, Staging);
+	}
+
+	// No intermediate buffer, steam fills the mip directly
+	UTexture2D* Texture = CreateTexture(Width, Height, [&Source, ImageHandle, Size](uint8* MipData)
+	{
+		return Source->GetImageRGBA(ImageHandle, MipData, Size);
+	});
+
+	return Texture ? AddEntry(Key, ImageHandle, Width, Height, Texture) : nullptr;
+}
+
+UTexture2D* FSteamAvatarCache::AddImage(const FSteamAvatarKey& Key, int32 ImageHandle, uint32 Width, uint32 Height, uint8* Staging)
+{
+	const uint32 Size = Width * Height * 4;
+
+	FAvatarEntry* Entry = Entries.Find(Key);
+	if (Entry && Entry->Texture && Entry->Width == Width && Entry->Height == Height)
+	{
+		return UpdateEntry(*Entry, ImageHandle, Staging);
+	}
+
+	UTexture2D* Texture = CreateTexture(Width, Height, [Staging, Size](uint8* MipData)
+	{
+		FMemory::Memcpy(MipData, Staging, Size);
+		return true;
+	});
+
+	StagingBuffers->Release(Staging, Size);
+
+	return Texture ? AddEntry(Key, ImageHandle, Width, Height, Texture) : nullptr;
+}
+
+UTexture2D* FSteamAvatarCache::CreateTexture(uint32 Width, uint32 Height, TFunctionRef<bool(uint8*)> Fill)
+{
+	UTexture2D* Avatar = UTexture2D::CreateTransient(Width, Height, PF_R8G8B8A8);
+	if (!Avatar)
+		return nullptr;
+
+	uint8* MipData = (uint8*)Avatar->PlatformData->Mips[0].BulkData.Lock(LOCK_READ_WRITE);
+	const bool bFilled = Fill(MipData);
+	Avatar->PlatformData->Mips[0].BulkData.Unlock();
+
+	if (!bFilled)
+	{
+		UE_LOG(AdvancedSteamAvatarLog, Warning, TEXT("Steam couldn't provide the avatar image data!"));
+		return nullptr;
+	}
+
+	Avatar->PlatformData->NumSlices = 1;
+	Avatar->NeverStream = true;
+	Avatar->UpdateResource();
+
+	return Avatar;
+}
+
+UTexture2D* FSteamAvatarCache::UpdateEntry(FAvatarEntry& Entry, int32 ImageHandle, uint8* Staging)
+{
+	const uint32 Size = Entry.Width * Entry.Height * 4;
+
+	if (!Entry.Texture->Resource)
+	{
+		StagingBuffers->Release(Staging, Size);
+		return nullptr;
+	}
+
+	FUpdateTextureRegion2D* Region = new FUpdateTextureRegion2D(0, 0, 0, 0, Entry.Width, Entry.Height);
+	TSharedRef<FSteamAvatarStagingPool, ESPMode::ThreadSafe> Pool = StagingBuffers;
+
+	// The render thread hands the buffer back once it has been copied
+	Entry.Texture->UpdateTextureRegions(0, 1, Region, Entry.Width * 4, 4, Staging, [Pool, Size](uint8* SrcData, const FUpdateTextureRegion2D* Regions)
+	{
+		Pool->Release(SrcData, Size);
+		delete Regions;
+	});
+
+	Entry.ImageHandle = ImageHandle;
+	Entry.LastUsed = ++UseCounter;
+	return Entry.Texture;
+}
+
+UTexture2D* FSteamAvatarCache::AddEntry(const FSteamAvatarKey& Key, int32 ImageHandle, uint32 Width, uint32 Height, UTexture2D* Texture)
+{
+	// A different sized image for the same key replaces it outright
+	Remove(Key.SteamId, Key.AvatarSize);
+
+	const uint64 Bytes = (uint64)Width * Height * 4;
+	EvictToBudget(Bytes);
+
+	FAvatarEntry& NewEntry = Entries.Add(Key);
+	NewEntry.Texture = Texture;
+	NewEntry.ImageHandle = ImageHandle;
+	NewEntry.Width = Width;
+	NewEntry.Height = Height;
+	NewEntry.LastUsed = ++UseCounter;
+
+	UsedBytes += Bytes;
+	return Texture;
+}
+
+void FSteamAvatarCache::EvictToBudget(uint64 BytesNeeded)
+{
+	const int64 Budget = (int64)(FMath::Max(0.f, CVarAvatarCacheBudgetMB.GetValueOnGameThread()) * 1024.f * 1024.f);
+
+	// Least recently used first. A single avatar bigger than the whole budget is still cached on its own
+	while (Entries.Num() > 0 && UsedBytes + (int64)BytesNeeded > Budget)
+	{
+		const FSteamAvatarKey* Oldest = nullptr;
+		uint64 OldestUse = MAX_uint64;
+
+		for (const TPair<FSteamAvatarKey, FAvatarEntry>& Pair : Entries)
+		{
+			if (Pair.Value.LastUsed < OldestUse)
+			{
+				OldestUse = Pair.Value.LastUsed;
+				Oldest = &Pair.Key;
+			}
+		}
+
+		const FSteamAvatarKey Key = *Oldest;
+		UE_LOG(AdvancedSteamAvatarLog, Verbose, TEXT("Dropping cached avatar %llu (size %d) to stay in budget"), Key.SteamId, Key.AvatarSize);
+		Remove(Key.SteamId, Key.AvatarSize);
+	}
+}
+
+void FSteamAvatarCache::Remove(uint64 SteamId, uint8 AvatarSize)
+{
+	FAvatarEntry Entry;
+	if (Entries.RemoveAndCopyValue(FSteamAvatarKey(SteamId, AvatarSize), Entry))
+	{
+		// The texture itself is left to the garbage collector, something may still be showing it
+		UsedBytes -= (int64)Entry.Width * Entry.Height * 4;
+	}
+}
+
+void FSteamAvatarCache::Empty()
+{
+	Entries.Empty();
+	UsedBytes = 0;
+}
+
+void FSteamAvatarCache::AddReferencedObjects(FReferenceCollector& Collector)
+{
+	for (TPair<FSteamAvatarKey, FAvatarEntry>& Pair : Entries)
+	{
+		Collector.AddReferencedObject(Pair.Value.Texture);
+	}
+}
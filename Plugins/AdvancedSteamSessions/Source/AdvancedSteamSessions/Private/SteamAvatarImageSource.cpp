@@ -0,0 +1,71 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+#include "SteamAvatarImageSource.h"
+#include "AdvancedSteamFriendsLibrary.h"
+#include "AdvancedSteamReadiness.h"
+
+#if PLATFORM_WINDOWS || PLATFORM_MAC || PLATFORM_LINUX
+
+class FSteamworksAvatarImageSource : public ISteamAvatarImageSource
+{
+public:
+
+	FSteamworksAvatarImageSource()
+		: AvatarLoadedCallback(this, &FSteamworksAvatarImageSource::OnAvatarLoaded)
+	{
+	}
+
+	virtual int32 GetAvatarImage(uint64 SteamId, uint8 AvatarSize) override
+	{
+		if (!AdvancedSteam::IsSteamReady())
+			return 0;
+
+		switch ((SteamAvatarSize)AvatarSize)
+		{
+		case SteamAvatarSize::SteamAvatar_Small: return SteamFriends()->GetSmallFriendAvatar(SteamId);
+		case SteamAvatarSize::SteamAvatar_Medium: return SteamFriends()->GetMediumFriendAvatar(SteamId);
+		case SteamAvatarSize::SteamAvatar_Large: return SteamFriends()->GetLargeFriendAvatar(SteamId);
+		default: return 0;
+		}
+	}
+
+	virtual void RequestAvatar(uint64 SteamId) override
+	{
+		if (AdvancedSteam::IsSteamReady())
+		{
+			SteamFriends()->RequestUserInformation(SteamId, false);
+		}
+	}
+
+	virtual bool GetImageSize(int32 ImageHandle, uint32& OutWidth, uint32& OutHeight) override
+	{
+		return AdvancedSteam::IsSteamReady() && SteamUtils()->GetImageSize(ImageHandle, &OutWidth, &OutHeight);
+	}
+
+	virtual bool GetImageRGBA(int32 ImageHandle, uint8* Buffer, uint32 BufferSize) override
+	{
+		return AdvancedSteam::IsSteamReady() && SteamUtils()->GetImageRGBA(ImageHandle, Buffer, BufferSize);
+	}
+
+private:
+
+	STEAM_CALLBACK(FSteamworksAvatarImageSource, OnAvatarLoaded, AvatarImageLoaded_t, AvatarLoadedCallback);
+};
+
+void FSteamworksAvatarImageSource::OnAvatarLoaded(AvatarImageLoaded_t* pParam)
+{
+	OnAvatarImageLoaded.ExecuteIfBound(pParam->m_steamID.ConvertToUint64());
+}
+
+#endif
+
+TSharedPtr<ISteamAvatarImageSource, ESPMode::ThreadSafe> ISteamAvatarImageSource::CreateSteamworksSource()
+{
+#if PLATFORM_WINDOWS || PLATFORM_MAC || PLATFORM_LINUX
+	if (AdvancedSteam::IsSteamReady())
+	{
+		return MakeShared<FSteamworksAvatarImageSource, ESPMode::ThreadSafe>();
+	}
+#endif
+
+	return nullptr;
+}
@@ -0,0 +1,300 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+#include "SteamAvatarLoader.h"
+
+#include "Async/Async.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<int32> CVarAvatarLoaderUploadsPerFrame(
+	TEXT("AdvancedSteamSessions.AvatarLoader.UploadsPerFrame"),
+	4,
+	TEXT("Most decoded avatars turned into textures in a single frame, the rest wait for the next."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarAvatarLoaderTimeout(
+	TEXT("AdvancedSteamSessions.AvatarLoader.Timeout"),
+	15.f,
+	TEXT("Seconds to wait for steam to download an avatar before the request fails."),
+	ECVF_Default);
+
+FSteamAvatarLoader* FSteamAvatarLoader::Instance = nullptr;
+
+FSteamAvatarLoader& FSteamAvatarLoader::Get()
+{
+	if (!Instance)
+	{
+		Instance = new FSteamAvatarLoader();
+	}
+	return *Instance;
+}
+
+void FSteamAvatarLoader::Shutdown()
+{
+	delete Instance;
+	Instance = nullptr;
+}
+
+FSteamAvatarLoader::FSteamAvatarLoader()
+	: Inbox(MakeShared<FInbox, ESPMode::ThreadSafe>())
+{
+}
+
+FSteamAvatarLoader::~FSteamAvatarLoader()
+{
+	if (TickerHandle.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+	}
+
+	if (TSharedPtr<ISteamAvatarImageSource, ESPMode::ThreadSafe> Source = BoundSource.Pin())
+	{
+		Source->OnAvatarImageLoaded.Unbind();
+	}
+
+	for (const FDecodedImage& Image : UploadQueue)
+	{
+		FMemory::Free(Image.Staging);
+	}
+}
+
+FSteamAvatarLoader::FInbox::~FInbox()
+{
+	FDecodedImage Image;
+	while (Decoded.Dequeue(Image))
+	{
+		FMemory::Free(Image.Staging);
+	}
+}
+
+void FSteamAvatarLoader::BindSource(const TSharedPtr<ISteamAvatarImageSource, ESPMode::ThreadSafe>& Source)
+{
+	TSharedPtr<ISteamAvatarImageSource, ESPMode::ThreadSafe> OldSource = BoundSource.Pin();
+	if (OldSource == Source)
+		return;
+
+	if (OldSource.IsValid())
+	{
+		OldSource->OnAvatarImageLoaded.Unbind();
+	}
+
+	// Requests waiting on the old source would never hear back
+	TArray<FSteamAvatarKey> Waiting;
+	for (const TPair<FSteamAvatarKey, FRequest>& Pair : Requests)
+	{
+		if (Pair.Value.State == ERequestState::WaitingForSteam)
+		{
+			Waiting.Add(Pair.Key);
+		}
+	}
+
+	for (const FSteamAvatarKey& Key : Waiting)
+	{
+		Finish(Key, nullptr);
+	}
+
+	BoundSource = Source;
+
+	TWeakPtr<FInbox, ESPMode::ThreadSafe> WeakInbox = Inbox;
+	Source->OnAvatarImageLoaded.BindLambda([WeakInbox](uint64 SteamId)
+	{
+		if (TSharedPtr<FInbox, ESPMode::ThreadSafe> PinnedInbox = WeakInbox.Pin())
+		{
+			PinnedInbox->Loaded.Enqueue(SteamId);
+		}
+	});
+}
+
+void FSteamAvatarLoader::RequestAvatar(uint64 SteamId, uint8 AvatarSize, const FOnSteamAvatarReady& OnReady)
+{
+	FSteamAvatarCache& Cache = FSteamAvatarCache::Get();
+	TSharedPtr<ISteamAvatarImageSource, ESPMode::ThreadSafe> Source = Cache.GetImageSource();
+
+	if (!Source.IsValid())
+	{
+		OnReady.ExecuteIfBound(nullptr);
+		return;
+	}
+
+	BindSource(Source);
+
+	const FSteamAvatarKey Key(SteamId, AvatarSize);
+
+	// Already on its way, share the load
+	if (FRequest* Existing = Requests.Find(Key))
+	{
+		Existing->Callbacks.Add(OnReady);
+		return;
+	}
+
+	const int32 ImageHandle = Source->GetAvatarImage(SteamId, AvatarSize);
+
+	if (ImageHandle == 0)
+	{
+		OnReady.ExecuteIfBound(nullptr);
+		return;
+	}
+
+	if (ImageHandle > 0)
+	{
+		if (UTexture2D* Cached = Cache.Find(Key, ImageHandle))
+		{
+			OnReady.ExecuteIfBound(Cached);
+			return;
+		}
+	}
+
+	FRequest& Request = Requests.Add(Key);
+	Request.State = ERequestState::WaitingForSteam;
+	Request.StartTime = FPlatformTime::Seconds();
+	Request.Callbacks.Add(OnReady);
+
+	if (ImageHandle < 0)
+	{
+		Source->RequestAvatar(SteamId);
+	}
+	else
+	{
+		TryStartDecode(Key, Request, *Source);
+	}
+
+	EnsureTicker();
+}
+
+bool FSteamAvatarLoader::TryStartDecode(const FSteamAvatarKey& Key, FRequest& Request, ISteamAvatarImageSource& Source)
+{
+	const int32 ImageHandle = Source.GetAvatarImage(Key.SteamId, Key.AvatarSize);
+
+	if (ImageHandle < 0)
+		return false;
+
+	if (ImageHandle == 0)
+	{
+		Finish(Key, nullptr);
+		return true;
+	}
+
+	Request.State = ERequestState::Decoding;
+
+	TSharedPtr<ISteamAvatarImageSource, ESPMode::ThreadSafe> SourcePtr = BoundSource.Pin();
+	TSharedRef<FSteamAvatarStagingPool, ESPMode::ThreadSafe> Pool = FSteamAvatarCache::Get().GetStagingPool();
+	TSharedRef<FInbox, ESPMode::ThreadSafe> TaskInbox = Inbox;
+
+	Async(EAsyncExecution::ThreadPool, [SourcePtr, Pool, TaskInbox, Key, ImageHandle]()
+	{
+		FDecodedImage Image;
+		Image.Key = Key;
+		Image.ImageHandle = ImageHandle;
+
+		if (SourcePtr.IsValid() && SourcePtr->GetImageSize(ImageHandle, Image.Width, Image.Height) && Image.Width > 0 && Image.Height > 0)
+		{
+			const uint32 Size = Image.Width * Image.Height * 4;
+			Image.Staging = Pool->Acquire(Size);
+
+			if (!SourcePtr->GetImageRGBA(ImageHandle, Image.Staging, Size))
+			{
+				Pool->Release(Image.Staging, Size);
+				Image.Staging = nullptr;
+			}
+		}
+
+		TaskInbox->Decoded.Enqueue(Image);
+	});
+
+	return true;
+}
+
+void FSteamAvatarLoader::Finish(const FSteamAvatarKey& Key, UTexture2D* Avatar)
+{
+	FRequest Request;
+	if (!Requests.RemoveAndCopyValue(Key, Request))
+		return;
+
+	for (const FOnSteamAvatarReady& Callback : Request.Callbacks)
+	{
+		Callback.ExecuteIfBound(Avatar);
+	}
+}
+
+void FSteamAvatarLoader::EnsureTicker()
+{
+	if (!TickerHandle.IsValid())
+	{
+		TickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FSteamAvatarLoader::Tick));
+	}
+}
+
+bool FSteamAvatarLoader::Tick(float DeltaTime)
+{
+	TSharedPtr<ISteamAvatarImageSource, ESPMode::ThreadSafe> Source = BoundSource.Pin();
+	const double Now = FPlatformTime::Seconds();
+
+	// Avatars steam finished downloading
+	uint64 LoadedId = 0;
+	while (Inbox->Loaded.Dequeue(LoadedId))
+	{
+		for (int32 AvatarSize = 1; Source.IsValid() && AvatarSize <= 3; ++AvatarSize)
+		{
+			const FSteamAvatarKey Key(LoadedId, (uint8)AvatarSize);
+			FRequest* Request = Requests.Find(Key);
+
+			if (Request && Request->State == ERequestState::WaitingForSteam)
+			{
+				TryStartDecode(Key, *Request, *Source);
+			}
+		}
+	}
+
+	// Callbacks can go missing, check once more before giving up
+	const float Timeout = CVarAvatarLoaderTimeout.GetValueOnGameThread();
+	TArray<FSteamAvatarKey, TInlineAllocator<8>> TimedOut;
+
+	for (TPair<FSteamAvatarKey, FRequest>& Pair : Requests)
+	{
+		if (Pair.Value.State == ERequestState::WaitingForSteam && (Now - Pair.Value.StartTime) > Timeout)
+		{
+			TimedOut.Add(Pair.Key);
+		}
+	}
+
+	for (const FSteamAvatarKey& Key : TimedOut)
+	{
+		FRequest* Request = Requests.Find(Key);
+		if (Request && !(Source.IsValid() && TryStartDecode(Key, *Request, *Source)))
+		{
+			UE_LOG(AdvancedSteamAvatarLog, Warning, TEXT("Timed out waiting for steam to load avatar %llu!"), Key.SteamId);
+			Finish(Key, nullptr);
+		}
+	}
+
+	FDecodedImage Decoded;
+	while (Inbox->Decoded.Dequeue(Decoded))
+	{
+		UploadQueue.Add(Decoded);
+	}
+
+	// Texture creation is the expensive part on this thread, spread it out
+	const int32 UploadBudget = FMath::Max(1, CVarAvatarLoaderUploadsPerFrame.GetValueOnGameThread());
+	const int32 NumUploads = FMath::Min(UploadBudget, UploadQueue.Num());
+
+	for (int32 i = 0; i < NumUploads; ++i)
+	{
+		const FDecodedImage& Image = UploadQueue[i];
+		UTexture2D* Avatar = nullptr;
+
+		if (Image.Staging)
+		{
+			Avatar = FSteamAvatarCache::Get().AddImage(Image.Key, Image.ImageHandle, Image.Width, Image.Height, Image.Staging);
+		}
+
+		Finish(Image.Key, Avatar);
+	}
+
+	UploadQueue.RemoveAt(0, NumUploads, false);
+
+	if (Requests.Num() == 0 && UploadQueue.Num() == 0)
+	{
+		TickerHandle.Reset();
+		return false;
+	}
+
+	return true;
+}
@@ -0,0 +1,210 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+#include "SteamGroupDirectory.h"
+#include "AdvancedSteamReadiness.h"
+
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<float> CVarGroupDirectoryRefreshInterval(
+	TEXT("AdvancedSteamSessions.GroupDirectory.RefreshInterval"),
+	30.f,
+	TEXT("Seconds between refreshes of the steam group list and its activity counts."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarGroupDirectoryNameRefreshInterval(
+	TEXT("AdvancedSteamSessions.GroupDirectory.NameRefreshInterval"),
+	600.f,
+	TEXT("Seconds before a steam group's name and tag are read again."),
+	ECVF_Default);
+
+FSteamGroupDirectory* FSteamGroupDirectory::Instance = nullptr;
+
+FSteamGroupDirectory& FSteamGroupDirectory::Get()
+{
+	if (!Instance)
+	{
+		Instance = new FSteamGroupDirectory();
+	}
+	return *Instance;
+}
+
+void FSteamGroupDirectory::Shutdown()
+{
+	delete Instance;
+	Instance = nullptr;
+}
+
+FSteamGroupDirectory::FSteamGroupDirectory()
+	: LastRefreshTime(0.0)
+	, LastAccessTime(0.0)
+	, bHasMembership(false)
+	, bCountsInFlight(false)
+{
+}
+
+FSteamGroupDirectory::~FSteamGroupDirectory()
+{
+	if (TickerHandle.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+	}
+}
+
+void FSteamGroupDirectory::GetGroups(TArray<FBPSteamGroupInfo>& OutGroups)
+{
+	LastAccessTime = FPlatformTime::Seconds();
+
+	if (!bHasMembership)
+	{
+		// First ask fills in straight away, counts are steam's local ones until the download finishes
+		UpdateMembership();
+		RequestActivityCounts();
+	}
+
+	OutGroups.Reserve(OutGroups.Num() + GroupOrder.Num());
+	for (uint64 GroupId : GroupOrder)
+	{
+		OutGroups.Add(Groups[GroupId].Info);
+	}
+
+	if (!TickerHandle.IsValid())
+	{
+		TickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FSteamGroupDirectory::Tick), 1.f);
+	}
+}
+
+void FSteamGroupDirectory::MarkDirty()
+{
+	LastRefreshTime = 0.0;
+}
+
+void FSteamGroupDirectory::UpdateMembership()
+{
+#if PLATFORM_WINDOWS || PLATFORM_MAC || PLATFORM_LINUX
+	if (!AdvancedSteam::IsSteamReady())
+		return;
+
+	const double Now = FPlatformTime::Seconds();
+	const float NameRefreshInterval = CVarGroupDirectoryNameRefreshInterval.GetValueOnGameThread();
+
+	const int32 NumClans = SteamFriends()->GetClanCount();
+
+	TArray<uint64> NewOrder;
+	NewOrder.Reserve(NumClans);
+
+	for (int32 i = 0; i < NumClans; ++i)
+	{
+		CSteamID SteamGroupID = SteamFriends()->GetClanByIndex(i);
+
+		if (!SteamGroupID.IsValid())
+			continue;
+
+		const uint64 GroupId = SteamGroupID.ConvertToUint64();
+		NewOrder.Add(GroupId);
+
+		FGroupEntry* Entry = Groups.Find(GroupId);
+
+		if (!Entry)
+		{
+			Entry = &Groups.Add(GroupId);
+			TSharedPtr<const FUniqueNetId> ValueID(new const FUniqueNetIdSteam2(SteamGroupID));
+			Entry->Info.GroupID.SetUniqueNetId(ValueID);
+			Entry->Info.numOnline = 0;
+			Entry->Info.numInGame = 0;
+			Entry->Info.numChatting = 0;
+
+			// Whatever steam already has locally, so a new group doesn't read as empty until the download finishes
+			SteamFriends()->GetClanActivityCounts(SteamGroupID, &Entry->Info.numOnline, &Entry->Info.numInGame, &Entry->Info.numChatting);
+			Entry->NamesReadTime = TNumericLimits<double>::Lowest();
+		}
+
+		if (Now - Entry->NamesReadTime >= NameRefreshInterval)
+		{
+			Entry->Info.GroupName = FString(UTF8_TO_TCHAR(SteamFriends()->GetClanName(SteamGroupID)));
+			Entry->Info.GroupTag = FString(UTF8_TO_TCHAR(SteamFriends()->GetClanTag(SteamGroupID)));
+			Entry->NamesReadTime = Now;
+		}
+	}
+
+	// Groups the user has left
+	if (NewOrder.Num() != Groups.Num())
+	{
+		TSet<uint64> Current(NewOrder);
+		for (auto It = Groups.CreateIterator(); It; ++It)
+		{
+			if (!Current.Contains(It.Key()))
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+
+	GroupOrder = MoveTemp(NewOrder);
+	bHasMembership = true;
+	LastRefreshTime = Now;
+#endif
+}
+
+void FSteamGroupDirectory::RequestActivityCounts()
+{
+#if PLATFORM_WINDOWS || PLATFORM_MAC || PLATFORM_LINUX
+	if (bCountsInFlight || GroupOrder.Num() == 0 || !AdvancedSteam::IsSteamReady())
+		return;
+
+	TArray<CSteamID> GroupIds;
+	GroupIds.Reserve(GroupOrder.Num());
+	for (uint64 GroupId : GroupOrder)
+	{
+		GroupIds.Add(CSteamID(GroupId));
+	}
+
+	SteamAPICall_t hSteamAPICall = SteamFriends()->DownloadClanActivityCounts(GroupIds.GetData(), GroupIds.Num());
+
+	if (hSteamAPICall == k_uAPICallInvalid)
+		return;
+
+	bCountsInFlight = true;
+	m_callResultDownloadClanActivityCounts.Set(hSteamAPICall, this, &FSteamGroupDirectory::OnDownloadClanActivityCounts);
+#endif
+}
+
+#if PLATFORM_WINDOWS || PLATFORM_MAC || PLATFORM_LINUX
+void FSteamGroupDirectory::OnDownloadClanActivityCounts(DownloadClanActivityCountsResult_t *pResult, bool bIOFailure)
+{
+	bCountsInFlight = false;
+
+	if (bIOFailure || !pResult || !pResult->m_bSuccess || !AdvancedSteam::IsSteamReady())
+	{
+		UE_LOG(AdvancedSteamFriendsLog, Verbose, TEXT("FSteamGroupDirectory: Failed to download clan activity counts, keeping the last ones"));
+		return;
+	}
+
+	// Downloaded counts are local now, read them all in one go
+	for (TPair<uint64, FGroupEntry>& Pair : Groups)
+	{
+		FBPSteamGroupInfo& Info = Pair.Value.Info;
+		SteamFriends()->GetClanActivityCounts(CSteamID(Pair.Key), &Info.numOnline, &Info.numInGame, &Info.numChatting);
+	}
+}
+#endif
+
+bool FSteamGroupDirectory::Tick(float DeltaTime)
+{
+	const double Now = FPlatformTime::Seconds();
+	const float RefreshInterval = FMath::Max(1.f, CVarGroupDirectoryRefreshInterval.GetValueOnGameThread());
+
+	// Nobody has looked in a while, stop refreshing until someone asks again
+	if (Now - LastAccessTime > RefreshInterval * 2.f)
+	{
+		bHasMembership = false;
+		TickerHandle.Reset();
+		return false;
+	}
+
+	if (Now - LastRefreshTime >= RefreshInterval)
+	{
+		UpdateMembership();
+		RequestActivityCounts();
+	}
+
+	return true;
+}
@@ -0,0 +1,155 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+#include "SteamGroupOfficerCache.h"
+#include "AdvancedSteamFriendsLibrary.h"
+#include "AdvancedSteamReadiness.h"
+
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<float> CVarGroupOfficersCacheLifetime(
+	TEXT("AdvancedSteamSessions.GroupOfficers.CacheLifetime"),
+	30.f,
+	TEXT("Seconds a steam group's officer list is reused before it is requested again, 0 only shares requests already in flight."),
+	ECVF_Default);
+
+FSteamGroupOfficerCache* FSteamGroupOfficerCache::Instance = nullptr;
+
+FSteamGroupOfficerCache& FSteamGroupOfficerCache::Get()
+{
+	if (!Instance)
+	{
+		Instance = new FSteamGroupOfficerCache();
+	}
+	return *Instance;
+}
+
+void FSteamGroupOfficerCache::Shutdown()
+{
+	delete Instance;
+	Instance = nullptr;
+}
+
+FSteamGroupOfficerCache::FSteamGroupOfficerCache()
+{
+}
+
+void FSteamGroupOfficerCache::RequestOfficers(uint64 GroupId, const FOnSteamGroupOfficersReady& OnReady)
+{
+	if (const FCachedList* Cached = Cache.Find(GroupId))
+	{
+		if (FPlatformTime::Seconds() - Cached->Time < CVarGroupOfficersCacheLifetime.GetValueOnGameThread())
+		{
+			OnReady.ExecuteIfBound(true, Cached->Officers);
+			return;
+		}
+
+		Cache.Remove(GroupId);
+	}
+
+	// Someone already asked, wait on their answer
+	if (TUniquePtr<FPendingRequest>* Existing = Pending.Find(GroupId))
+	{
+		(*Existing)->Callbacks.Add(OnReady);
+		return;
+	}
+
+	TUniquePtr<FPendingRequest> Request = MakeUnique<FPendingRequest>(*this, GroupId);
+
+	if (!Request->Send())
+	{
+		OnReady.ExecuteIfBound(false, TArray<FBPSteamGroupOfficer>());
+		return;
+	}
+
+	Request->Callbacks.Add(OnReady);
+	Pending.Add(GroupId, MoveTemp(Request));
+}
+
+void FSteamGroupOfficerCache::Invalidate(uint64 GroupId)
+{
+	Cache.Remove(GroupId);
+}
+
+void FSteamGroupOfficerCache::Empty()
+{
+	Cache.Empty();
+}
+
+void FSteamGroupOfficerCache::Finish(uint64 GroupId, bool bWasSuccessful, const TArray<FBPSteamGroupOfficer>& Officers)
+{
+	TUniquePtr<FPendingRequest> Request;
+	if (!Pending.RemoveAndCopyValue(GroupId, Request))
+		return;
+
+	if (bWasSuccessful)
+	{
+		FCachedList& Cached = Cache.Add(GroupId);
+		Cached.Officers = Officers;
+		Cached.Time = FPlatformTime::Seconds();
+	}
+
+	for (const FOnSteamGroupOfficersReady& Callback : Request->Callbacks)
+	{
+		Callback.ExecuteIfBound(bWasSuccessful, Officers);
+	}
+}
+
+FSteamGroupOfficerCache::FPendingRequest::FPendingRequest(FSteamGroupOfficerCache& InOwner, uint64 InGroupId)
+	: GroupId(InGroupId)
+	, Owner(InOwner)
+{
+}
+
+bool FSteamGroupOfficerCache::FPendingRequest::Send()
+{
+#if PLATFORM_WINDOWS || PLATFORM_MAC || PLATFORM_LINUX
+	if (!AdvancedSteam::IsSteamReady())
+		return false;
+
+	SteamAPICall_t hSteamAPICall = SteamFriends()->RequestClanOfficerList(GroupId);
+
+	if (hSteamAPICall == k_uAPICallInvalid)
+		return false;
+
+	m_callResultGroupOfficerRequestDetails.Set(hSteamAPICall, this, &FPendingRequest::OnRequestGroupOfficerDetails);
+	return true;
+#else
+	return false;
+#endif
+}
+
+#if PLATFORM_WINDOWS || PLATFORM_MAC || PLATFORM_LINUX
+void FSteamGroupOfficerCache::FPendingRequest::OnRequestGroupOfficerDetails(ClanOfficerListResponse_t *pResult, bool bIOFailure)
+{
+	TArray<FBPSteamGroupOfficer> OfficerArray;
+
+	if (bIOFailure || !pResult || !pResult->m_bSuccess || !AdvancedSteam::IsSteamReady())
+	{
+		// Destroys this request, nothing can touch it afterwards
+		Owner.Finish(GroupId, false, OfficerArray);
+		return;
+	}
+
+	FBPSteamGroupOfficer Officer;
+	CSteamID ClanOwner = SteamFriends()->GetClanOwner(GroupId);
+
+	Officer.bIsOwner = true;
+
+	TSharedPtr<const FUniqueNetId> ValueID(new const FUniqueNetIdSteam2(ClanOwner));
+	Officer.OfficerUniqueNetID.SetUniqueNetId(ValueID);
+	OfficerArray.Add(Officer);
+
+	for (int i = 0; i < pResult->m_cOfficers; i++)
+	{
+		CSteamID OfficerSteamID = SteamFriends()->GetClanOfficerByIndex(GroupId, i);
+
+		Officer.bIsOwner = false;
+
+		TSharedPtr<const FUniqueNetId> newValueID(new const FUniqueNetIdSteam2(OfficerSteamID));
+		Officer.OfficerUniqueNetID.SetUniqueNetId(newValueID);
+
+		OfficerArray.Add(Officer);
+	}
+
+	Owner.Finish(GroupId, true, OfficerArray);
+}
+#endif
@@ -4,6 +4,8 @@
 #include "UObject/CoreOnline.h"
 #include "AdvancedSteamFriendsLibrary.h"
 #include "OnlineSubSystemHeader.h"
+#include "AdvancedSteamReadiness.h"
+#include "SteamGroupOfficerCache.h"
 #if PLATFORM_WINDOWS || PLATFORM_MAC || PLATFORM_LINUX
 #include "steam/isteamfriends.h"
 #endif
@@ -32,12 +34,10 @@ USteamRequestGroupOfficersCallbackProxy* USteamRequestGroupOfficersCallbackProxy
 void USteamRequestGroupOfficersCallbackProxy::Activate()
 {
 #if PLATFORM_WINDOWS || PLATFORM_MAC || PLATFORM_LINUX
-	if (SteamAPI_Init())
+	if (GroupUniqueID.IsValid() && AdvancedSteam::IsSteamReady())
 	{
-		uint64 id = *((uint64*)GroupUniqueID.UniqueNetId->GetBytes());
-		SteamAPICall_t hSteamAPICall = SteamFriends()->RequestClanOfficerList(id);
-	
-		m_callResultGroupOfficerRequestDetails.Set(hSteamAPICall, this, &USteamRequestGroupOfficersCallbackProxy::OnRequestGroupOfficerDetails);
+		uint64 id = *((uint64*)GroupUniqueID.GetUniqueNetId()->GetBytes());
+		FSteamGroupOfficerCache::Get().RequestOfficers(id, FOnSteamGroupOfficersReady::CreateUObject(this, &USteamRequestGroupOfficersCallbackProxy::OnOfficersReady));
 		return;
 	}
 #endif
@@ -45,77 +45,24 @@ void USteamRequestGroupOfficersCallbackProxy::Activate()
 	OnFailure.Broadcast(EmptyArray);
 }
 
-#if PLATFORM_WINDOWS || PLATFORM_MAC || PLATFORM_LINUX
-void USteamRequestGroupOfficersCallbackProxy::OnRequestGroupOfficerDetails(ClanOfficerListResponse_t *pResult, bool bIOFailure)
+void USteamRequestGroupOfficersCallbackProxy::OnOfficersReady(bool bWasSuccessful, const TArray<FBPSteamGroupOfficer>& OfficerList)
 {
-	TArray<FBPSteamGroupOfficer> OfficerArray;
-	
+#if PLATFORM_WINDOWS || PLATFORM_MAC || PLATFORM_LINUX
 	FOnlineSubsystemSteam* SteamSubsystem = (FOnlineSubsystemSteam*)(IOnlineSubsystem::Get(STEAM_SUBSYSTEM));
 
-	if (bIOFailure || !pResult || !pResult->m_bSuccess)
+	if (SteamSubsystem != nullptr)
 	{
-		if (SteamSubsystem != nullptr)
-		{
-			SteamSubsystem->ExecuteNextTick([this]()
-			{
-				TArray<FBPSteamGroupOfficer> FailureArray;
-				OnFailure.Broadcast(FailureArray);
-			});
-		}
-		//OnFailure.Broadcast(OfficerArray);
-		return;
-	}
-
-	if (SteamAPI_Init())
-	{
-		uint64 id = *((uint64*)GroupUniqueID.UniqueNetId->GetBytes());
-
-		FBPSteamGroupOfficer Officer;
-		CSteamID ClanOwner = SteamFriends()->GetClanOwner(id);
-
-		Officer.bIsOwner = true;
-
-		TSharedPtr<const FUniqueNetId> ValueID(new const FUniqueNetIdSteam2(ClanOwner));
-		Officer.OfficerUniqueNetID.SetUniqueNetId(ValueID);
-		OfficerArray.Add(Officer);
-
-		for (int i = 0; i < pResult->m_cOfficers; i++)
-		{
-			CSteamID OfficerSteamID = SteamFriends()->GetClanOfficerByIndex(id, i);
-
-			Officer.bIsOwner = false;
-
-			TSharedPtr<const FUniqueNetId> newValueID(new const FUniqueNetIdSteam2(OfficerSteamID));
-			Officer.OfficerUniqueNetID.SetUniqueNetId(newValueID);
-
-			OfficerArray.Add(Officer);
-		}
-
-		if (SteamSubsystem != nullptr)
+		SteamSubsystem->ExecuteNextTick([bWasSuccessful, OfficerList, this]()
 		{
-			SteamSubsystem->ExecuteNextTick([OfficerArray, this]()
+			if (bWasSuccessful)
 			{
-				OnSuccess.Broadcast(OfficerArray);
-			});
-		}
-
-		//OnSuccess.Broadcast(OfficerArray);
-		return;
-	}
-	else
-	{
-		if (SteamSubsystem != nullptr)
-		{
-			SteamSubsystem->ExecuteNextTick([this]()
+				OnSuccess.Broadcast(OfficerList);
+			}
+			else
 			{
-				TArray<FBPSteamGroupOfficer> FailureArray;
-				OnFailure.Broadcast(FailureArray);
-			});
-		}
+				OnFailure.Broadcast(OfficerList);
+			}
+		});
 	}
-
-	// Should never hit this anyway
-	//OnFailure.Broadcast(OfficerArray);
-}
 #endif
-
+}
@@ -0,0 +1,122 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+#include "SteamUGCDetailsQuery.h"
+
+static TSharedPtr<ISteamUGCSource, ESPMode::ThreadSafe> UGCSource;
+
+FSteamUGCDetailsQuery::FSteamUGCDetailsQuery(const TArray<uint64>& InPublishedFileIds, const FOnSteamUGCDetailsQueryComplete& InOnComplete)
+	: PublishedFileIds(InPublishedFileIds)
+	, OnComplete(InOnComplete)
+	, PendingRequestId(0)
+	, NextIndex(0)
+	, PageCount(0)
+	, bAnyPageSucceeded(false)
+	, bRunning(false)
+{
+}
+
+FSteamUGCDetailsQuery::~FSteamUGCDetailsQuery()
+{
+	if (PendingRequestId != 0 && Source.IsValid())
+	{
+		Source->CancelRequest(PendingRequestId);
+	}
+}
+
+void FSteamUGCDetailsQuery::SetSource(const TSharedPtr<ISteamUGCSource, ESPMode::ThreadSafe>& NewSource)
+{
+	UGCSource = NewSource;
+}
+
+TSharedPtr<ISteamUGCSource, ESPMode::ThreadSafe> FSteamUGCDetailsQuery::GetSource()
+{
+	if (!UGCSource.IsValid())
+	{
+		UGCSource = ISteamUGCSource::CreateSteamworksSource();
+	}
+	return UGCSource;
+}
+
+bool FSteamUGCDetailsQuery::Start()
+{
+	if (bRunning)
+		return false;
+
+	Source = GetSource();
+	if (!Source.IsValid())
+		return false;
+
+	// Everything starts out failed and is filled in as pages come back
+	Details.Reset(PublishedFileIds.Num());
+	for (uint64 PublishedFileId : PublishedFileIds)
+	{
+		FBPSteamWorkshopItemDetails& Item = Details.AddDefaulted_GetRef();
+		Item.PublishedFileId = FBPSteamWorkshopID(PublishedFileId);
+		Item.ResultOfRequest = FBPSteamResult::k_EResultFail;
+	}
+
+	NextIndex = 0;
+	bAnyPageSucceeded = false;
+	bRunning = true;
+
+	SendNextPage();
+	return true;
+}
+
+void FSteamUGCDetailsQuery::SendNextPage()
+{
+	const int32 MaxPerPage = FMath::Max(Source->GetMaxItemsPerRequest(), 1);
+
+	while (NextIndex < PublishedFileIds.Num())
+	{
+		PageCount = FMath::Min<int32>(MaxPerPage, PublishedFileIds.Num() - NextIndex);
+
+		TArray<uint64> PageIds(&PublishedFileIds[NextIndex], PageCount);
+		PendingRequestId = Source->RequestDetailsPage(PageIds, FOnSteamUGCDetailsPageLoaded::CreateRaw(this, &FSteamUGCDetailsQuery::OnPageLoaded));
+
+		if (PendingRequestId != 0)
+			return;
+
+		// This page stays failed, carry on with the next
+		UE_LOG(AdvancedSteamWorkshopLog, Warning, TEXT("FSteamUGCDetailsQuery: Failed to send details request for %d items!"), PageCount);
+		NextIndex += PageCount;
+	}
+
+	Finish();
+}
+
+void FSteamUGCDetailsQuery::Finish()
+{
+	bRunning = false;
+	PageCount = 0;
+
+	// Copied out first, the callback is free to destroy the query
+	FOnSteamUGCDetailsQueryComplete Callback = OnComplete;
+	TArray<FBPSteamWorkshopItemDetails> Result = MoveTemp(Details);
+	Callback.ExecuteIfBound(bAnyPageSucceeded, Result);
+}
+
+void FSteamUGCDetailsQuery::OnPageLoaded(bool bWasSuccessful, const TArray<FBPSteamWorkshopItemDetails>& PageDetails)
+{
+	PendingRequestId = 0;
+
+	if (bWasSuccessful)
+	{
+		bAnyPageSucceeded = true;
+
+		for (const FBPSteamWorkshopItemDetails& Item : PageDetails)
+		{
+			// Results usually come back in request order, but don't rely on it
+			for (int32 Index = NextIndex; Index < NextIndex + PageCount; ++Index)
+			{
+				if (PublishedFileIds[Index] == Item.PublishedFileId.SteamWorkshopID)
+				{
+					Details[Index] = Item;
+					break;
+				}
+			}
+		}
+	}
+
+	NextIndex += PageCount;
+	SendNextPage();
+}
@@ -0,0 +1,144 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+#include "SteamUGCSource.h"
+#include "AdvancedSteamReadiness.h"
+
+#if PLATFORM_WINDOWS || PLATFORM_MAC || PLATFORM_LINUX
+
+class FSteamworksUGCSource : public ISteamUGCSource
+{
+public:
+
+	FSteamworksUGCSource()
+		: LastRequestId(0)
+	{
+	}
+
+	virtual ~FSteamworksUGCSource()
+	{
+		for (const TPair<uint32, TUniquePtr<FPendingRequest>>& Pair : Requests)
+		{
+			ReleaseQueryHandle(Pair.Value->QueryHandle);
+		}
+	}
+
+	virtual int32 GetMaxItemsPerRequest() const override
+	{
+		return kNumUGCResultsPerPage;
+	}
+
+	virtual uint32 RequestDetailsPage(const TArray<uint64>& PublishedFileIds, const FOnSteamUGCDetailsPageLoaded& OnLoaded) override
+	{
+		if (!AdvancedSteam::IsSteamReady() || PublishedFileIds.Num() == 0)
+			return 0;
+
+		TArray<uint64> Ids = PublishedFileIds;
+		UGCQueryHandle_t hQueryHandle = SteamUGC()->CreateQueryUGCDetailsRequest((PublishedFileId_t *)Ids.GetData(), (uint32)Ids.Num());
+		SteamAPICall_t hSteamAPICall = hQueryHandle != k_UGCQueryHandleInvalid ? SteamUGC()->SendQueryUGCRequest(hQueryHandle) : k_uAPICallInvalid;
+
+		if (hSteamAPICall == k_uAPICallInvalid)
+		{
+			if (hQueryHandle != k_UGCQueryHandleInvalid)
+			{
+				SteamUGC()->ReleaseQueryUGCRequest(hQueryHandle);
+			}
+			return 0;
+		}
+
+		// Never hand out 0, that means nothing was sent
+		if (++LastRequestId == 0)
+		{
+			++LastRequestId;
+		}
+
+		TUniquePtr<FPendingRequest>& Request = Requests.Add(LastRequestId, MakeUnique<FPendingRequest>());
+		Request->Owner = this;
+		Request->RequestId = LastRequestId;
+		Request->OnLoaded = OnLoaded;
+		Request->QueryHandle = hQueryHandle;
+		Request->CallResult.Set(hSteamAPICall, Request.Get(), &FPendingRequest::OnUGCRequestUGCDetails);
+		return LastRequestId;
+	}
+
+	virtual void CancelRequest(uint32 RequestId) override
+	{
+		// The call result unregisters itself when deleted, the query handle has to be given back by hand
+		TUniquePtr<FPendingRequest> Request;
+		if (Requests.RemoveAndCopyValue(RequestId, Request))
+		{
+			ReleaseQueryHandle(Request->QueryHandle);
+		}
+	}
+
+private:
+
+	static void ReleaseQueryHandle(UGCQueryHandle_t QueryHandle)
+	{
+		if (QueryHandle != k_UGCQueryHandleInvalid && AdvancedSteam::IsSteamReady())
+		{
+			SteamUGC()->ReleaseQueryUGCRequest(QueryHandle);
+		}
+	}
+
+	struct FPendingRequest
+	{
+		void OnUGCRequestUGCDetails(SteamUGCQueryCompleted_t *pResult, bool bIOFailure);
+
+		FSteamworksUGCSource* Owner;
+		uint32 RequestId;
+		UGCQueryHandle_t QueryHandle;
+		FOnSteamUGCDetailsPageLoaded OnLoaded;
+		CCallResult<FPendingRequest, SteamUGCQueryCompleted_t> CallResult;
+	};
+
+	TMap<uint32, TUniquePtr<FPendingRequest>> Requests;
+	uint32 LastRequestId;
+};
+
+void FSteamworksUGCSource::FPendingRequest::OnUGCRequestUGCDetails(SteamUGCQueryCompleted_t *pResult, bool bIOFailure)
+{
+	bool bWasSuccessful = false;
+	TArray<FBPSteamWorkshopItemDetails> Details;
+
+	if (!bIOFailure && pResult && AdvancedSteam::IsSteamReady())
+	{
+		if (pResult->m_eResult == k_EResultOK)
+		{
+			bWasSuccessful = true;
+
+			SteamUGCDetails_t hDetails;
+			for (uint32 i = 0; i < pResult->m_unNumResultsReturned; ++i)
+			{
+				if (SteamUGC()->GetQueryUGCResult(pResult->m_handle, i, &hDetails))
+				{
+					Details.Add(FBPSteamWorkshopItemDetails(hDetails));
+				}
+			}
+		}
+		else
+		{
+			UE_LOG(AdvancedSteamWorkshopLog, Warning, TEXT("FSteamworksUGCSource: Details request failed with result %d!"), (int32)pResult->m_eResult);
+		}
+	}
+
+	// Released on IO failures too, otherwise the handle is never given back
+	ReleaseQueryHandle(QueryHandle);
+
+	// Removing the request deletes this, copy the callback out first
+	FOnSteamUGCDetailsPageLoaded Callback = OnLoaded;
+	Owner->Requests.Remove(RequestId);
+	Callback.ExecuteIfBound(bWasSuccessful, Details);
+}
+
+#endif
+
+TSharedPtr<ISteamUGCSource, ESPMode::ThreadSafe> ISteamUGCSource::CreateSteamworksSource()
+{
+#if PLATFORM_WINDOWS || PLATFORM_MAC || PLATFORM_LINUX
+	if (AdvancedSteam::IsSteamReady())
+	{
+		return MakeShared<FSteamworksUGCSource, ESPMode::ThreadSafe>();
+	}
+#endif
+
+	return nullptr;
+}
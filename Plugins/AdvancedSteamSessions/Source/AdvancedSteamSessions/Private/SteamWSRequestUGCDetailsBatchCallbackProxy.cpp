@@ -0,0 +1,88 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#include "SteamWSRequestUGCDetailsBatchCallbackProxy.h"
+#include "OnlineSubSystemHeader.h"
+#include "SteamWorkshopDetailsCache.h"
+#include "Containers/Ticker.h"
+#if PLATFORM_WINDOWS || PLATFORM_MAC || PLATFORM_LINUX
+#include "OnlineSubsystemSteam.h"
+#endif
+
+//////////////////////////////////////////////////////////////////////////
+// USteamWSRequestUGCDetailsBatchCallbackProxy
+
+USteamWSRequestUGCDetailsBatchCallbackProxy::USteamWSRequestUGCDetailsBatchCallbackProxy(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+}
+
+USteamWSRequestUGCDetailsBatchCallbackProxy* USteamWSRequestUGCDetailsBatchCallbackProxy::GetWorkshopItemDetailsBatch(UObject* WorldContextObject, const TArray<FBPSteamWorkshopID>& WorkShopIDs)
+{
+	USteamWSRequestUGCDetailsBatchCallbackProxy* Proxy = NewObject<USteamWSRequestUGCDetailsBatchCallbackProxy>();
+
+	Proxy->WorkShopIDs = WorkShopIDs;
+	Proxy->WorldContextObject = WorldContextObject;
+	return Proxy;
+}
+
+void USteamWSRequestUGCDetailsBatchCallbackProxy::Activate()
+{
+	if (WorkShopIDs.Num() == 0)
+	{
+		OnSuccess.Broadcast(TArray<FBPSteamWorkshopItemDetails>());
+		return;
+	}
+
+	TArray<uint64> PublishedFileIds;
+	PublishedFileIds.Reserve(WorkShopIDs.Num());
+	for (const FBPSteamWorkshopID& WorkShopID : WorkShopIDs)
+	{
+		PublishedFileIds.Add(WorkShopID.SteamWorkshopID);
+	}
+
+	Query = MakeUnique<FSteamUGCDetailsQuery>(PublishedFileIds, FOnSteamUGCDetailsQueryComplete::CreateUObject(this, &USteamWSRequestUGCDetailsBatchCallbackProxy::OnQueryComplete));
+
+	if (!Query->Start())
+	{
+		Query.Reset();
+		OnFailure.Broadcast(TArray<FBPSteamWorkshopItemDetails>());
+	}
+}
+
+void USteamWSRequestUGCDetailsBatchCallbackProxy::OnQueryComplete(bool bWasSuccessful, const TArray<FBPSteamWorkshopItemDetails>& Details)
+{
+	// Kept for the next session, so the browser can draw before steam answers
+	FSteamWorkshopDetailsCache::Get().Store(Details);
+
+	// Runs inside the query's steam callback, broadcast once that has unwound
+	TFunction<void()> Broadcast = [bWasSuccessful, Details, this]()
+	{
+		Query.Reset();
+
+		if (bWasSuccessful)
+		{
+			OnSuccess.Broadcast(Details);
+		}
+		else
+		{
+			OnFailure.Broadcast(Details);
+		}
+	};
+
+#if PLATFORM_WINDOWS || PLATFORM_MAC || PLATFORM_LINUX
+	FOnlineSubsystemSteam* SteamSubsystem = (FOnlineSubsystemSteam*)(IOnlineSubsystem::Get(STEAM_SUBSYSTEM));
+
+	if (SteamSubsystem != nullptr)
+	{
+		SteamSubsystem->ExecuteNextTick(MoveTemp(Broadcast));
+		return;
+	}
+#endif
+
+	// No steam subsystem to wait on, the core ticker still runs after the callback returns
+	FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([Broadcast](float DeltaTime)
+	{
+		Broadcast();
+		return false;
+	}));
+}
@@ -2,6 +2,8 @@
 
 #include "SteamWSRequestUGCDetailsCallbackProxy.h"
 #include "OnlineSubSystemHeader.h"
+#include "AdvancedSteamReadiness.h"
+#include "SteamWorkshopDetailsCache.h"
 #if PLATFORM_WINDOWS || PLATFORM_MAC || PLATFORM_LINUX
 #include "steam/isteamugc.h"
 #endif
@@ -26,18 +28,16 @@ USteamWSRequestUGCDetailsCallbackProxy* USteamWSRequestUGCDetailsCallbackProxy::
 void USteamWSRequestUGCDetailsCallbackProxy::Activate()
 {
 #if PLATFORM_WINDOWS || PLATFORM_MAC || PLATFORM_LINUX
-	if (SteamAPI_Init())
+	if (AdvancedSteam::IsSteamReady())
 	{
-		// #TODO: Support arrays instead in the future?
+		// Use GetWorkshopItemDetailsBatch for more than one item
 		UGCQueryHandle_t hQueryHandle = SteamUGC()->CreateQueryUGCDetailsRequest((PublishedFileId_t *)&WorkShopID.SteamWorkshopID, 1);
 		// #TODO: add search settings here by calling into the handle?
 		SteamAPICall_t hSteamAPICall = SteamUGC()->SendQueryUGCRequest(hQueryHandle);
 
-		// Need to release the query
-		SteamUGC()->ReleaseQueryUGCRequest(hQueryHandle);
-
 		if (hSteamAPICall == k_uAPICallInvalid)
 		{
+			SteamUGC()->ReleaseQueryUGCRequest(hQueryHandle);
 			OnFailure.Broadcast(FBPSteamWorkshopItemDetails());
 			return;
 		}
@@ -56,6 +56,11 @@ void USteamWSRequestUGCDetailsCallbackProxy::OnUGCRequestUGCDetails(SteamUGCQuer
 
 	if (bIOFailure || !pResult || pResult->m_unNumResultsReturned <= 0)
 	{
+		if (!bIOFailure && pResult && AdvancedSteam::IsSteamReady())
+		{
+			SteamUGC()->ReleaseQueryUGCRequest(pResult->m_handle);
+		}
+
 		if (SteamSubsystem != nullptr)
 		{
 			SteamSubsystem->ExecuteNextTick([this]()
@@ -66,11 +71,18 @@ void USteamWSRequestUGCDetailsCallbackProxy::OnUGCRequestUGCDetails(SteamUGCQuer
 		//OnFailure.Broadcast(FBPSteamWorkshopItemDetails());
 		return;
 	}
-	if (SteamAPI_Init())
+	if (AdvancedSteam::IsSteamReady())
 	{
 		SteamUGCDetails_t Details;
-		if (SteamUGC()->GetQueryUGCResult(pResult->m_handle, 0, &Details))
+		bool bGotDetails = SteamUGC()->GetQueryUGCResult(pResult->m_handle, 0, &Details);
+
+		// Results have been read, the query can go
+		SteamUGC()->ReleaseQueryUGCRequest(pResult->m_handle);
+
+		if (bGotDetails)
 		{
+			FSteamWorkshopDetailsCache::Get().Store(FBPSteamWorkshopItemDetails(Details));
+
 			if (SteamSubsystem != nullptr)
 			{
 				SteamSubsystem->ExecuteNextTick([Details, this]()
@@ -0,0 +1,426 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+#include "SteamWorkshopDetailsCache.h"
+#include "AdvancedSteamReadiness.h"
+
+#include "Async/MappedFileHandle.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformFilemanager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryWriter.h"
+
+static TAutoConsoleVariable<int32> CVarWorkshopCacheMaxAge(
+	TEXT("AdvancedSteamSessions.WorkshopCache.MaxAge"),
+	86400,
+	TEXT("Seconds before cached workshop item details are considered stale and should be fetched again, negative never expires them."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarWorkshopCacheFlushDelay(
+	TEXT("AdvancedSteamSessions.WorkshopCache.FlushDelay"),
+	5.f,
+	TEXT("Seconds after new workshop item details are stored before the cache file is rewritten."),
+	ECVF_Default);
+
+// 'AWDC'
+static const uint32 WorkshopCacheMagic = 0x43445741;
+static const uint32 WorkshopCacheVersion = 1;
+
+static void SerializeDetails(FArchive& Ar, FBPSteamWorkshopItemDetails& Details)
+{
+	uint8 ResultOfRequest = (uint8)Details.ResultOfRequest;
+	uint8 FileType = (uint8)Details.FileType;
+
+	Ar << ResultOfRequest;
+	Ar << FileType;
+	Ar << Details.PublishedFileId.SteamWorkshopID;
+	Ar << Details.CreatorAppID;
+	Ar << Details.ConsumerAppID;
+	Ar << Details.Title;
+	Ar << Details.Description;
+	Ar << Details.ItemUrl;
+	Ar << Details.VotesUp;
+	Ar << Details.VotesDown;
+	Ar << Details.CalculatedScore;
+	Ar << Details.bBanned;
+	Ar << Details.bAcceptedForUse;
+	Ar << Details.bTagsTruncated;
+	Ar << Details.CreatorSteamID;
+	Ar << Details.TimeUpdated;
+
+	Details.ResultOfRequest = (FBPSteamResult)ResultOfRequest;
+	Details.FileType = (FBPWorkshopFileType)FileType;
+}
+
+/**
+ * Reads one entry's payload without trusting it. FBufferReader asserts when asked to read past its end, here a
+ * short or corrupt payload just sets the error flag, and no string may claim to be longer than the payload.
+ */
+class FWorkshopCacheEntryReader : public FArchive
+{
+public:
+
+	FWorkshopCacheEntryReader(const uint8* InData, int64 InSize)
+		: Data(InData)
+		, Size(InSize)
+		, Pos(0)
+	{
+		SetIsLoading(true);
+		SetIsPersistent(true);
+		ArMaxSerializeSize = InSize;
+	}
+
+	virtual void Serialize(void* V, int64 Length) override
+	{
+		if (IsError() || Length < 0 || Length > Size - Pos)
+		{
+			SetError();
+			return;
+		}
+
+		FMemory::Memcpy(V, Data + Pos, Length);
+		Pos += Length;
+	}
+
+	virtual int64 Tell() override { return Pos; }
+	virtual int64 TotalSize() override { return Size; }
+	virtual void Seek(int64 InPos) override
+	{
+		if (InPos < 0 || InPos > Size)
+		{
+			SetError();
+			return;
+		}
+		Pos = InPos;
+	}
+
+	virtual FString GetArchiveName() const override { return TEXT("FWorkshopCacheEntryReader"); }
+
+private:
+
+	const uint8* Data;
+	int64 Size;
+	int64 Pos;
+};
+
+static uint32 GetUnixNow()
+{
+	return (uint32)FDateTime::UtcNow().ToUnixTimestamp();
+}
+
+FSteamWorkshopDetailsCache* FSteamWorkshopDetailsCache::Instance = nullptr;
+
+FSteamWorkshopDetailsCache& FSteamWorkshopDetailsCache::Get()
+{
+	if (!Instance)
+	{
+		Instance = new FSteamWorkshopDetailsCache();
+	}
+	return *Instance;
+}
+
+void FSteamWorkshopDetailsCache::Shutdown()
+{
+	delete Instance;
+	Instance = nullptr;
+}
+
+FSteamWorkshopDetailsCache::FSteamWorkshopDetailsCache()
+	: FileData(nullptr)
+	, FileSize(0)
+	, Index(nullptr)
+	, NumEntries(0)
+	, MappedHandle(nullptr)
+	, MappedRegion(nullptr)
+{
+	OpenFile();
+}
+
+FSteamWorkshopDetailsCache::~FSteamWorkshopDetailsCache()
+{
+	if (FlushTickerHandle.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(FlushTickerHandle);
+	}
+
+	Flush();
+	CloseFile();
+}
+
+FString FSteamWorkshopDetailsCache::GetCacheFilename()
+{
+	return FPaths::ProjectSavedDir() / TEXT("AdvancedSteamSessions") / TEXT("WorkshopDetails.bin");
+}
+
+void FSteamWorkshopDetailsCache::OpenFile()
+{
+	static_assert(sizeof(FFileHeader) == 16 && sizeof(FIndexEntry) == 24, "Workshop details cache layout changed, bump WorkshopCacheVersion");
+
+	const FString Filename = GetCacheFilename();
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+	if (!PlatformFile.FileExists(*Filename))
+		return;
+
+	MappedHandle = PlatformFile.OpenMapped(*Filename);
+	if (MappedHandle)
+	{
+		MappedRegion = MappedHandle->MapRegion(0, MappedHandle->GetFileSize());
+	}
+
+	if (MappedRegion)
+	{
+		FileData = MappedRegion->GetMappedPtr();
+		FileSize = MappedRegion->GetMappedSize();
+	}
+	else
+	{
+		// Not every platform maps files, reading it in is still one read per session
+		delete MappedHandle;
+		MappedHandle = nullptr;
+
+		if (!FFileHelper::LoadFileToArray(FallbackData, *Filename))
+			return;
+
+		FileData = FallbackData.GetData();
+		FileSize = FallbackData.Num();
+	}
+
+	const FFileHeader* Header = (const FFileHeader*)FileData;
+
+	if (FileSize < (int64)sizeof(FFileHeader) || Header->Magic != WorkshopCacheMagic || Header->Version != WorkshopCacheVersion ||
+		(int64)sizeof(FFileHeader) + (int64)Header->NumEntries * (int64)sizeof(FIndexEntry) > FileSize)
+	{
+		UE_LOG(AdvancedSteamWorkshopLog, Warning, TEXT("Ignoring unreadable workshop details cache %s"), *Filename);
+		CloseFile();
+		return;
+	}
+
+	NumEntries = Header->NumEntries;
+	Index = (const FIndexEntry*)(FileData + sizeof(FFileHeader));
+
+	UE_LOG(AdvancedSteamWorkshopLog, Verbose, TEXT("Opened workshop details cache with %u items"), NumEntries);
+}
+
+void FSteamWorkshopDetailsCache::CloseFile()
+{
+	delete MappedRegion;
+	MappedRegion = nullptr;
+
+	delete MappedHandle;
+	MappedHandle = nullptr;
+
+	FallbackData.Empty();
+
+	FileData = nullptr;
+	FileSize = 0;
+	Index = nullptr;
+	NumEntries = 0;
+}
+
+const FSteamWorkshopDetailsCache::FIndexEntry* FSteamWorkshopDetailsCache::FindIndexEntry(uint64 PublishedFileId) const
+{
+	uint32 Low = 0;
+	uint32 High = NumEntries;
+
+	while (Low < High)
+	{
+		const uint32 Mid = Low + (High - Low) / 2;
+
+		if (Index[Mid].PublishedFileId < PublishedFileId)
+		{
+			Low = Mid + 1;
+		}
+		else
+		{
+			High = Mid;
+		}
+	}
+
+	return (Low < NumEntries && Index[Low].PublishedFileId == PublishedFileId) ? &Index[Low] : nullptr;
+}
+
+bool FSteamWorkshopDetailsCache::ReadEntry(const FIndexEntry& Entry, FBPSteamWorkshopItemDetails& OutDetails) const
+{
+	if ((int64)Entry.Offset + (int64)Entry.Size > FileSize)
+		return false;
+
+	// A corrupt entry counts as missing, it gets fetched and rewritten like any other
+	FBPSteamWorkshopItemDetails Details;
+	FWorkshopCacheEntryReader Reader(FileData + Entry.Offset, Entry.Size);
+	SerializeDetails(Reader, Details);
+
+	if (Reader.IsError() || Details.PublishedFileId.SteamWorkshopID != Entry.PublishedFileId)
+	{
+		UE_LOG(AdvancedSteamWorkshopLog, Warning, TEXT("Ignoring corrupt workshop details cache entry for %llu"), Entry.PublishedFileId);
+		return false;
+	}
+
+	OutDetails = Details;
+	return true;
+}
+
+bool FSteamWorkshopDetailsCache::IsStale(uint64 PublishedFileId, uint32 TimeUpdated, uint32 FetchedAt) const
+{
+	const int32 MaxAge = CVarWorkshopCacheMaxAge.GetValueOnGameThread();
+	const uint32 Now = GetUnixNow();
+
+	if (MaxAge >= 0 && (FetchedAt > Now || Now - FetchedAt > (uint32)MaxAge))
+		return true;
+
+#if PLATFORM_WINDOWS || PLATFORM_MAC || PLATFORM_LINUX
+	// Installed content newer than the details means the item changed since they were fetched, no request needed to tell
+	if (AdvancedSteam::IsSteamReady())
+	{
+		uint64 SizeOnDisk = 0;
+		uint32 TimeStamp = 0;
+		char Folder[1024];
+
+		if (SteamUGC()->GetItemInstallInfo(PublishedFileId, &SizeOnDisk, Folder, sizeof(Folder), &TimeStamp) && TimeStamp > TimeUpdated)
+			return true;
+	}
+#endif
+
+	return false;
+}
+
+bool FSteamWorkshopDetailsCache::Find(uint64 PublishedFileId, FBPSteamWorkshopItemDetails& OutDetails, bool& bOutStale)
+{
+	if (const FPendingEntry* PendingEntry = Pending.Find(PublishedFileId))
+	{
+		OutDetails = PendingEntry->Details;
+		bOutStale = IsStale(PublishedFileId, (uint32)PendingEntry->Details.TimeUpdated.ToUnixTimestamp(), PendingEntry->FetchedAt);
+		return true;
+	}
+
+	const FIndexEntry* Entry = FindIndexEntry(PublishedFileId);
+
+	if (!Entry || !ReadEntry(*Entry, OutDetails))
+		return false;
+
+	bOutStale = IsStale(PublishedFileId, Entry->TimeUpdated, Entry->FetchedAt);
+	return true;
+}
+
+void FSteamWorkshopDetailsCache::Store(const TArray<FBPSteamWorkshopItemDetails>& Details)
+{
+	for (const FBPSteamWorkshopItemDetails& Item : Details)
+	{
+		Store(Item);
+	}
+}
+
+void FSteamWorkshopDetailsCache::Store(const FBPSteamWorkshopItemDetails& Details)
+{
+	if (Details.ResultOfRequest != FBPSteamResult::k_EResultOK || Details.PublishedFileId.SteamWorkshopID == 0)
+		return;
+
+	FPendingEntry& Entry = Pending.FindOrAdd(Details.PublishedFileId.SteamWorkshopID);
+	Entry.Details = Details;
+	Entry.FetchedAt = GetUnixNow();
+
+	if (!FlushTickerHandle.IsValid())
+	{
+		FlushTickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FSteamWorkshopDetailsCache::FlushTick), FMath::Max(0.f, CVarWorkshopCacheFlushDelay.GetValueOnGameThread()));
+	}
+}
+
+bool FSteamWorkshopDetailsCache::FlushTick(float DeltaTime)
+{
+	FlushTickerHandle.Reset();
+	Flush();
+	return false;
+}
+
+void FSteamWorkshopDetailsCache::Flush()
+{
+	if (Pending.Num() == 0)
+		return;
+
+	struct FWriteEntry
+	{
+		FIndexEntry Entry;
+		const uint8* Payload;
+		TArray<uint8> Serialized;
+	};
+
+	TArray<FWriteEntry> Entries;
+	Entries.Reserve(NumEntries + Pending.Num());
+
+	// Untouched entries are copied straight from the old file
+	for (uint32 i = 0; i < NumEntries; ++i)
+	{
+		const FIndexEntry& Existing = Index[i];
+
+		if (Pending.Contains(Existing.PublishedFileId) || (int64)Existing.Offset + (int64)Existing.Size > FileSize)
+			continue;
+
+		FWriteEntry& Write = Entries.AddDefaulted_GetRef();
+		Write.Entry = Existing;
+		Write.Payload = FileData + Existing.Offset;
+	}
+
+	for (TPair<uint64, FPendingEntry>& Pair : Pending)
+	{
+		FWriteEntry& Write = Entries.AddDefaulted_GetRef();
+		FMemoryWriter Writer(Write.Serialized);
+		SerializeDetails(Writer, Pair.Value.Details);
+
+		Write.Entry.PublishedFileId = Pair.Key;
+		Write.Entry.TimeUpdated = (uint32)Pair.Value.Details.TimeUpdated.ToUnixTimestamp();
+		Write.Entry.FetchedAt = Pair.Value.FetchedAt;
+		Write.Entry.Size = Write.Serialized.Num();
+		Write.Payload = Write.Serialized.GetData();
+	}
+
+	Entries.Sort([](const FWriteEntry& A, const FWriteEntry& B)
+	{
+		return A.Entry.PublishedFileId < B.Entry.PublishedFileId;
+	});
+
+	uint32 Offset = sizeof(FFileHeader) + Entries.Num() * sizeof(FIndexEntry);
+	for (FWriteEntry& Write : Entries)
+	{
+		Write.Entry.Offset = Offset;
+		Offset += Write.Entry.Size;
+	}
+
+	TArray<uint8> Buffer;
+	Buffer.Reserve(Offset);
+
+	FFileHeader Header;
+	Header.Magic = WorkshopCacheMagic;
+	Header.Version = WorkshopCacheVersion;
+	Header.NumEntries = Entries.Num();
+	Header.Reserved = 0;
+	Buffer.Append((const uint8*)&Header, sizeof(Header));
+
+	for (const FWriteEntry& Write : Entries)
+	{
+		Buffer.Append((const uint8*)&Write.Entry, sizeof(FIndexEntry));
+	}
+
+	for (const FWriteEntry& Write : Entries)
+	{
+		Buffer.Append(Write.Payload, Write.Entry.Size);
+	}
+
+	// Payloads may point into the old file, so it is only let go of now
+	CloseFile();
+
+	const FString Filename = GetCacheFilename();
+	const FString TempFilename = Filename + TEXT(".tmp");
+
+	if (FFileHelper::SaveArrayToFile(Buffer, *TempFilename) && IFileManager::Get().Move(*Filename, *TempFilename, true, true))
+	{
+		Pending.Empty();
+		UE_LOG(AdvancedSteamWorkshopLog, Verbose, TEXT("Wrote workshop details cache with %d items"), Entries.Num());
+	}
+	else
+	{
+		// Keep the new details in memory and try again on the next flush
+		UE_LOG(AdvancedSteamWorkshopLog, Warning, TEXT("Failed to write workshop details cache %s"), *Filename);
+	}
+
+	OpenFile();
+}
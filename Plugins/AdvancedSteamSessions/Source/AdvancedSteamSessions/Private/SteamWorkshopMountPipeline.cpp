@@ -0,0 +1,284 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+#include "SteamWorkshopMountPipeline.h"
+#include "AdvancedSteamReadiness.h"
+
+#include "AssetRegistryModule.h"
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+
+static TAutoConsoleVariable<int32> CVarWorkshopMountPakOrder(
+	TEXT("AdvancedSteamSessions.WorkshopMount.PakOrder"),
+	0,
+	TEXT("Pak order the first workshop item is mounted with, each item after it in id order gets one more. Raise it above the game's paks to let items override game content."),
+	ECVF_Default);
+
+// Paks mounted by any run, so mounting again after subscribing to something new only picks up the new items.
+// Game thread only.
+static TSet<FString> MountedPaks;
+
+// Collects the content folders inside a pak as OnMountPak lists its files
+class FWorkshopPakContentVisitor : public IPlatformFile::FDirectoryVisitor
+{
+public:
+
+	FWorkshopPakContentVisitor(TSet<FString>& InContentFolders)
+		: ContentFolders(InContentFolders)
+	{
+	}
+
+	virtual bool Visit(const TCHAR* FilenameOrDirectory, bool bIsDirectory) override
+	{
+		const FString Path = FString(FilenameOrDirectory).Replace(TEXT("\\"), TEXT("/"));
+		const int32 ContentIndex = Path.Find(TEXT("/Content/"), ESearchCase::IgnoreCase);
+
+		if (ContentIndex != INDEX_NONE)
+		{
+			ContentFolders.Add(Path.Left(ContentIndex + 9));
+		}
+		return true;
+	}
+
+private:
+
+	TSet<FString>& ContentFolders;
+};
+
+FSteamWorkshopMountPipeline::FSteamWorkshopMountPipeline(const FOnSteamWorkshopMountProgress& InOnProgress, const FOnSteamWorkshopMountComplete& InOnComplete)
+	: OnProgress(InOnProgress)
+	, OnComplete(InOnComplete)
+	, Inbox(MakeShared<FInbox, ESPMode::ThreadSafe>())
+	, NumItemsDone(0)
+	, BasePakOrder(0)
+	, StartTime(0.0)
+{
+}
+
+FSteamWorkshopMountPipeline::~FSteamWorkshopMountPipeline()
+{
+	if (TickerHandle.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+	}
+}
+
+bool FSteamWorkshopMountPipeline::Start()
+{
+#if PLATFORM_WINDOWS || PLATFORM_MAC || PLATFORM_LINUX
+	if (IsRunning() || !AdvancedSteam::IsSteamReady())
+		return false;
+
+	if (!FCoreDelegates::OnMountPak.IsBound())
+	{
+		UE_LOG(AdvancedSteamWorkshopLog, Warning, TEXT("FSteamWorkshopMountPipeline: No pak file system to mount workshop content with!"));
+		return false;
+	}
+
+	StartTime = FPlatformTime::Seconds();
+	Report = FBPSteamWorkshopMountReport();
+	NumItemsDone = 0;
+	NewContentFolders.Reset();
+
+	uint32 NumItems = SteamUGC()->GetNumSubscribedItems();
+
+	TArray<PublishedFileId_t> FileIds;
+	FileIds.SetNumUninitialized(NumItems);
+
+	if (NumItems > 0)
+	{
+		NumItems = SteamUGC()->GetSubscribedItems(FileIds.GetData(), NumItems);
+	}
+
+	FileIds.SetNum(NumItems);
+	Report.NumSubscribed = NumItems;
+
+	ItemIds.Reset(FileIds.Num());
+	for (PublishedFileId_t FileId : FileIds)
+	{
+		ItemIds.Add(FileId);
+	}
+
+	// Steam lists subscriptions in no particular order, the id order keeps pak priority the same every run
+	ItemIds.Sort();
+
+	Scans.Reset();
+	Scans.SetNum(ItemIds.Num());
+
+	BasePakOrder = CVarWorkshopMountPakOrder.GetValueOnGameThread();
+	TSharedRef<FInbox, ESPMode::ThreadSafe> TaskInbox = Inbox;
+
+	for (int32 ItemIndex = 0; ItemIndex < ItemIds.Num(); ++ItemIndex)
+	{
+		const uint64 PublishedFileId = ItemIds[ItemIndex];
+		Async(EAsyncExecution::ThreadPool, [TaskInbox, ItemIndex, PublishedFileId]()
+		{
+			TaskInbox->Scans.Enqueue(ScanItem(ItemIndex, PublishedFileId));
+		});
+	}
+
+	// Always finishes from the ticker, even with nothing to mount
+	TickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FSteamWorkshopMountPipeline::Tick));
+	return true;
+#else
+	return false;
+#endif
+}
+
+FSteamWorkshopMountPipeline::FItemScan FSteamWorkshopMountPipeline::ScanItem(int32 ItemIndex, uint64 PublishedFileId)
+{
+	FItemScan Scan;
+	Scan.ItemIndex = ItemIndex;
+	Scan.bInstalled = false;
+
+#if PLATFORM_WINDOWS || PLATFORM_MAC || PLATFORM_LINUX
+	if (!AdvancedSteam::IsSteamReady())
+		return Scan;
+
+	const uint32 ItemState = SteamUGC()->GetItemState(PublishedFileId);
+
+	uint64 SizeOnDisk = 0;
+	uint32 TimeStamp = 0;
+	char Folder[1024];
+
+	// Half downloaded content isn't safe to mount
+	if (!(ItemState & k_EItemStateInstalled) || (ItemState & k_EItemStateDownloading) ||
+		!SteamUGC()->GetItemInstallInfo(PublishedFileId, &SizeOnDisk, Folder, sizeof(Folder), &TimeStamp))
+		return Scan;
+
+	Scan.bInstalled = true;
+	IFileManager::Get().FindFilesRecursive(Scan.PakFiles, UTF8_TO_TCHAR(Folder), TEXT("*.pak"), true, false);
+
+	// Same order every run when an item ships more than one pak
+	Scan.PakFiles.Sort();
+#endif
+
+	return Scan;
+}
+
+void FSteamWorkshopMountPipeline::MountItem(int32 ItemIndex, const FItemScan& Scan)
+{
+	const uint64 PublishedFileId = ItemIds[ItemIndex];
+
+	if (!Scan.bInstalled)
+	{
+		Report.NotInstalledItems.Add(FBPSteamWorkshopID(PublishedFileId));
+		return;
+	}
+
+	++Report.NumInstalled;
+
+	const int32 PakOrder = BasePakOrder + ItemIndex;
+	bool bAnyFailed = false;
+
+	for (const FString& PakFile : Scan.PakFiles)
+	{
+		if (MountedPaks.Contains(PakFile))
+			continue;
+
+		FWorkshopPakContentVisitor Visitor(NewContentFolders);
+
+		if (FCoreDelegates::OnMountPak.Execute(PakFile, PakOrder, &Visitor))
+		{
+			MountedPaks.Add(PakFile);
+			++Report.NumPaksMounted;
+		}
+		else
+		{
+			UE_LOG(AdvancedSteamWorkshopLog, Warning, TEXT("FSteamWorkshopMountPipeline: Failed to mount %s for workshop item %llu!"), *PakFile, PublishedFileId);
+			++Report.NumPaksFailed;
+			bAnyFailed = true;
+		}
+	}
+
+	if (bAnyFailed)
+	{
+		Report.FailedItems.Add(FBPSteamWorkshopID(PublishedFileId));
+	}
+}
+
+void FSteamWorkshopMountPipeline::RegisterContent()
+{
+	if (NewContentFolders.Num() == 0)
+		return;
+
+	const FString GameContentDir = FPaths::ConvertRelativePathToFull(FPaths::ProjectContentDir());
+	TArray<FString> PathsToScan;
+
+	for (const FString& ContentFolder : NewContentFolders)
+	{
+		FString RootPath;
+
+		// Items that ship over the game's own content already live under /Game/
+		if (FPaths::IsSamePath(FPaths::ConvertRelativePathToFull(ContentFolder), GameContentDir))
+		{
+			RootPath = TEXT("/Game/");
+		}
+		else
+		{
+			// .../ModName/Content/ mounts as /ModName/, the same as a plugin would
+			const FString PluginName = FPaths::GetCleanFilename(ContentFolder.LeftChop(9));
+			if (PluginName.IsEmpty())
+				continue;
+
+			RootPath = FString::Printf(TEXT("/%s/"), *PluginName);
+
+			// Already there from an earlier run, or a root the engine or a plugin owns
+			if (!FPackageName::MountPointExists(RootPath))
+			{
+				FPackageName::RegisterMountPoint(RootPath, ContentFolder);
+			}
+		}
+
+		PathsToScan.AddUnique(RootPath);
+	}
+
+	// One scan for everything mounted this run, the registry picks up the new packages
+	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
+	AssetRegistryModule.Get().ScanPathsSynchronous(PathsToScan, true);
+
+	NewContentFolders.Reset();
+}
+
+bool FSteamWorkshopMountPipeline::Tick(float DeltaTime)
+{
+	FItemScan Scan;
+	while (Inbox->Scans.Dequeue(Scan))
+	{
+		const int32 ItemIndex = Scan.ItemIndex;
+		Scans[ItemIndex].Emplace(MoveTemp(Scan));
+	}
+
+	// Mounts strictly in id order, an item waits for every item before it to finish scanning
+	const int32 NumItemsBefore = NumItemsDone;
+	while (NumItemsDone < Scans.Num() && Scans[NumItemsDone].IsSet())
+	{
+		MountItem(NumItemsDone, Scans[NumItemsDone].GetValue());
+		Scans[NumItemsDone].Reset();
+		++NumItemsDone;
+	}
+
+	if (NumItemsDone != NumItemsBefore)
+	{
+		OnProgress.ExecuteIfBound(NumItemsDone, Scans.Num());
+	}
+
+	if (NumItemsDone < Scans.Num())
+		return true;
+
+	RegisterContent();
+
+	Report.Seconds = (float)(FPlatformTime::Seconds() - StartTime);
+	TickerHandle.Reset();
+
+	UE_LOG(AdvancedSteamWorkshopLog, Log, TEXT("Mounted %d workshop paks from %d of %d subscribed items in %.3f seconds (%d paks failed)"),
+		Report.NumPaksMounted, Report.NumInstalled, Report.NumSubscribed, Report.Seconds, Report.NumPaksFailed);
+
+	// Copied out first, the callback is free to destroy the pipeline
+	FOnSteamWorkshopMountComplete Callback = OnComplete;
+	FBPSteamWorkshopMountReport FinalReport = Report;
+	Callback.ExecuteIfBound(FinalReport);
+	return false;
+}
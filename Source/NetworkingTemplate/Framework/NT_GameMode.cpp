@@ -3,3 +3,46 @@
 
 #include "NT_GameMode.h"
 
+#include "OnlineSubsystemUtils.h"
+
+void ANT_GameMode::InitGame(const FString& MapName, const FString& Options, FString& ErrorMessage)
+{
+	Super::InitGame(MapName, Options, ErrorMessage);
+
+	// InitGame runs before the level's actors are initialized, kicking creation off here overlaps it with the rest of the load
+	if (bPrewarmDedicatedSession && GetNetMode() == NM_DedicatedServer)
+	{
+		// Someone else already has the game session, or is creating it (a session is named as soon as its create starts)
+		IOnlineSessionPtr Sessions = Online::GetSessionInterface(GetWorld());
+		if (Sessions.IsValid() && Sessions->GetNamedSession(NAME_GameSession))
+		{
+			UE_LOG(LogNTSessionStartup, Log, TEXT("Game session already exists or is being created, skipping the prewarm"));
+			return;
+		}
+
+		SessionStartup = NewObject<UNT_SessionStartup>(this);
+		SessionStartup->OnFinished.AddUObject(this, &ANT_GameMode::HandleSessionStartupFinished);
+		SessionStartup->Prepare(SessionStartupSettings, MapName);
+		SessionStartup->Begin();
+	}
+}
+
+void ANT_GameMode::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (SessionStartup)
+	{
+		SessionStartup->Cancel();
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+FNT_SessionStartupTimings ANT_GameMode::GetSessionStartupTimings() const
+{
+	return SessionStartup ? SessionStartup->GetTimings() : FNT_SessionStartupTimings();
+}
+
+void ANT_GameMode::HandleSessionStartupFinished(bool bSuccess)
+{
+	OnDedicatedSessionReady(bSuccess);
+}
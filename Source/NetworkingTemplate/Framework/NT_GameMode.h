@@ -4,14 +4,41 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/GameMode.h"
+#include "Networking/NT_SessionStartup.h"
 #include "NT_GameMode.generated.h"
 
 /**
  * 
  */
-UCLASS()
+UCLASS(Config = Game)
 class NETWORKINGTEMPLATE_API ANT_GameMode : public AGameMode
 {
 	GENERATED_BODY()
-	
+
+public:
+
+	virtual void InitGame(const FString& MapName, const FString& Options, FString& ErrorMessage) override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	// Create and start the game session while the map is still loading when running as a dedicated server. Off by default,
+	// only turn it on if nothing else (such as the game instance's Host Session) creates the dedicated server's session
+	UPROPERTY(EditDefaultsOnly, Config, Category = "Session")
+	bool bPrewarmDedicatedSession = false;
+
+	UPROPERTY(EditDefaultsOnly, Config, Category = "Session")
+	FNT_SessionStartupSettings SessionStartupSettings;
+
+	UFUNCTION(BlueprintPure, Category = "Session")
+	FNT_SessionStartupTimings GetSessionStartupTimings() const;
+
+	// Called once the dedicated server session is started, or every create attempt failed
+	UFUNCTION(BlueprintImplementableEvent, Category = "Session")
+	void OnDedicatedSessionReady(bool bSuccess);
+
+private:
+
+	void HandleSessionStartupFinished(bool bSuccess);
+
+	UPROPERTY(Transient)
+	UNT_SessionStartup* SessionStartup;
 };
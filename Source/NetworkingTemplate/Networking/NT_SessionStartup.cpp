@@ -0,0 +1,225 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "NT_SessionStartup.h"
+
+#include "Engine/World.h"
+#include "OnlineSubsystem.h"
+#include "OnlineSubsystemUtils.h"
+#include "TimerManager.h"
+
+DEFINE_LOG_CATEGORY(LogNTSessionStartup);
+
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Session Prepare (ms)"), STAT_NTSessionPrepareMs, STATGROUP_NTSessionStartup);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Session Created (ms)"), STAT_NTSessionCreatedMs, STATGROUP_NTSessionStartup);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Session Started (ms)"), STAT_NTSessionStartedMs, STATGROUP_NTSessionStartup);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Session Create Attempts"), STAT_NTSessionCreateAttempts, STATGROUP_NTSessionStartup);
+
+void UNT_SessionStartup::Prepare(const FNT_SessionStartupSettings& InSettings, const FString& MapName)
+{
+	PrepareTime = FPlatformTime::Seconds();
+	StartupSettings = InSettings;
+
+	SessionSettings = FOnlineSessionSettings();
+	SessionSettings.NumPublicConnections = StartupSettings.MaxPlayers;
+	SessionSettings.NumPrivateConnections = 0;
+	SessionSettings.bShouldAdvertise = true;
+	SessionSettings.bIsDedicated = true;
+	SessionSettings.bUsesPresence = false;
+	SessionSettings.bAllowJoinViaPresence = false;
+	SessionSettings.bIsLANMatch = StartupSettings.bUseLAN;
+	SessionSettings.bAllowInvites = StartupSettings.bAllowInvites;
+	SessionSettings.bAllowJoinInProgress = StartupSettings.bAllowJoinInProgress;
+	SessionSettings.bAntiCheatProtected = StartupSettings.bAntiCheatProtected;
+	SessionSettings.Set(SETTING_MAPNAME, MapName, EOnlineDataAdvertisementType::ViaOnlineService);
+
+	for (const TPair<FName, FString>& Extra : StartupSettings.ExtraSettings)
+	{
+		SessionSettings.Set(Extra.Key, Extra.Value, EOnlineDataAdvertisementType::ViaOnlineService);
+	}
+
+	Timings = FNT_SessionStartupTimings();
+	Timings.PrepareMs = (float)((FPlatformTime::Seconds() - PrepareTime) * 1000.0);
+	SET_FLOAT_STAT(STAT_NTSessionPrepareMs, Timings.PrepareMs);
+
+	bPrepared = true;
+	bFinished = false;
+}
+
+void UNT_SessionStartup::Begin()
+{
+	if (!bPrepared)
+	{
+		UE_LOG(LogNTSessionStartup, Warning, TEXT("Begin called before Prepare, not creating a session"));
+		return;
+	}
+
+	TryCreate();
+}
+
+void UNT_SessionStartup::Cancel()
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(RetryTimerHandle);
+	}
+
+	ClearDelegates();
+}
+
+void UNT_SessionStartup::BeginDestroy()
+{
+	ClearDelegates();
+	Super::BeginDestroy();
+}
+
+void UNT_SessionStartup::TryCreate()
+{
+	Timings.Attempts++;
+	SET_DWORD_STAT(STAT_NTSessionCreateAttempts, Timings.Attempts);
+
+	IOnlineSessionPtr Sessions = Online::GetSessionInterface(GetWorld());
+	if (!Sessions.IsValid())
+	{
+		UE_LOG(LogNTSessionStartup, Warning, TEXT("No session interface yet"));
+		ScheduleRetry();
+		return;
+	}
+
+	CreateCompleteHandle = Sessions->AddOnCreateSessionCompleteDelegate_Handle(FOnCreateSessionCompleteDelegate::CreateUObject(this, &UNT_SessionStartup::OnCreateSessionComplete));
+
+	if (FNamedOnlineSession* Existing = Sessions->GetNamedSession(NAME_GameSession))
+	{
+		// A create is still pending, wait for it instead of starting a second one
+		if (Existing->SessionState == EOnlineSessionState::Creating)
+			return;
+
+		// Already there from an earlier attempt (or a start that failed), only needs starting
+		OnCreateSessionComplete(NAME_GameSession, true);
+		return;
+	}
+
+	// Dedicated servers have no local user to host with
+	if (!Sessions->CreateSession(0, NAME_GameSession, SessionSettings))
+	{
+		// Some subsystems fail synchronously and never fire the delegate
+		if (CreateCompleteHandle.IsValid())
+		{
+			Sessions->ClearOnCreateSessionCompleteDelegate_Handle(CreateCompleteHandle);
+			ScheduleRetry();
+		}
+	}
+}
+
+void UNT_SessionStartup::ScheduleRetry()
+{
+	UWorld* World = GetWorld();
+
+	if (!World || Timings.Attempts >= StartupSettings.MaxAttempts)
+	{
+		UE_LOG(LogNTSessionStartup, Error, TEXT("Failed to create the server session after %d attempts"), Timings.Attempts);
+		Finish(false);
+		return;
+	}
+
+	// Exponential backoff with a bit of jitter so a fleet restarting together doesn't retry in lockstep
+	const float Delay = FMath::Min(StartupSettings.RetryBaseDelay * FMath::Pow(2.f, (float)FMath::Max(0, Timings.Attempts - 1)), StartupSettings.RetryMaxDelay);
+	const float JitteredDelay = FMath::Max(0.01f, Delay * FMath::FRandRange(0.8f, 1.2f));
+
+	UE_LOG(LogNTSessionStartup, Warning, TEXT("Session create attempt %d failed, retrying in %.2fs"), Timings.Attempts, JitteredDelay);
+	World->GetTimerManager().SetTimer(RetryTimerHandle, FTimerDelegate::CreateUObject(this, &UNT_SessionStartup::TryCreate), JitteredDelay, false);
+}
+
+void UNT_SessionStartup::OnCreateSessionComplete(FName SessionName, bool bWasSuccessful)
+{
+	if (SessionName != NAME_GameSession)
+		return;
+
+	IOnlineSessionPtr Sessions = Online::GetSessionInterface(GetWorld());
+	if (Sessions.IsValid())
+	{
+		Sessions->ClearOnCreateSessionCompleteDelegate_Handle(CreateCompleteHandle);
+	}
+
+	if (!bWasSuccessful || !Sessions.IsValid())
+	{
+		ScheduleRetry();
+		return;
+	}
+
+	if (Timings.CreatedMs <= 0.f)
+	{
+		Timings.CreatedMs = GetElapsedMs();
+		SET_FLOAT_STAT(STAT_NTSessionCreatedMs, Timings.CreatedMs);
+	}
+
+	StartCompleteHandle = Sessions->AddOnStartSessionCompleteDelegate_Handle(FOnStartSessionCompleteDelegate::CreateUObject(this, &UNT_SessionStartup::OnStartSessionComplete));
+	if (!Sessions->StartSession(NAME_GameSession))
+	{
+		if (StartCompleteHandle.IsValid())
+		{
+			OnStartSessionComplete(NAME_GameSession, false);
+		}
+	}
+}
+
+void UNT_SessionStartup::OnStartSessionComplete(FName SessionName, bool bWasSuccessful)
+{
+	if (SessionName != NAME_GameSession)
+		return;
+
+	IOnlineSessionPtr Sessions = Online::GetSessionInterface(GetWorld());
+	if (Sessions.IsValid())
+	{
+		Sessions->ClearOnStartSessionCompleteDelegate_Handle(StartCompleteHandle);
+	}
+
+	if (!bWasSuccessful)
+	{
+		// The session exists, so the retry only has to start it again
+		ScheduleRetry();
+		return;
+	}
+
+	Timings.StartedMs = GetElapsedMs();
+	SET_FLOAT_STAT(STAT_NTSessionStartedMs, Timings.StartedMs);
+
+	UE_LOG(LogNTSessionStartup, Log, TEXT("Server session ready: prepare %.1fms, created %.1fms, started %.1fms, %d attempt(s)"),
+		Timings.PrepareMs, Timings.CreatedMs, Timings.StartedMs, Timings.Attempts);
+
+	Finish(true);
+}
+
+void UNT_SessionStartup::Finish(bool bSuccess)
+{
+	if (bFinished)
+		return;
+
+	bFinished = true;
+	Timings.bReady = bSuccess;
+	ClearDelegates();
+
+	OnFinished.Broadcast(bSuccess);
+}
+
+void UNT_SessionStartup::ClearDelegates()
+{
+	if (!CreateCompleteHandle.IsValid() && !StartCompleteHandle.IsValid())
+		return;
+
+	// Same instance the handles were added to, PIE runs one per world
+	IOnlineSessionPtr Sessions = Online::GetSessionInterface(GetWorld());
+	if (Sessions.IsValid())
+	{
+		Sessions->ClearOnCreateSessionCompleteDelegate_Handle(CreateCompleteHandle);
+		Sessions->ClearOnStartSessionCompleteDelegate_Handle(StartCompleteHandle);
+	}
+
+	CreateCompleteHandle.Reset();
+	StartCompleteHandle.Reset();
+}
+
+float UNT_SessionStartup::GetElapsedMs() const
+{
+	return (float)((FPlatformTime::Seconds() - PrepareTime) * 1000.0);
+}
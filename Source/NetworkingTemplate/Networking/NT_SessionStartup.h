@@ -0,0 +1,129 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/NoExportTypes.h"
+#include "Engine/EngineTypes.h"
+#include "OnlineSessionSettings.h"
+#include "NT_SessionStartup.generated.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogNTSessionStartup, Log, All);
+
+DECLARE_STATS_GROUP(TEXT("NT_SessionStartup"), STATGROUP_NTSessionStartup, STATCAT_Advanced);
+
+/**
+ * What the dedicated server advertises its session with, filled in from the game mode config.
+ */
+USTRUCT(BlueprintType)
+struct NETWORKINGTEMPLATE_API FNT_SessionStartupSettings
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Session")
+	int32 MaxPlayers = 16;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Session")
+	bool bUseLAN = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Session")
+	bool bAllowInvites = true;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Session")
+	bool bAllowJoinInProgress = true;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Session")
+	bool bAntiCheatProtected = false;
+
+	// Advertised as string settings alongside the map name
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Session")
+	TMap<FName, FString> ExtraSettings;
+
+	// Create attempts before giving up, the delay doubles after every failure
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Session|Retry")
+	int32 MaxAttempts = 5;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Session|Retry")
+	float RetryBaseDelay = 1.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Session|Retry")
+	float RetryMaxDelay = 30.f;
+};
+
+/**
+ * How long each stage of getting the server session up took, in milliseconds since the pipeline was prepared.
+ */
+USTRUCT(BlueprintType)
+struct NETWORKINGTEMPLATE_API FNT_SessionStartupTimings
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Session")
+	float PrepareMs = 0.f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Session")
+	float CreatedMs = 0.f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Session")
+	float StartedMs = 0.f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Session")
+	int32 Attempts = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Session")
+	bool bReady = false;
+};
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FNT_OnSessionStartupFinished, bool /*bSuccess*/);
+
+/**
+ * Gets the dedicated server's game session created and started as early as possible.
+ * Settings are built once up front, creation is kicked off from InitGame so it runs alongside the rest of the map load,
+ * and failed attempts are retried with exponential backoff.
+ */
+UCLASS()
+class NETWORKINGTEMPLATE_API UNT_SessionStartup : public UObject
+{
+	GENERATED_BODY()
+
+public:
+
+	// Builds the online session settings, cheap to call early
+	void Prepare(const FNT_SessionStartupSettings& InSettings, const FString& MapName);
+
+	// Starts creating the session, Prepare must have been called
+	void Begin();
+
+	// Stops any pending retry and unbinds from the session interface
+	void Cancel();
+
+	const FNT_SessionStartupTimings& GetTimings() const { return Timings; }
+
+	FNT_OnSessionStartupFinished OnFinished;
+
+	virtual void BeginDestroy() override;
+
+private:
+
+	void TryCreate();
+	void ScheduleRetry();
+	void Finish(bool bSuccess);
+	void ClearDelegates();
+
+	void OnCreateSessionComplete(FName SessionName, bool bWasSuccessful);
+	void OnStartSessionComplete(FName SessionName, bool bWasSuccessful);
+
+	float GetElapsedMs() const;
+
+	FNT_SessionStartupSettings StartupSettings;
+	FOnlineSessionSettings SessionSettings;
+	FNT_SessionStartupTimings Timings;
+
+	double PrepareTime = 0.0;
+	bool bPrepared = false;
+	bool bFinished = false;
+
+	FTimerHandle RetryTimerHandle;
+	FDelegateHandle CreateCompleteHandle;
+	FDelegateHandle StartCompleteHandle;
+};
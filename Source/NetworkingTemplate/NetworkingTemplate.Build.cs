@@ -10,7 +10,7 @@ public class NetworkingTemplate : ModuleRules
 
 		bEnableExceptions = true;
 	
-		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore" });
+		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore", "OnlineSubsystem", "OnlineSubsystemUtils" });
 
 
         if (Target.Platform == UnrealTargetPlatform.Win64)
@@ -2,4 +2,20 @@
 
 
 #include "UI_UserWidget_Base.h"
+#include "Engine/Texture2D.h"
 
+FSlateBrush UUI_UserWidget_Base::MakeAtlasBrush(UTexture2D* Atlas, FVector2D UVMin, FVector2D UVMax, FVector2D ImageSize)
+{
+	FSlateBrush Brush;
+
+	if (Atlas)
+	{
+		Brush.SetResourceObject(Atlas);
+		Brush.ImageSize = ImageSize;
+		Brush.DrawAs = ESlateBrushDrawType::Image;
+		Brush.Tiling = ESlateBrushTileType::NoTile;
+		Brush.SetUVRegion(FBox2D(UVMin, UVMax));
+	}
+
+	return Brush;
+}
@@ -4,8 +4,11 @@
 
 #include "CoreMinimal.h"
 #include "Blueprint/UserWidget.h"
+#include "Styling/SlateBrush.h"
 #include "UI_UserWidget_Base.generated.h"
 
+class UTexture2D;
+
 /**
  * 
  */
@@ -13,5 +16,11 @@ UCLASS()
 class NETWORKINGTEMPLATE_API UUI_UserWidget_Base : public UUserWidget
 {
 	GENERATED_BODY()
+
+public:
+
+	// Brush drawing only the UV region of a shared atlas (avatar atlas slots etc), images using the same atlas batch together
+	UFUNCTION(BlueprintPure, Category = "UserInterface|Atlas")
+	static FSlateBrush MakeAtlasBrush(UTexture2D* Atlas, FVector2D UVMin, FVector2D UVMax, FVector2D ImageSize);
 	
 };